@@ -65,10 +65,12 @@ bool MapBase::setTile(unsigned int x, unsigned int y, TrackTileBasePtr tile)
     return true;
 }
 
-TrackTileBasePtr MapBase::getTile(unsigned int x, unsigned int y) const
+const TrackTileBasePtr & MapBase::getTile(unsigned int x, unsigned int y) const
 {
+    static const TrackTileBasePtr nullTile;
+
     if (x >= m_cols || y >= m_rows)
-        return nullptr;
+        return nullTile;
 
     return m_map[y][x];
 }
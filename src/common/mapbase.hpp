@@ -55,7 +55,7 @@ public:
 
     /*! Get tile at given coordinates.
      *  Returns nullptr if no tile set or impossible coordinates. */
-    TrackTileBasePtr getTile(unsigned int x, unsigned int y) const;
+    const TrackTileBasePtr & getTile(unsigned int x, unsigned int y) const;
 
     //! Insert column after given index.
     virtual unsigned int insertColumn(unsigned int at, InsertDirection insertDirection);
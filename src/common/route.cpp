@@ -58,7 +58,7 @@ unsigned int Route::numNodes() const
     return static_cast<unsigned int>(m_route.size());
 }
 
-TargetNodeBasePtr Route::get(unsigned int index) const
+const TargetNodeBasePtr & Route::get(unsigned int index) const
 {
     assert (index < numNodes());
     return m_route[index];
@@ -53,7 +53,7 @@ public:
     unsigned int numNodes() const;
 
     //! Return Target for the given index.
-    TargetNodeBasePtr get(unsigned int index) const;
+    const TargetNodeBasePtr & get(unsigned int index) const;
 
     //! Get all nodes.
     void getAll(RouteVector & routeVector) const;
@@ -69,10 +69,11 @@ public:
 
     RouteVector::const_iterator cend() const;
 
-private:
-
+    //! Return true if the last target node is next to the first one.
     bool isClosed() const;
 
+private:
+
     std::vector<TargetNodeBasePtr> m_route;
 };
 
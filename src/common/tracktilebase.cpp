@@ -15,6 +15,8 @@
 
 #include "tracktilebase.hpp"
 
+#include <map>
+
 TrackTileBase::TrackTileBase(
     QPointF location,
     QPoint matrixLocation,
@@ -80,6 +82,52 @@ bool TrackTileBase::excludeFromMinimap() const
     return m_excludeFromMinimap;
 }
 
+TrackTileBase::TileType TrackTileBase::tileTypeEnumFromString(const QString & type, bool * ok)
+{
+    static const std::map<QString, TileType> mappings = {
+        {"bridge", TT_BRIDGE},
+        {"corner90", TT_CORNER_90},
+        {"corner45Left", TT_CORNER_45_LEFT},
+        {"corner45Right", TT_CORNER_45_RIGHT},
+        {"straight", TT_STRAIGHT},
+        {"straight45Male", TT_STRAIGHT_45_MALE},
+        {"straight45Female", TT_STRAIGHT_45_FEMALE},
+        {"grass", TT_GRASS},
+        {"sand", TT_SAND},
+        {"sandGrassStraight", TT_SAND_GRASS_STRAIGHT},
+        {"sandGrassCorner", TT_SAND_GRASS_CORNER},
+        {"sandGrassCorner2", TT_SAND_GRASS_CORNER_2},
+        {"finish", TT_FINISH},
+        {"clear", TT_NONE}
+    };
+
+    auto iter = mappings.find(type);
+    if (ok)
+    {
+        *ok = iter != mappings.end();
+    }
+
+    return iter != mappings.end() ? iter->second : TT_NONE;
+}
+
+bool TrackTileBase::isAsphalt(TileType type)
+{
+    switch (type)
+    {
+    case TT_BRIDGE:
+    case TT_CORNER_90:
+    case TT_CORNER_45_LEFT:
+    case TT_CORNER_45_RIGHT:
+    case TT_STRAIGHT:
+    case TT_STRAIGHT_45_MALE:
+    case TT_STRAIGHT_45_FEMALE:
+    case TT_FINISH:
+        return true;
+    default:
+        return false;
+    }
+}
+
 TrackTileBase::~TrackTileBase()
 {
 }
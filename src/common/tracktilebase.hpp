@@ -49,6 +49,25 @@ public:
         CH_BRAKE
     };
 
+    //! All possible types.
+    enum TileType
+    {
+        TT_NONE = 0,
+        TT_BRIDGE,
+        TT_CORNER_90,
+        TT_CORNER_45_LEFT,
+        TT_CORNER_45_RIGHT,
+        TT_STRAIGHT,
+        TT_STRAIGHT_45_MALE,
+        TT_STRAIGHT_45_FEMALE,
+        TT_GRASS,
+        TT_SAND,
+        TT_SAND_GRASS_STRAIGHT,
+        TT_SAND_GRASS_CORNER,
+        TT_SAND_GRASS_CORNER_2,
+        TT_FINISH
+    };
+
     /*! Constructor.
      *  \param location Location (coordinates) in the track scene.
      *  \param matrixLocation Location in the tile matrix.
@@ -91,6 +110,13 @@ public:
 
     bool excludeFromMinimap() const;
 
+    /*! Map a type string to the type enum.
+     *  \param ok Set to false if the type is unknown. Unknown types map to TT_NONE. */
+    static TileType tileTypeEnumFromString(const QString & type, bool * ok = nullptr);
+
+    //! \return true if tiles of the given type have asphalt.
+    static bool isAsphalt(TileType type);
+
 private:
 
     //! Type string.
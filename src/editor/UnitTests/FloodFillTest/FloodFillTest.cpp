@@ -0,0 +1,93 @@
+// This file is part of Dust Racing 2D.
+// Copyright (C) 2018 Jussi Lind <jussi.lind@iki.fi>
+//
+// Dust Racing 2D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// Dust Racing 2D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Dust Racing 2D. If not, see <http://www.gnu.org/licenses/>.
+
+#include <QTest>
+#include "FloodFillTest.hpp"
+#include "../../floodfill.hpp"
+#include "../../map.hpp"
+#include "../../tracktile.hpp"
+
+#include <QAction>
+
+namespace {
+
+const unsigned int MAP_COLS = 300;
+
+const unsigned int MAP_ROWS = 300;
+
+TrackTile & tileAt(Map & map, unsigned int x, unsigned int y)
+{
+    return *std::static_pointer_cast<TrackTile>(map.getTile(x, y));
+}
+
+//! The fill takes the new tile type from the action like the tile menu does.
+void fill(Map & map, unsigned int x, unsigned int y, const QString & newType)
+{
+    QAction action(newType, nullptr);
+    action.setData(newType);
+    FloodFill::floodFill(tileAt(map, x, y), &action, tileAt(map, x, y).tileType(), map);
+}
+
+} // namespace
+
+FloodFillTest::FloodFillTest()
+{
+}
+
+void FloodFillTest::testFillStopsAtOtherTiles()
+{
+    Map map(MAP_COLS, MAP_ROWS);
+
+    // A vertical wall with a gap at the bottom and a separate closed box
+    // on the right side of the wall
+    const unsigned int wallX = MAP_COLS / 2;
+    for (unsigned int j = 0; j + 1 < MAP_ROWS; j++)
+    {
+        tileAt(map, wallX, j).setTileType("straight");
+    }
+
+    for (unsigned int i = wallX + 10; i <= wallX + 20; i++)
+    {
+        tileAt(map, i, 10).setTileType("straight");
+        tileAt(map, i, 20).setTileType("straight");
+        tileAt(map, wallX + 10, i - wallX).setTileType("straight");
+        tileAt(map, wallX + 20, i - wallX).setTileType("straight");
+    }
+
+    fill(map, 0, 0, "grass");
+
+    QCOMPARE(tileAt(map, wallX - 1, 0).tileType(), QString("grass"));
+    QCOMPARE(tileAt(map, wallX, MAP_ROWS - 1).tileType(), QString("grass"));
+    QCOMPARE(tileAt(map, MAP_COLS - 1, 0).tileType(), QString("grass"));
+    QCOMPARE(tileAt(map, wallX, 0).tileType(), QString("straight"));
+    QCOMPARE(tileAt(map, wallX + 15, 15).tileType(), QString("clear"));
+}
+
+void FloodFillTest::benchmarkFillLargeMap()
+{
+    Map map(MAP_COLS, MAP_ROWS);
+
+    // Every round refills the whole map
+    bool grass = false;
+    QBENCHMARK {
+        grass = !grass;
+        fill(map, MAP_COLS / 2, MAP_ROWS / 2, grass ? "grass" : "sand");
+    }
+
+    QCOMPARE(tileAt(map, 0, 0).tileType(), QString(grass ? "grass" : "sand"));
+    QCOMPARE(tileAt(map, MAP_COLS - 1, MAP_ROWS - 1).tileType(), QString(grass ? "grass" : "sand"));
+}
+
+QTEST_MAIN(FloodFillTest)
@@ -0,0 +1,164 @@
+// This file is part of Dust Racing 2D.
+// Copyright (C) 2018 Jussi Lind <jussi.lind@iki.fi>
+//
+// Dust Racing 2D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// Dust Racing 2D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Dust Racing 2D. If not, see <http://www.gnu.org/licenses/>.
+
+#include <QTest>
+#include "TrackTileTest.hpp"
+#include "../../map.hpp"
+#include "../../tracktile.hpp"
+
+#include <QGraphicsScene>
+#include <QGraphicsView>
+#include <QPainter>
+#include <QPixmap>
+
+#include <memory>
+
+namespace {
+
+// Large enough that drawing or hit-testing all tiles would show up
+const unsigned int MAP_COLS = 300;
+
+const unsigned int MAP_ROWS = 300;
+
+//! A large map in a scene and a view set up like EditorView.
+class MapScene
+{
+public:
+
+    MapScene()
+        : m_map(MAP_COLS, MAP_ROWS)
+        , m_view(&m_scene)
+    {
+        // Every other tile is a track tile, the rest are cleared
+        QPixmap pixmap(TrackTile::TILE_W, TrackTile::TILE_H);
+        pixmap.fill(Qt::darkGray);
+        QPainter painter(&pixmap);
+        painter.fillRect(pixmap.rect().adjusted(32, 0, -32, 0), Qt::gray);
+        painter.end();
+
+        for (unsigned int j = 0; j < MAP_ROWS; j++)
+        {
+            for (unsigned int i = 0; i < MAP_COLS; i++)
+            {
+                auto tile = std::static_pointer_cast<TrackTile>(m_map.getTile(i, j));
+                if ((i + j) % 2)
+                {
+                    tile->setTileTypeAndPixmap("straight", pixmap);
+                }
+
+                m_scene.addItem(tile.get());
+            }
+        }
+
+        m_scene.setSceneRect(0, 0, MAP_COLS * TrackTile::TILE_W, MAP_ROWS * TrackTile::TILE_H);
+
+        m_view.setOptimizationFlag(QGraphicsView::DontAdjustForAntialiasing);
+        m_view.setViewportUpdateMode(QGraphicsView::SmartViewportUpdate);
+        m_view.resize(1280, 800);
+        m_view.show();
+    }
+
+    ~MapScene()
+    {
+        // The map owns the tiles
+        for (unsigned int j = 0; j < MAP_ROWS; j++)
+        {
+            for (unsigned int i = 0; i < MAP_COLS; i++)
+            {
+                m_scene.removeItem(std::static_pointer_cast<TrackTile>(m_map.getTile(i, j)).get());
+            }
+        }
+    }
+
+    QGraphicsView & view()
+    {
+        return m_view;
+    }
+
+    //! Paint the visible part of the scene like a screen update would.
+    void paint()
+    {
+        m_view.viewport()->repaint();
+    }
+
+private:
+
+    Map m_map;
+
+    QGraphicsScene m_scene;
+
+    QGraphicsView m_view;
+};
+
+} // namespace
+
+TrackTileTest::TrackTileTest()
+{
+}
+
+void TrackTileTest::benchmarkScroll_data()
+{
+    QTest::addColumn<qreal>("scale");
+
+    QTest::newRow("zoomed in") << 1.0;
+    QTest::newRow("default") << 0.5;
+    QTest::newRow("zoomed out") << 0.05;
+}
+
+void TrackTileTest::benchmarkScroll()
+{
+    QFETCH(qreal, scale);
+
+    MapScene mapScene;
+    mapScene.view().scale(scale, scale);
+    mapScene.paint();
+
+    // Pan diagonally across the map
+    const int steps = 50;
+    QBENCHMARK {
+        for (int step = 0; step <= steps; step++)
+        {
+            mapScene.view().centerOn(
+                MAP_COLS * TrackTile::TILE_W * step / steps, MAP_ROWS * TrackTile::TILE_H * step / steps);
+            mapScene.paint();
+        }
+    }
+}
+
+void TrackTileTest::benchmarkZoom()
+{
+    MapScene mapScene;
+    mapScene.view().centerOn(MAP_COLS * TrackTile::TILE_W / 2, MAP_ROWS * TrackTile::TILE_H / 2);
+    mapScene.paint();
+
+    // Zoom out from 1:1 to the whole map and back in, as with the zoom slider
+    const int steps = 25;
+    const qreal factor = 0.85;
+    QBENCHMARK {
+        for (int step = 0; step < steps; step++)
+        {
+            mapScene.view().scale(factor, factor);
+            mapScene.paint();
+        }
+
+        for (int step = 0; step < steps; step++)
+        {
+            mapScene.view().scale(1 / factor, 1 / factor);
+            mapScene.paint();
+        }
+    }
+}
+
+QTEST_MAIN(TrackTileTest)
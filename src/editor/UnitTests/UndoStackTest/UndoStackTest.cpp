@@ -0,0 +1,190 @@
+// This file is part of Dust Racing 2D.
+// Copyright (C) 2018 Jussi Lind <jussi.lind@iki.fi>
+//
+// Dust Racing 2D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// Dust Racing 2D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Dust Racing 2D. If not, see <http://www.gnu.org/licenses/>.
+
+#include <QTest>
+#include "UndoStackTest.hpp"
+#include "../../trackdata.hpp"
+#include "../../trackstate.hpp"
+#include "../../tracktile.hpp"
+#include "../../undostack.hpp"
+
+#include <QDebug>
+#include <QElapsedTimer>
+
+#include <algorithm>
+#include <memory>
+
+namespace {
+
+const unsigned int MAP_COLS = 200;
+
+const unsigned int MAP_ROWS = 200;
+
+// Every tenth edit inserts a row, the others paint a block of tiles
+const unsigned int EDIT_COUNT = 30;
+
+const unsigned int BLOCK_SIZE = 10;
+
+bool isRowInsertion(unsigned int step)
+{
+    return step % 10 == 9;
+}
+
+//! Do one edit like the user would with the editor tools.
+void edit(TrackData & trackData, unsigned int step)
+{
+    if (isRowInsertion(step))
+    {
+        trackData.insertRow(step, MapBase::InsertDirection::After);
+        return;
+    }
+
+    const unsigned int x0 = (step * BLOCK_SIZE) % (MAP_COLS - BLOCK_SIZE);
+    const unsigned int y0 = (step * BLOCK_SIZE / 2) % (MAP_ROWS - BLOCK_SIZE);
+    for (unsigned int j = y0; j < y0 + BLOCK_SIZE; j++)
+    {
+        for (unsigned int i = x0; i < x0 + BLOCK_SIZE; i++)
+        {
+            auto tile = std::static_pointer_cast<TrackTile>(trackData.map().getTile(i, j));
+            tile->setTileType(step % 2 ? "straight" : "corner90");
+            tile->setRotation(90 * (step % 4));
+        }
+    }
+}
+
+//! Same as EditorData::applyTileChanges() without the scene and the pixmaps.
+void applyUndoRecord(TrackData & trackData, const UndoRecord & record, bool revert)
+{
+    if (record.layoutChanged())
+    {
+        const auto & newLayout = revert ? record.layoutBefore() : record.layoutAfter();
+        trackData.setTiles(newLayout.cols, newLayout.rows, newLayout.tiles);
+    }
+
+    for (auto && change : record.tileChanges())
+    {
+        auto tile = std::static_pointer_cast<TrackTile>(change.item);
+        const auto & state = revert ? change.before : change.after;
+        tile->setTileType(state.type);
+        tile->setRotation(state.rotation);
+        tile->setComputerHint(state.computerHint);
+        tile->setExcludeFromMinimap(state.excludeFromMinimap);
+    }
+}
+
+//! \return the size of a full copy of the tile states, i.e. what a snapshot based history would store per step.
+size_t snapshotSize(const TrackState & state)
+{
+    return state.tiles().size() * (sizeof(TrackTileBasePtr) + sizeof(TrackState::TileState));
+}
+
+bool isSameTrack(const TrackState & a, const TrackState & b)
+{
+    return a.hasSameLayout(b) && a.tileStates() == b.tileStates();
+}
+
+} // namespace
+
+UndoStackTest::UndoStackTest()
+{
+}
+
+void UndoStackTest::testUndoAndRedoRestoreEditedTrack()
+{
+    TrackDataPtr trackData(new TrackData("test", false, MAP_COLS, MAP_ROWS));
+    const TrackState initialState(*trackData);
+
+    UndoStack undoStack(EDIT_COUNT);
+    undoStack.reset(trackData);
+
+    qDebug() << "Full snapshot:" << snapshotSize(initialState) << "bytes";
+
+    size_t prevUsage = undoStack.memoryUsage();
+    for (unsigned int step = 0; step < EDIT_COUNT; step++)
+    {
+        undoStack.pushUndoPoint(trackData);
+        edit(*trackData, step);
+
+        // The changes of an edit are recorded at the next undo point
+        undoStack.pushUndoPoint(trackData);
+
+        const size_t usage = undoStack.memoryUsage();
+        qDebug() << "Step" << step << (isRowInsertion(step) ? "(insert row):" : "(paint tiles):")
+                 << usage - prevUsage << "bytes," << usage << "bytes total";
+        QVERIFY(usage > prevUsage);
+        if (!isRowInsertion(step))
+        {
+            // Only the painted tiles are stored
+            QVERIFY(usage - prevUsage < snapshotSize(initialState) / 10);
+        }
+
+        prevUsage = usage;
+    }
+
+    const TrackState editedState(*trackData);
+    QCOMPARE(editedState.rows(), MAP_ROWS + EDIT_COUNT / 10);
+
+    QElapsedTimer timer;
+    qint64 maxUndoTime = 0;
+    qint64 totalUndoTime = 0;
+    for (unsigned int step = 0; step < EDIT_COUNT; step++)
+    {
+        timer.start();
+        auto record = undoStack.undo(trackData);
+        QVERIFY(record);
+        applyUndoRecord(*trackData, *record, true);
+        undoStack.setBaseState(trackData);
+        const qint64 undoTime = timer.nsecsElapsed();
+        maxUndoTime = std::max(maxUndoTime, undoTime);
+        totalUndoTime += undoTime;
+    }
+
+    qDebug() << "Undo time:" << totalUndoTime / EDIT_COUNT / 1000 << "us average," << maxUndoTime / 1000 << "us max";
+    QVERIFY(!undoStack.isUndoable());
+    QVERIFY(isSameTrack(TrackState(*trackData), initialState));
+
+    while (undoStack.isRedoable())
+    {
+        auto record = undoStack.redo(trackData);
+        applyUndoRecord(*trackData, *record, false);
+        undoStack.setBaseState(trackData);
+    }
+
+    QVERIFY(isSameTrack(TrackState(*trackData), editedState));
+}
+
+void UndoStackTest::benchmarkUndoRedo()
+{
+    TrackDataPtr trackData(new TrackData("test", false, MAP_COLS, MAP_ROWS));
+
+    UndoStack undoStack;
+    undoStack.reset(trackData);
+    undoStack.pushUndoPoint(trackData);
+    edit(*trackData, 0);
+    undoStack.pushUndoPoint(trackData);
+
+    // Undo and redo of a single paint edit, including capturing the new base state
+    QBENCHMARK {
+        auto record = undoStack.undo(trackData);
+        applyUndoRecord(*trackData, *record, true);
+        undoStack.setBaseState(trackData);
+
+        record = undoStack.redo(trackData);
+        applyUndoRecord(*trackData, *record, false);
+        undoStack.setBaseState(trackData);
+    }
+}
+
+QTEST_MAIN(UndoStackTest)
@@ -43,13 +43,16 @@ HEADERS +=  \
     objectmodel.hpp \
     objectmodelloader.hpp \
     rotatedialog.hpp \
+    routevalidator.hpp \
     targetnode.hpp \
     targetnodesizedlg.hpp \
     tileanimator.hpp \
     trackdata.hpp \
+    trackstate.hpp \
     trackio.hpp \
     trackpropertiesdialog.hpp \
     tracktile.hpp \
+    undorecord.hpp \
     undostack.hpp \
 
 SOURCES += \
@@ -75,13 +78,16 @@ SOURCES += \
     objectfactory.cpp \
     objectmodelloader.cpp \
     rotatedialog.cpp \
+    routevalidator.cpp \
     targetnode.cpp \
     targetnodesizedlg.cpp \
     tileanimator.cpp \
     trackdata.cpp \
+    trackstate.cpp \
     trackio.cpp \
     trackpropertiesdialog.cpp \
     tracktile.cpp \
+    undorecord.cpp \
     undostack.cpp \
 
 RESOURCES += ../../data/icons/icons.qrc ../../data/images/editor.qrc
@@ -25,6 +25,7 @@
 
 #include <cassert>
 #include <memory>
+#include <unordered_set>
 
 using std::dynamic_pointer_cast;
 
@@ -51,7 +52,13 @@ bool EditorData::loadTrackData(QString fileName)
     clearScene();
 
     m_trackData = m_trackIO.open(fileName);
-    return static_cast<bool>(m_trackData);
+    if (m_trackData)
+    {
+        m_undoStack.reset(m_trackData);
+        return true;
+    }
+
+    return false;
 }
 
 bool EditorData::isUndoable() const
@@ -69,11 +76,14 @@ void EditorData::undo()
 
         m_selectedTargetNode = nullptr;
 
-        saveRedoPoint();
+        if (auto record = m_undoStack.undo(m_trackData))
+        {
+            applyUndoRecord(*record, true);
 
-        clearScene();
+            m_autosaveNeeded = true;
 
-        m_trackData = m_undoStack.undo();
+            m_undoStack.setBaseState(m_trackData);
+        }
     }
 }
 
@@ -92,18 +102,160 @@ void EditorData::redo()
 
         m_selectedTargetNode = nullptr;
 
-        saveUndoPoint();
+        if (auto record = m_undoStack.redo(m_trackData))
+        {
+            applyUndoRecord(*record, false);
 
-        clearScene();
+            m_autosaveNeeded = true;
 
-        m_trackData = m_undoStack.redo();
+            m_undoStack.setBaseState(m_trackData);
+        }
     }
 }
 
-bool EditorData::saveTrackData()
+void EditorData::applyUndoRecord(const UndoRecord & record, bool revert)
+{
+    applyTileChanges(record, revert);
+
+    applyObjectChanges(record, revert);
+
+    applyTargetNodeChanges(record, revert);
+
+    m_mediator.updateView();
+}
+
+void EditorData::applyTileChanges(const UndoRecord & record, bool revert)
+{
+    if (record.layoutChanged())
+    {
+        const auto & oldLayout = revert ? record.layoutAfter() : record.layoutBefore();
+        const auto & newLayout = revert ? record.layoutBefore() : record.layoutAfter();
+
+        // Remove only the tiles that are not part of the restored matrix.
+        const std::unordered_set<TrackTileBasePtr> newTiles(newLayout.tiles.begin(), newLayout.tiles.end());
+        for (auto && tile : oldLayout.tiles)
+        {
+            if (!newTiles.count(tile))
+            {
+                removeTileFromScene(tile);
+            }
+        }
+
+        m_trackData->setTiles(newLayout.cols, newLayout.rows, newLayout.tiles);
+    }
+
+    for (auto && change : record.tileChanges())
+    {
+        auto tile = dynamic_pointer_cast<TrackTile>(change.item);
+        assert(tile);
+
+        const auto & state = revert ? change.before : change.after;
+        tile->setTileType(state.type);
+        tile->setRotation(state.rotation);
+        tile->setComputerHint(state.computerHint);
+        tile->setExcludeFromMinimap(state.excludeFromMinimap);
+        tile->setPixmap(MainWindow::instance()->objectModelLoader().getPixmapByRole(state.type));
+    }
+
+    if (record.layoutChanged())
+    {
+        addTilesToScene();
+    }
+}
+
+void EditorData::applyObjectChanges(const UndoRecord & record, bool revert)
+{
+    if (record.objectsChanged())
+    {
+        const auto & oldObjects = revert ? record.objectsAfter() : record.objectsBefore();
+        const auto & newObjects = revert ? record.objectsBefore() : record.objectsAfter();
+
+        const std::unordered_set<ObjectBasePtr> newObjectSet(newObjects.begin(), newObjects.end());
+        for (auto && objectBase : oldObjects)
+        {
+            if (!newObjectSet.count(objectBase))
+            {
+                auto object = dynamic_pointer_cast<Object>(objectBase);
+                assert(object);
+
+                m_mediator.removeItem(object.get()); // The scene wants a raw pointer
+            }
+        }
+
+        m_trackData->objects().clear();
+        for (auto && objectBase : newObjects)
+        {
+            m_trackData->objects().add(objectBase);
+
+            auto object = dynamic_pointer_cast<Object>(objectBase);
+            assert(object);
+
+            if (!object->scene())
+            {
+                m_mediator.addItem(object.get()); // The scene wants a raw pointer
+
+                object->setZValue(10);
+            }
+        }
+    }
+
+    for (auto && change : record.objectChanges())
+    {
+        auto object = dynamic_pointer_cast<Object>(change.item);
+        assert(object);
+
+        const auto & state = revert ? change.before : change.after;
+        object->setLocation(state.location);
+        object->setRotation(state.rotation);
+        object->setForceStationary(state.forceStationary);
+    }
+}
+
+void EditorData::applyTargetNodeChanges(const UndoRecord & record, bool revert)
+{
+    if (record.routeChanged())
+    {
+        removeRouteFromScene();
+        m_trackData->route().clear();
+
+        // Break the links so that relocating nodes won't touch route lines
+        // of removed nodes. Links are re-created when the nodes are pushed.
+        for (auto && tnode : record.routeBefore())
+        {
+            tnode->setPrev(nullptr);
+            tnode->setNext(nullptr);
+        }
+
+        for (auto && tnode : record.routeAfter())
+        {
+            tnode->setPrev(nullptr);
+            tnode->setNext(nullptr);
+        }
+    }
+
+    for (auto && change : record.targetNodeChanges())
+    {
+        const auto & state = revert ? change.before : change.after;
+        change.item->setLocation(state.location);
+        change.item->setSize(state.size);
+    }
+
+    if (record.routeChanged())
+    {
+        for (auto && tnode : revert ? record.routeBefore() : record.routeAfter())
+        {
+            pushTargetNodeToRoute(tnode);
+        }
+    }
+}
+
+void EditorData::saveTrackData()
 {
     assert(m_trackData);
-    return m_trackIO.save(m_trackData, m_trackData->fileName());
+    m_trackIO.saveAsync(m_trackData, m_trackData->fileName());
+
+    // The snapshot of the save contains all edits so far
+    m_autosaveNeeded = false;
 }
 
 void EditorData::saveUndoPoint()
@@ -111,24 +263,43 @@ void EditorData::saveUndoPoint()
     assert(m_trackData);
     m_undoStack.pushUndoPoint(m_trackData);
 
+    m_autosaveNeeded = true;
+
     m_mediator.enableUndo(m_undoStack.isUndoable());
 }
 
-void EditorData::saveRedoPoint()
+void EditorData::saveTrackDataAs(QString fileName)
 {
     assert(m_trackData);
-    m_undoStack.pushRedoPoint(m_trackData);
+    m_trackIO.saveAsync(m_trackData, fileName);
+
+    m_autosaveNeeded = false;
 }
 
-bool EditorData::saveTrackDataAs(QString fileName)
+void EditorData::autosave()
 {
-    assert(m_trackData);
-    if (m_trackIO.save(m_trackData, fileName))
+    if (m_autosaveNeeded && m_trackData && !m_trackData->fileName().isEmpty())
     {
-        m_trackData->setFileName(fileName);
-        return true;
+        m_trackIO.saveAsync(m_trackData, TrackIO::autosavePath(m_trackData->fileName()));
+        m_autosaveNeeded = false;
+    }
+}
+
+void EditorData::handleSaveFinished(QString path, bool success)
+{
+    if (!success)
+    {
+        m_autosaveNeeded = true;
+    }
+    else if (m_trackData && !path.endsWith(TrackIO::autosavePath(QString())))
+    {
+        m_trackData->setFileName(path);
     }
-    return false;
+}
+
+TrackIO & EditorData::trackIO()
+{
+    return m_trackIO;
 }
 
 void EditorData::setTrackData(TrackDataPtr trackData)
@@ -136,6 +307,8 @@ void EditorData::setTrackData(TrackDataPtr trackData)
     clearScene();
 
     m_trackData = trackData;
+
+    m_undoStack.reset(m_trackData);
 }
 
 bool EditorData::canRouteBeSet() const
@@ -258,6 +431,9 @@ void EditorData::addTilesToScene()
 {
     assert(m_trackData);
 
+    // Every tile is a scene item of its own also when zoomed out. Zoomed-out views
+    // are kept cheap by the shared downscaled pixmaps in TrackTile::paint().
+
     for (unsigned int i = 0; i < m_trackData->map().cols(); i++)
     {
         for (unsigned int j = 0; j < m_trackData->map().rows(); j++)
@@ -303,6 +479,8 @@ void EditorData::removeTileFromScene(TrackTileBasePtr trackTile)
     assert(tile);
 
     m_mediator.removeItem(tile.get()); // The scene wants a raw pointer
+
+    tile->setAdded(false);
 }
 
 void EditorData::removeTilesFromScene()
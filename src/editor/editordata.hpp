@@ -52,25 +52,32 @@ public:
 
     bool isUndoable() const;
 
-    //! Load track from undo point.
+    //! Revert the latest change.
     void undo();
 
     bool isRedoable() const;
 
-    //! Load track from redo point.
+    //! Re-apply the latest reverted change.
     void redo();
 
-    //! Save track data.
-    bool saveTrackData();
+    //! Save track data in the background. TrackIO::saveFinished() tells the result.
+    void saveTrackData();
 
-    //! Sava track data to the given file.
-    bool saveTrackDataAs(QString fileName);
+    /*! Save track data to the given file in the background. The file name of
+     *  the track is changed only when the save succeeds, see handleSaveFinished(). */
+    void saveTrackDataAs(QString fileName);
 
-    //! Save undo point.
-    void saveUndoPoint();
+    //! Save track data to the autosave file, if changed since the last autosave.
+    void autosave();
+
+    /*! Update the state after a background save. A successful save changes the
+     *  file name of the track and a failed one re-schedules the autosave. */
+    void handleSaveFinished(QString path, bool success);
 
-    //! Save redo point.
-    void saveRedoPoint();
+    TrackIO & trackIO();
+
+    //! Save undo point. This should be called right before an edit.
+    void saveUndoPoint();
 
     //! Set track data as the given data.
     void setTrackData(TrackDataPtr newTrackData);
@@ -135,6 +142,14 @@ private:
     EditorData(const EditorData & e);
     EditorData & operator= (const EditorData & e);
 
+    void applyUndoRecord(const UndoRecord & record, bool revert);
+
+    void applyTileChanges(const UndoRecord & record, bool revert);
+
+    void applyObjectChanges(const UndoRecord & record, bool revert);
+
+    void applyTargetNodeChanges(const UndoRecord & record, bool revert);
+
     void clearScene();
 
     void pushTargetNodeToRoute(TargetNodeBasePtr tnode);
@@ -153,6 +168,8 @@ private:
 
     UndoStack m_undoStack;
 
+    bool m_autosaveNeeded = false;
+
     Object * m_selectedObject = nullptr;
 
     TargetNode * m_selectedTargetNode = nullptr;
@@ -40,6 +40,11 @@
 EditorView::EditorView(Mediator & mediator)
     : m_mediator(mediator)
 {
+    // Tiles and objects are not antialiased, and most updates touch only a
+    // few tiles, so let the view choose the cheapest update strategy.
+    setOptimizationFlag(QGraphicsView::DontAdjustForAntialiasing);
+    setViewportUpdateMode(QGraphicsView::SmartViewportUpdate);
+
     createTileContextMenuActions();
     createObjectContextMenuActions();
     createTargetNodeContextMenuActions();
@@ -64,7 +69,7 @@ void EditorView::mouseMoveEvent(QMouseEvent * event)
     if (scene())
     {
         const QPointF mappedPos = mapToScene(event->pos());
-        if (auto tile = dynamic_cast<TrackTile *>(scene()->itemAt(mappedPos, QTransform())))
+        if (auto tile = m_mediator.tileAt(mappedPos))
         {
             tile->setActive(true);
         }
@@ -96,8 +101,7 @@ void EditorView::createTileContextMenuActions()
 
     auto rotate90CW = new QAction(dummy1, &m_tileContextMenu);
     QObject::connect(rotate90CW, &QAction::triggered, [this] () {
-        if (TrackTile * tile =
-            dynamic_cast<TrackTile *>(scene()->itemAt(mapToScene(m_clickedPos), QTransform())))
+        if (auto tile = m_mediator.tileAt(m_clickedScenePos))
         {
             m_mediator.saveUndoPoint();
             tile->rotate90CW();
@@ -108,8 +112,7 @@ void EditorView::createTileContextMenuActions()
 
     auto rotate90CCW = new QAction(dummy2, &m_tileContextMenu);
     QObject::connect(rotate90CCW, &QAction::triggered, [this] () {
-        if (auto tile =
-            dynamic_cast<TrackTile *>(scene()->itemAt(mapToScene(m_clickedPos), QTransform())))
+        if (auto tile = m_mediator.tileAt(m_clickedScenePos))
         {
             m_mediator.saveUndoPoint();
             tile->rotate90CCW();
@@ -140,7 +143,7 @@ void EditorView::createTileContextMenuActions()
         QWidget::tr("Exclude from minimap"), &m_tileContextMenu);
     m_excludeFromMinimap->setCheckable(true);
     QObject::connect(m_excludeFromMinimap, &QAction::changed, [this] () {
-        if (auto tile = dynamic_cast<TrackTile *>(scene()->itemAt(mapToScene(this->m_clickedPos), QTransform())))
+        if (auto tile = m_mediator.tileAt(m_clickedScenePos))
         {
             m_mediator.saveUndoPoint();
             tile->setExcludeFromMinimap(this->m_excludeFromMinimap->isChecked());
@@ -303,15 +306,17 @@ void EditorView::mousePressEvent(QMouseEvent * event)
                 iter++;
             }
 
-            auto item = *items.begin();
-            if (auto tnode = dynamic_cast<TargetNode *>(item))
+            if (auto tnode = dynamic_cast<TargetNode *>(*items.begin()))
             {
                 handleMousePressEventOnTargetNode(*event, *tnode);
+                return;
             }
-            else if (auto tile = dynamic_cast<TrackTile *>(item))
-            {
-                handleMousePressEventOnTile(*event, *tile);
-            }
+        }
+
+        // Tiles are found directly from the tile matrix.
+        if (auto tile = m_mediator.tileAt(m_clickedScenePos))
+        {
+            handleMousePressEventOnTile(*event, *tile);
         }
     }
 }
@@ -484,6 +489,8 @@ void EditorView::handleLeftButtonClickOnTile(TrackTile & tile)
     // User is initiating a drag'n'drop
     else if (m_mediator.mode() == EditorMode::None)
     {
+        m_mediator.saveUndoPoint();
+
         tile.setZValue(tile.zValue() + 1);
         m_mediator.dadStore().setDragAndDropSourceTile(&tile);
         m_mediator.dadStore().setDragAndDropSourcePos(tile.pos());
@@ -601,16 +608,10 @@ void EditorView::handleTileDragRelease(QMouseEvent * event)
     if (auto sourceTile = m_mediator.dadStore().dragAndDropSourceTile())
     {
         // Determine the dest tile
-        auto destTile = sourceTile;
-        QList<QGraphicsItem *> items = scene()->items(mapToScene(event->pos()));
-        for (QGraphicsItem * item : items)
+        auto destTile = m_mediator.tileAt(mapToScene(event->pos()));
+        if (!destTile)
         {
-            auto testTile = dynamic_cast<TrackTile *>(item);
-            if (testTile && testTile != sourceTile)
-            {
-                destTile = testTile;
-                break;
-            }
+            destTile = sourceTile;
         }
 
         // Swap tiles
@@ -668,7 +669,7 @@ void EditorView::handleTargetNodeDragRelease(QMouseEvent * event)
 
 void EditorView::setComputerHint(TrackTileBase::ComputerHint hint)
 {
-    if (auto tile = dynamic_cast<TrackTile *>(scene()->itemAt(mapToScene(m_clickedPos), QTransform())))
+    if (auto tile = m_mediator.tileAt(m_clickedScenePos))
     {
         m_mediator.saveUndoPoint();
         tile->setComputerHint(hint);
@@ -18,45 +18,123 @@
 #include "tracktile.hpp"
 
 #include <QAction>
+#include <QGraphicsScene>
+#include <QRectF>
 
-namespace FloodFill {
-void setTileType(TrackTile & tile, QAction * action)
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// We "know" that the map contains only TrackTiles, so no need for dynamic casts.
+TrackTile * tileAt(MapBase & map, unsigned int x, unsigned int y)
 {
-    tile.setTileType(action->data().toString());
-    tile.setPixmap(action->icon().pixmap(TrackTile::TILE_W, TrackTile::TILE_H));
-}
+    return static_cast<TrackTile *>(map.getTile(x, y).get());
 }
 
-void FloodFill::floodFill(TrackTile & tile, QAction * action, const QString & typeToFill, MapBase & map)
+std::vector<TrackTile *> collectTiles(TrackTile & tile, const QString & typeToFill, MapBase & map)
 {
-    static const int DIRECTION_COUNT = 4;
+    const unsigned int cols = map.cols();
+    const unsigned int rows = map.rows();
 
-    // Coordinates of neighbor tiles can be calculated by adding these
-    // adjustments to tile coordinates.
-    static const QPoint neighborAdjustments[DIRECTION_COUNT] =
-    {
-        QPoint( 1,  0),  // right
-        QPoint( 0, -1),  // up
-        QPoint(-1,  0),  // left
-        QPoint( 0,  1)   // down
+    std::vector<bool> visited(cols * rows, false);
+
+    auto matches = [&] (unsigned int x, unsigned int y) {
+        return !visited[y * cols + x] && tileAt(map, x, y)->tileType() == typeToFill;
     };
 
-    setTileType(tile, action);
+    std::vector<TrackTile *> tiles;
 
-    QPoint location = tile.matrixLocation();
+    // Scanline fill: fill a horizontal span at a time and push seeds for the
+    // spans above and below it. The seed stack is typically very short.
+    std::vector<std::pair<unsigned int, unsigned int>> seeds;
+    seeds.push_back({static_cast<unsigned int>(tile.matrixLocation().x()), static_cast<unsigned int>(tile.matrixLocation().y())});
 
-    for (int i = 0; i < DIRECTION_COUNT; ++i)
+    while (!seeds.empty())
     {
-        int x = location.x() + neighborAdjustments[i].x();
-        int y = location.y() + neighborAdjustments[i].y();
+        const unsigned int x = seeds.back().first;
+        const unsigned int y = seeds.back().second;
+        seeds.pop_back();
 
-        if (x >= 0 && y >= 0)
+        if (!matches(x, y))
         {
-            auto tile = std::dynamic_pointer_cast<TrackTile>(map.getTile(x, y));
-            if (tile && tile->tileType() == typeToFill)
+            continue;
+        }
+
+        unsigned int left = x;
+        while (left > 0 && matches(left - 1, y))
+        {
+            left--;
+        }
+
+        unsigned int right = x;
+        while (right + 1 < cols && matches(right + 1, y))
+        {
+            right++;
+        }
+
+        for (unsigned int i = left; i <= right; i++)
+        {
+            visited[y * cols + i] = true;
+            tiles.push_back(tileAt(map, i, y));
+        }
+
+        for (int dy = -1; dy <= 1; dy += 2)
+        {
+            if ((dy < 0 && y == 0) || (dy > 0 && y + 1 >= rows))
             {
-                FloodFill::floodFill(*(tile.get()), action, typeToFill, map);
+                continue;
+            }
+
+            const unsigned int ny = y + dy;
+
+            // Push one seed per matching run in the neighboring row.
+            bool inRun = false;
+            for (unsigned int i = left; i <= right; i++)
+            {
+                if (matches(i, ny))
+                {
+                    if (!inRun)
+                    {
+                        seeds.push_back({i, ny});
+                        inRun = true;
+                    }
+                }
+                else
+                {
+                    inRun = false;
+                }
             }
         }
     }
+
+    return tiles;
+}
+
+} // namespace
+
+void FloodFill::floodFill(TrackTile & tile, QAction * action, const QString & typeToFill, MapBase & map)
+{
+    const auto tiles = collectTiles(tile, typeToFill, map);
+    if (tiles.empty())
+    {
+        return;
+    }
+
+    // All filled tiles share the same pixmap and the area is repainted only once.
+    const QString newType = action->data().toString();
+    const QPixmap pixmap = action->icon().pixmap(TrackTile::TILE_W, TrackTile::TILE_H);
+
+    QRectF dirtyRect;
+    for (auto && filledTile : tiles)
+    {
+        filledTile->setTileTypeAndPixmap(newType, pixmap);
+        dirtyRect |= filledTile->sceneBoundingRect();
+    }
+
+    if (auto scene = tile.scene())
+    {
+        scene->update(dirtyRect);
+    }
 }
@@ -34,6 +34,7 @@
 #include <QCheckBox>
 #include <QDateTime>
 #include <QDesktopWidget>
+#include <QFile>
 #include <QFileDialog>
 #include <QGraphicsLineItem>
 #include <QMenu>
@@ -62,6 +63,7 @@ MainWindow::MainWindow(QString trackFile)
 , m_scaleSlider(new QSlider(Qt::Horizontal, this))
 , m_toolBar(new QToolBar(this))
 , m_randomRotationCheck(new QCheckBox(tr("Randomly rotate objects"), this))
+, m_autosaveTimer(new QTimer(this))
 , m_argTrackFile(trackFile)
 , m_mediator(new Mediator(*this))
 {
@@ -146,6 +148,13 @@ void MainWindow::init()
     populateMenuBar();
 
     createWidgets();
+
+    connect(&m_mediator->trackIO(), &TrackIO::saveFinished, this, &MainWindow::handleSaveFinished);
+
+    connect(m_autosaveTimer, &QTimer::timeout, [this] () {
+        m_mediator->autosave();
+    });
+    m_autosaveTimer->start(m_autosaveInterval);
 }
 
 void MainWindow::createWidgets()
@@ -381,6 +390,13 @@ void MainWindow::populateMenuBar()
     connect(m_setRouteAction, SIGNAL(triggered()), this, SLOT(beginSetRoute()));
     m_setRouteAction->setEnabled(false);
 
+    // Add "validate route"-action
+    m_validateRouteAction = new QAction(tr("&Validate route"), this);
+    m_validateRouteAction->setShortcut(QKeySequence("Ctrl+T"));
+    routeMenu->addAction(m_validateRouteAction);
+    connect(m_validateRouteAction, SIGNAL(triggered()), this, SLOT(validateRoute()));
+    m_validateRouteAction->setEnabled(false);
+
     // Create "help"-menu
     QMenu * helpMenu = menuBar()->addMenu(tr("&Help"));
 
@@ -644,16 +660,7 @@ void MainWindow::saveTrack()
     }
     else
     {
-        if (m_mediator->saveTrackData())
-        {
-            console(QString(tr("Track '")) + m_mediator->currentFileName() + tr("' saved."));
-            setTitle(m_mediator->currentFileName());
-            m_saved = true;
-        }
-        else
-        {
-            console(QString(tr("Failed to save track '")) + m_mediator->currentFileName() + "'.");
-        }
+        m_mediator->saveTrackData();
     }
 
     QApplication::restoreOverrideCursor();
@@ -668,24 +675,48 @@ void MainWindow::saveAsTrack()
         QStandardPaths::writableLocation(QStandardPaths::HomeLocation),
         tr("Track Files (*.trk)"));
 
+    if (fileName.isEmpty())
+    {
+        QApplication::restoreOverrideCursor();
+        return;
+    }
+
     const QString trackFileExtension(".trk");
     if (!fileName.endsWith(trackFileExtension))
     {
         fileName += trackFileExtension;
     }
 
-    if (m_mediator->saveTrackDataAs(fileName))
+    // The title and the file name are changed in handleSaveFinished() if the save succeeds
+    m_mediator->saveTrackDataAs(fileName);
+
+    QApplication::restoreOverrideCursor();
+}
+
+void MainWindow::handleSaveFinished(QString path, bool success)
+{
+    m_mediator->handleSaveFinished(path, success);
+
+    if (path.endsWith(TrackIO::autosavePath(QString())))
     {
-        console(QString(tr("Track '")) + fileName + tr("' saved."));
-        setTitle(fileName);
+        if (!success)
+        {
+            console(QString(tr("Failed to autosave track to '")) + path + "'.");
+        }
+    }
+    else if (success)
+    {
+        console(QString(tr("Track '")) + path + tr("' saved."));
+        setTitle(path);
         m_saved = true;
+
+        // The autosave is older than the track that was just saved.
+        QFile::remove(TrackIO::autosavePath(path));
     }
     else
     {
-        console(QString(tr("Failed to save track as '")) + fileName + "'.");
+        console(QString(tr("Failed to save track '")) + path + "'.");
     }
-
-    QApplication::restoreOverrideCursor();
 }
 
 void MainWindow::setupTrackAfterUndoOrRedo()
@@ -706,6 +737,27 @@ void MainWindow::setActionStatesOnNewTrack()
     m_toolBar->setEnabled(true);
     m_setRouteAction->setEnabled(true);
     m_setTrackPropertiesAction->setEnabled(true);
+    m_validateRouteAction->setEnabled(true);
+}
+
+void MainWindow::validateRoute()
+{
+    const auto result = m_mediator->validateRoute();
+
+    for (auto && error : result.errors)
+    {
+        console(QString(tr("Route: ")) + error);
+    }
+
+    for (auto && warning : result.warnings)
+    {
+        console(QString(tr("Route: ")) + warning);
+    }
+
+    if (result.errors.isEmpty() && result.warnings.isEmpty())
+    {
+        console(QString(tr("Route: OK.")));
+    }
 }
 
 void MainWindow::setTrackProperties()
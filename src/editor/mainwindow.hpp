@@ -26,6 +26,7 @@ class QAction;
 class QCheckBox;
 class QSlider;
 class QTextEdit;
+class QTimer;
 class QToolBar;
 
 class Mediator;
@@ -99,6 +100,8 @@ private slots:
 
     void saveAsTrack();
 
+    void handleSaveFinished(QString path, bool success);
+
     void setTrackProperties();
 
     void setupTrackAfterUndoOrRedo();
@@ -115,6 +118,8 @@ private slots:
 
     void updateScale(int value);
 
+    void validateRoute();
+
 private:
 
     void addObjectsToToolBar();
@@ -157,16 +162,22 @@ private:
 
     QAction * m_setTrackPropertiesAction = nullptr;
 
+    QAction * m_validateRouteAction = nullptr;
+
     QSlider * m_scaleSlider = nullptr;
 
     QToolBar * m_toolBar = nullptr;
 
     QCheckBox * m_randomRotationCheck = nullptr;
 
+    QTimer * m_autosaveTimer = nullptr;
+
     QString m_argTrackFile;
 
     bool m_saved = false;
 
+    const int m_autosaveInterval = 60000; // ms
+
     const char * m_settingsGroup = "MainWindow";
 
     const unsigned int m_minZoom = 0;
@@ -142,6 +142,32 @@ std::vector<TrackTileBasePtr> Map::deleteRow(unsigned int at)
     return MapBase::deleteRow(at);
 }
 
+void Map::setTiles(unsigned int newCols, unsigned int newRows, const std::vector<TrackTileBasePtr> & tiles)
+{
+    while (cols() > newCols)
+    {
+        MapBase::deleteColumn(cols() - 1);
+    }
+
+    while (rows() > newRows)
+    {
+        MapBase::deleteRow(rows() - 1);
+    }
+
+    MapBase::resize(newCols, newRows);
+
+    for (unsigned int j = 0; j < rows(); j++)
+    {
+        for (unsigned int i = 0; i < cols(); i++)
+        {
+            setTile(i, j, tiles.at(j * cols() + i));
+        }
+    }
+
+    // Restore tile coordinates.
+    createEmptyTiles();
+}
+
 Map::~Map()
 {
 }
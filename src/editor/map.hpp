@@ -39,6 +39,9 @@ public:
 
     std::vector<TrackTileBasePtr> deleteRow(unsigned int at) override;
 
+    //! Replace the tile matrix with the given tiles (in row-major order) and update tile locations.
+    void setTiles(unsigned int newCols, unsigned int newRows, const std::vector<TrackTileBasePtr> & tiles);
+
     //! Destructor.
     virtual ~Map();
 
@@ -340,14 +340,35 @@ void Mediator::saveUndoPoint()
     m_editorData->saveUndoPoint();
 }
 
-bool Mediator::saveTrackData()
+void Mediator::saveTrackData()
 {
-    return m_editorData->saveTrackData();
+    m_editorData->saveTrackData();
 }
 
-bool Mediator::saveTrackDataAs(QString fileName)
+void Mediator::saveTrackDataAs(QString fileName)
 {
-    return m_editorData->saveTrackDataAs(fileName);
+    m_editorData->saveTrackDataAs(fileName);
+}
+
+void Mediator::autosave()
+{
+    m_editorData->autosave();
+}
+
+void Mediator::handleSaveFinished(QString path, bool success)
+{
+    m_editorData->handleSaveFinished(path, success);
+}
+
+TrackIO & Mediator::trackIO()
+{
+    return m_editorData->trackIO();
+}
+
+RouteValidator::Result Mediator::validateRoute()
+{
+    assert(m_editorData->trackData());
+    return RouteValidator::validate(*m_editorData->trackData());
 }
 
 void Mediator::setMode(EditorMode mode)
@@ -423,15 +444,10 @@ void Mediator::showStatusBarMessage(QString message)
 
 void Mediator::setupTrackAfterUndoOrRedo()
 {
-    delete m_editorScene;
-    m_editorScene = new QGraphicsScene;
-
-    m_editorView->setScene(m_editorScene);
+    // Undo records are applied directly to the items in the current scene,
+    // so only the size of the scene might need to be updated.
     m_editorView->updateSceneRect();
-
-    m_editorData->addTilesToScene();
-    m_editorData->addObjectsToScene();
-    m_editorData->addExistingRouteToScene();
+    m_editorView->update();
 }
 
 void Mediator::undo()
@@ -439,6 +455,20 @@ void Mediator::undo()
     m_editorData->undo();
 }
 
+TrackTile * Mediator::tileAt(QPointF scenePos) const
+{
+    if (m_editorData->trackData() && scenePos.x() >= 0 && scenePos.y() >= 0)
+    {
+        const unsigned int column = static_cast<unsigned int>(scenePos.x() / TrackTile::TILE_W);
+        const unsigned int row = static_cast<unsigned int>(scenePos.y() / TrackTile::TILE_H);
+
+        // Returns nullptr if out of bounds.
+        return dynamic_cast<TrackTile *>(m_editorData->trackData()->map().getTile(column, row).get());
+    }
+
+    return nullptr;
+}
+
 void Mediator::updateCoordinates(QPointF mappedPos)
 {
     if (m_editorData->trackData())
@@ -19,12 +19,14 @@
 #include <QString>
 
 #include "editormode.hpp"
+#include "routevalidator.hpp"
 #include "targetnode.hpp"
 
 class DragAndDropStore;
 class EditorData;
 class EditorView;
 class MainWindow;
+class TrackIO;
 class TrackTile;
 class Object;
 class QAction;
@@ -114,9 +116,17 @@ public:
 
     void saveUndoPoint();
 
-    bool saveTrackData();
+    void saveTrackData();
 
-    bool saveTrackDataAs(QString fileName);
+    void saveTrackDataAs(QString fileName);
+
+    void autosave();
+
+    void handleSaveFinished(QString path, bool success);
+
+    TrackIO & trackIO();
+
+    RouteValidator::Result validateRoute();
 
     void setScale(int value);
 
@@ -137,6 +147,9 @@ public:
 
     void undo();
 
+    //! \return tile at the given scene position or nullptr. Computed directly from the tile matrix.
+    TrackTile * tileAt(QPointF scenePos) const;
+
     void updateCoordinates(QPointF mappedPos);
 
     void updateView();
@@ -0,0 +1,86 @@
+// This file is part of Dust Racing 2D.
+// Copyright (C) 2018 Jussi Lind <jussi.lind@iki.fi>
+//
+// Dust Racing 2D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// Dust Racing 2D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Dust Racing 2D. If not, see <http://www.gnu.org/licenses/>.
+
+#include "routevalidator.hpp"
+#include "trackdata.hpp"
+
+#include "../common/route.hpp"
+#include "../common/targetnodebase.hpp"
+#include "../common/tracktilebase.hpp"
+
+#include <QObject>
+
+namespace {
+
+const TrackTileBase * tileAt(const TrackData & trackData, QPointF location)
+{
+    if (location.x() < 0 || location.y() < 0)
+    {
+        return nullptr;
+    }
+
+    const unsigned int i = static_cast<unsigned int>(location.x()) / TrackTileBase::TILE_W;
+    const unsigned int j = static_cast<unsigned int>(location.y()) / TrackTileBase::TILE_H;
+    if (i >= trackData.map().cols() || j >= trackData.map().rows())
+    {
+        return nullptr;
+    }
+
+    return trackData.map().getTile(i, j).get();
+}
+
+TrackTileBase::TileType tileTypeAt(const TrackData & trackData, QPointF location)
+{
+    auto tile = tileAt(trackData, location);
+    return tile ? TrackTileBase::tileTypeEnumFromString(tile->tileType()) : TrackTileBase::TT_NONE;
+}
+
+} // namespace
+
+namespace RouteValidator {
+
+Result validate(const TrackData & trackData)
+{
+    Result result;
+
+    const auto & route = trackData.route();
+    if (route.numNodes() < 3)
+    {
+        result.errors << QObject::tr("The route is not set.");
+        return result;
+    }
+
+    if (!route.isClosed())
+    {
+        result.errors << QObject::tr("The route is not closed.");
+    }
+
+    if (tileTypeAt(trackData, route.get(0)->location()) != TrackTileBase::TT_FINISH)
+    {
+        result.warnings << QObject::tr("The route doesn't start from a finish tile.");
+    }
+
+    for (unsigned int index = 0; index < route.numNodes(); index++)
+    {
+        if (!TrackTileBase::isAsphalt(tileTypeAt(trackData, route.get(index)->location())))
+        {
+            result.warnings << QObject::tr("Target node %1 is not on asphalt.").arg(index);
+        }
+    }
+
+    return result;
+}
+
+} // namespace RouteValidator
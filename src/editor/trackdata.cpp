@@ -140,6 +140,11 @@ std::vector<TrackTileBasePtr> TrackData::deleteRow(unsigned int at)
     return m_map.deleteRow(at);
 }
 
+void TrackData::setTiles(unsigned int cols, unsigned int rows, const std::vector<TrackTileBasePtr> & tiles)
+{
+    m_map.setTiles(cols, rows, tiles);
+}
+
 void TrackData::moveObjectsAfterColumnInsertion(unsigned int at)
 {
     for (auto object : m_objects)
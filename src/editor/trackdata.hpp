@@ -76,6 +76,9 @@ public:
     //! Delete tile row at given index and move objects.
     std::vector<TrackTileBasePtr> deleteRow(unsigned int at);
 
+    //! Replace the tile matrix with the given tiles (in row-major order). Used by undo.
+    void setTiles(unsigned int cols, unsigned int rows, const std::vector<TrackTileBasePtr> & tiles);
+
 private:
 
     void copyObjects(const TrackData & other);
@@ -15,6 +15,8 @@
 
 #include <QFile>
 #include <QDir>
+#include <QRunnable>
+#include <QSaveFile>
 #include <QTextStream>
 #include <QDomDocument>
 #include <QDomElement>
@@ -35,6 +37,8 @@
 
 #include <cassert>
 #include <memory>
+#include <utility>
+#include <vector>
 
 namespace {
 
@@ -99,110 +103,270 @@ void readTargetNode(std::vector<TargetNodeBasePtr> & route, const QDomElement &
     route.push_back(TargetNodeBasePtr(tnode));
 }
 
-void writeTiles(const TrackDataPtr trackData, QDomElement & root, QDomDocument & doc)
+//! Value copy of the data written to a track file. Can be safely used
+//! from a worker thread while the editor keeps modifying the track.
+struct TrackSnapshot
 {
-    for (unsigned int i = 0; i < trackData->map().cols(); i++)
+    struct TileData
     {
-        for (unsigned int j = 0; j < trackData->map().rows(); j++)
+        QString type;
+
+        unsigned int i;
+
+        unsigned int j;
+
+        qreal orientation;
+
+        TrackTileBase::ComputerHint computerHint;
+
+        bool excludeFromMinimap;
+    };
+
+    struct ObjectData
+    {
+        QString category;
+
+        QString role;
+
+        int x;
+
+        int y;
+
+        int orientation;
+
+        bool forceStationary;
+    };
+
+    struct TargetNodeData
+    {
+        int index;
+
+        int x;
+
+        int y;
+
+        int width;
+
+        int height;
+    };
+
+    QString name;
+
+    unsigned int cols;
+
+    unsigned int rows;
+
+    unsigned int index;
+
+    bool isUserTrack;
+
+    std::vector<TileData> tiles;
+
+    std::vector<ObjectData> objects;
+
+    std::vector<TargetNodeData> targetNodes;
+};
+
+TrackSnapshot takeSnapshot(const TrackData & trackData)
+{
+    TrackSnapshot snapshot;
+    snapshot.name = trackData.name();
+    snapshot.cols = trackData.map().cols();
+    snapshot.rows = trackData.map().rows();
+    snapshot.index = trackData.index();
+    snapshot.isUserTrack = trackData.isUserTrack();
+
+    snapshot.tiles.reserve(snapshot.cols * snapshot.rows);
+    for (unsigned int i = 0; i < snapshot.cols; i++)
+    {
+        for (unsigned int j = 0; j < snapshot.rows; j++)
         {
-            auto tile = std::dynamic_pointer_cast<TrackTile>(trackData->map().getTile(i, j));
+            // We "know" that all tiles in the editor are TrackTiles.
+            auto tile = static_cast<const TrackTile *>(trackData.map().getTile(i, j).get());
             assert(tile);
 
-            QDomElement tileElement = doc.createElement(TrackDataBase::DataKeywords::Track::tile);
-            tileElement.setAttribute(TrackDataBase::DataKeywords::Tile::type, tile->tileType());
-            tileElement.setAttribute(TrackDataBase::DataKeywords::Tile::i, i);
-            tileElement.setAttribute(TrackDataBase::DataKeywords::Tile::j, j);
-            tileElement.setAttribute(TrackDataBase::DataKeywords::Tile::orientation, tile->rotation());
+            snapshot.tiles.push_back({
+                tile->tileType(), i, j, tile->rotation(), tile->computerHint(), tile->excludeFromMinimap()});
+        }
+    }
 
-            if (tile->excludeFromMinimap()) {
-                tileElement.setAttribute(TrackDataBase::DataKeywords::Tile::excludeFromMinimap, true);
-            }
+    snapshot.objects.reserve(trackData.objects().count());
+    for (auto iter = trackData.objects().cbegin(); iter != trackData.objects().cend(); iter++)
+    {
+        auto object = std::dynamic_pointer_cast<Object>(*iter);
+        assert(object);
 
-            if (tile->computerHint() != TrackTile::CH_NONE)
-            {
-                tileElement.setAttribute(TrackDataBase::DataKeywords::Tile::computerHint, tile->computerHint());
-            }
+        snapshot.objects.push_back({
+            object->category(),
+            object->role(),
+            static_cast<int>(object->location().x()),
+            static_cast<int>(object->location().y()),
+            static_cast<int>(object->rotation()),
+            object->forceStationary()});
+    }
 
-            root.appendChild(tileElement);
-        }
+    snapshot.targetNodes.reserve(trackData.route().numNodes());
+    for (auto iter = trackData.route().cbegin(); iter != trackData.route().cend(); iter++)
+    {
+        auto tnode = *iter;
+        snapshot.targetNodes.push_back({
+            tnode->index(),
+            static_cast<int>(tnode->location().x()),
+            static_cast<int>(tnode->location().y()),
+            static_cast<int>(tnode->size().width()),
+            static_cast<int>(tnode->size().height())});
     }
+
+    return snapshot;
 }
 
-void writeObjects(TrackDataPtr trackData, QDomElement & root, QDomDocument & doc)
+void writeTiles(const TrackSnapshot & snapshot, QDomElement & root, QDomDocument & doc)
 {
-    for (auto objectPtr : trackData->objects())
+    for (auto && tile : snapshot.tiles)
     {
-        auto object = std::dynamic_pointer_cast<Object>(objectPtr);
-        assert(object);
+        QDomElement tileElement = doc.createElement(TrackDataBase::DataKeywords::Track::tile);
+        tileElement.setAttribute(TrackDataBase::DataKeywords::Tile::type, tile.type);
+        tileElement.setAttribute(TrackDataBase::DataKeywords::Tile::i, tile.i);
+        tileElement.setAttribute(TrackDataBase::DataKeywords::Tile::j, tile.j);
+        tileElement.setAttribute(TrackDataBase::DataKeywords::Tile::orientation, tile.orientation);
+
+        if (tile.excludeFromMinimap) {
+            tileElement.setAttribute(TrackDataBase::DataKeywords::Tile::excludeFromMinimap, true);
+        }
 
+        if (tile.computerHint != TrackTile::CH_NONE)
+        {
+            tileElement.setAttribute(TrackDataBase::DataKeywords::Tile::computerHint, tile.computerHint);
+        }
+
+        root.appendChild(tileElement);
+    }
+}
+
+void writeObjects(const TrackSnapshot & snapshot, QDomElement & root, QDomDocument & doc)
+{
+    for (auto && object : snapshot.objects)
+    {
         QDomElement objectElement = doc.createElement(TrackDataBase::DataKeywords::Track::object);
-        objectElement.setAttribute(TrackDataBase::DataKeywords::Object::category, object->category());
-        objectElement.setAttribute(TrackDataBase::DataKeywords::Object::role, object->role());
-        objectElement.setAttribute(TrackDataBase::DataKeywords::Object::x, static_cast<int>(object->location().x()));
-        objectElement.setAttribute(TrackDataBase::DataKeywords::Object::y, static_cast<int>(object->location().y()));
-        objectElement.setAttribute(TrackDataBase::DataKeywords::Object::orientation, static_cast<int>(object->rotation()));
+        objectElement.setAttribute(TrackDataBase::DataKeywords::Object::category, object.category);
+        objectElement.setAttribute(TrackDataBase::DataKeywords::Object::role, object.role);
+        objectElement.setAttribute(TrackDataBase::DataKeywords::Object::x, object.x);
+        objectElement.setAttribute(TrackDataBase::DataKeywords::Object::y, object.y);
+        objectElement.setAttribute(TrackDataBase::DataKeywords::Object::orientation, object.orientation);
 
-        if (object->forceStationary())
+        if (object.forceStationary)
         {
-            objectElement.setAttribute(TrackDataBase::DataKeywords::Object::forceStationary, static_cast<int>(object->forceStationary()));
+            objectElement.setAttribute(TrackDataBase::DataKeywords::Object::forceStationary, static_cast<int>(object.forceStationary));
         }
 
         root.appendChild(objectElement);
     }
 }
 
-void writeTargetNodes(TrackDataPtr trackData, QDomElement & root, QDomDocument & doc)
+void writeTargetNodes(const TrackSnapshot & snapshot, QDomElement & root, QDomDocument & doc)
 {
-    for (auto tnode : trackData->route())
+    for (auto && tnode : snapshot.targetNodes)
     {
         QDomElement tnodeElement = doc.createElement(TrackDataBase::DataKeywords::Track::node);
-        tnodeElement.setAttribute(TrackDataBase::DataKeywords::Node::index, tnode->index());
-        tnodeElement.setAttribute(TrackDataBase::DataKeywords::Node::x, static_cast<int>(tnode->location().x()));
-        tnodeElement.setAttribute(TrackDataBase::DataKeywords::Node::y, static_cast<int>(tnode->location().y()));
-        tnodeElement.setAttribute(TrackDataBase::DataKeywords::Node::width, static_cast<int>(tnode->size().width()));
-        tnodeElement.setAttribute(TrackDataBase::DataKeywords::Node::height, static_cast<int>(tnode->size().height()));
+        tnodeElement.setAttribute(TrackDataBase::DataKeywords::Node::index, tnode.index);
+        tnodeElement.setAttribute(TrackDataBase::DataKeywords::Node::x, tnode.x);
+        tnodeElement.setAttribute(TrackDataBase::DataKeywords::Node::y, tnode.y);
+        tnodeElement.setAttribute(TrackDataBase::DataKeywords::Node::width, tnode.width);
+        tnodeElement.setAttribute(TrackDataBase::DataKeywords::Node::height, tnode.height);
 
         root.appendChild(tnodeElement);
     }
 }
 
-} // namespace
-
-bool TrackIO::save(TrackDataPtr trackData, QString path)
+bool writeSnapshot(const TrackSnapshot & snapshot, QString path)
 {
     // Create content
     QDomDocument doc;
     QDomElement root = doc.createElement(TrackDataBase::DataKeywords::Header::track);
     root.setAttribute(TrackDataBase::DataKeywords::Header::version, Config::Editor::EDITOR_VERSION);
-    root.setAttribute(TrackDataBase::DataKeywords::Header::name, trackData->name());
-    root.setAttribute(TrackDataBase::DataKeywords::Header::cols, trackData->map().cols());
-    root.setAttribute(TrackDataBase::DataKeywords::Header::rows, trackData->map().rows());
-    root.setAttribute(TrackDataBase::DataKeywords::Header::index, trackData->index());
+    root.setAttribute(TrackDataBase::DataKeywords::Header::name, snapshot.name);
+    root.setAttribute(TrackDataBase::DataKeywords::Header::cols, snapshot.cols);
+    root.setAttribute(TrackDataBase::DataKeywords::Header::rows, snapshot.rows);
+    root.setAttribute(TrackDataBase::DataKeywords::Header::index, snapshot.index);
 
-    if (trackData->isUserTrack()) // Don't add the attribute at all, if not set
+    if (snapshot.isUserTrack) // Don't add the attribute at all, if not set
     {
         root.setAttribute(TrackDataBase::DataKeywords::Header::user, true);
     }
 
     doc.appendChild(root);
 
-    writeTiles(trackData, root, doc);
-    writeObjects(trackData, root, doc);
-    writeTargetNodes(trackData, root, doc);
+    writeTiles(snapshot, root, doc);
+    writeObjects(snapshot, root, doc);
+    writeTargetNodes(snapshot, root, doc);
 
-    // Save to file
-    QFile file(path);
+    // Save to a temporary file that replaces the target file on commit.
+    QSaveFile file(path);
     if (file.open(QIODevice::WriteOnly | QIODevice::Text))
     {
         QTextStream out(&file);
         out << doc.toString();
-        file.close();
-        return true;
+        out.flush();
+        return file.commit();
     }
 
     return false;
 }
 
+class SaveTask : public QRunnable
+{
+public:
+
+    SaveTask(TrackIO & trackIO, TrackSnapshot && snapshot, QString path)
+        : m_trackIO(trackIO)
+        , m_snapshot(std::move(snapshot))
+        , m_path(path)
+    {}
+
+    void run() override
+    {
+        const bool success = writeSnapshot(m_snapshot, m_path);
+
+        // Receivers in the GUI thread get this as a queued signal.
+        emit m_trackIO.saveFinished(m_path, success);
+    }
+
+private:
+
+    TrackIO & m_trackIO;
+
+    TrackSnapshot m_snapshot;
+
+    QString m_path;
+};
+
+} // namespace
+
+TrackIO::TrackIO()
+{
+    m_threadPool.setMaxThreadCount(1);
+}
+
+TrackIO::~TrackIO()
+{
+    m_threadPool.waitForDone();
+}
+
+bool TrackIO::save(TrackDataPtr trackData, QString path)
+{
+    return writeSnapshot(takeSnapshot(*trackData), path);
+}
+
+void TrackIO::saveAsync(TrackDataPtr trackData, QString path)
+{
+    m_threadPool.start(new SaveTask(*this, takeSnapshot(*trackData), path));
+}
+
+QString TrackIO::autosavePath(QString path)
+{
+    return path + ".autosave";
+}
+
 TrackDataPtr TrackIO::open(QString path)
 {
     QDomDocument doc;
@@ -16,22 +16,53 @@
 #ifndef TRACKIO_HPP
 #define TRACKIO_HPP
 
+#include <QObject>
 #include <QString>
 #include <QTemporaryDir>
+#include <QThreadPool>
 #include <QUuid>
 
 #include "trackdata.hpp"
 
-class TrackIO
+/*! Reads and writes track files.
+ *
+ *  Saving is done in two phases: a value snapshot of the track data is
+ *  taken on the calling thread, after which the document is built and
+ *  written by a worker thread. Files are written to a temporary file
+ *  that is renamed over the target only if writing succeeded. */
+class TrackIO : public QObject
 {
+    Q_OBJECT
+
 public:
 
-    //! Save given track data. Returns false if failed.
+    TrackIO();
+
+    //! Destructor. Waits for pending saves to finish.
+    virtual ~TrackIO();
+
+    //! Save given track data. Blocks until the file is written. Returns false if failed.
     bool save(TrackDataPtr trackData, QString path);
 
+    /*! Save given track data on a worker thread. Only a snapshot of the data
+     *  is taken on the calling thread. saveFinished() is emitted when done. */
+    void saveAsync(TrackDataPtr trackData, QString path);
+
     /*! Load given track data. Returns the new TrackData object,
      *  or nullptr if failed. */
     TrackDataPtr open(QString path);
+
+    //! \return the path used for autosaves of the given track file.
+    static QString autosavePath(QString path);
+
+signals:
+
+    void saveFinished(QString path, bool success);
+
+private:
+
+    //! Single worker so that saves of the same file are written in order.
+    QThreadPool m_threadPool;
 };
 
 #endif // TRACKIO_HPP
@@ -0,0 +1,162 @@
+// This file is part of Dust Racing 2D.
+// Copyright (C) 2018 Jussi Lind <jussi.lind@iki.fi>
+//
+// Dust Racing 2D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// Dust Racing 2D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Dust Racing 2D. If not, see <http://www.gnu.org/licenses/>.
+
+#include "trackstate.hpp"
+
+#include "object.hpp"
+#include "targetnode.hpp"
+#include "trackdata.hpp"
+#include "tracktile.hpp"
+
+bool TrackState::TileState::operator==(const TileState & other) const
+{
+    return type == other.type &&
+        rotation == other.rotation &&
+        computerHint == other.computerHint &&
+        excludeFromMinimap == other.excludeFromMinimap;
+}
+
+bool TrackState::TileState::operator!=(const TileState & other) const
+{
+    return !(*this == other);
+}
+
+bool TrackState::ObjectState::operator==(const ObjectState & other) const
+{
+    return location == other.location &&
+        rotation == other.rotation &&
+        forceStationary == other.forceStationary;
+}
+
+bool TrackState::ObjectState::operator!=(const ObjectState & other) const
+{
+    return !(*this == other);
+}
+
+bool TrackState::TargetNodeState::operator==(const TargetNodeState & other) const
+{
+    return location == other.location && size == other.size;
+}
+
+bool TrackState::TargetNodeState::operator!=(const TargetNodeState & other) const
+{
+    return !(*this == other);
+}
+
+TrackState::TrackState(const TrackData & trackData)
+    : m_cols(trackData.map().cols())
+    , m_rows(trackData.map().rows())
+{
+    m_tiles.reserve(m_cols * m_rows);
+    m_tileStates.reserve(m_cols * m_rows);
+    for (unsigned int j = 0; j < m_rows; j++)
+    {
+        for (unsigned int i = 0; i < m_cols; i++)
+        {
+            auto tile = trackData.map().getTile(i, j);
+            m_tiles.push_back(tile);
+            m_tileStates.push_back(tileState(*tile));
+        }
+    }
+
+    m_objects.reserve(trackData.objects().count());
+    m_objectStates.reserve(trackData.objects().count());
+    for (auto iter = trackData.objects().cbegin(); iter != trackData.objects().cend(); iter++)
+    {
+        m_objects.push_back(*iter);
+        m_objectStates.push_back(objectState(**iter));
+    }
+
+    m_route.reserve(trackData.route().numNodes());
+    m_targetNodeStates.reserve(trackData.route().numNodes());
+    for (auto iter = trackData.route().cbegin(); iter != trackData.route().cend(); iter++)
+    {
+        m_route.push_back(*iter);
+        m_targetNodeStates.push_back(targetNodeState(**iter));
+    }
+}
+
+bool TrackState::hasSameLayout(const TrackState & other) const
+{
+    return m_cols == other.m_cols && m_rows == other.m_rows && m_tiles == other.m_tiles;
+}
+
+unsigned int TrackState::cols() const
+{
+    return m_cols;
+}
+
+unsigned int TrackState::rows() const
+{
+    return m_rows;
+}
+
+const std::vector<TrackTileBasePtr> & TrackState::tiles() const
+{
+    return m_tiles;
+}
+
+const std::vector<TrackState::TileState> & TrackState::tileStates() const
+{
+    return m_tileStates;
+}
+
+const std::vector<ObjectBasePtr> & TrackState::objects() const
+{
+    return m_objects;
+}
+
+const std::vector<TrackState::ObjectState> & TrackState::objectStates() const
+{
+    return m_objectStates;
+}
+
+const std::vector<TargetNodeBasePtr> & TrackState::route() const
+{
+    return m_route;
+}
+
+const std::vector<TrackState::TargetNodeState> & TrackState::targetNodeStates() const
+{
+    return m_targetNodeStates;
+}
+
+TrackState::TileState TrackState::tileState(const TrackTileBase & tile)
+{
+    // We "know" that all tiles in the editor are TrackTiles.
+    TileState state;
+    state.type = tile.tileType();
+    state.rotation = static_cast<const TrackTile &>(tile).rotation();
+    state.computerHint = tile.computerHint();
+    state.excludeFromMinimap = tile.excludeFromMinimap();
+    return state;
+}
+
+TrackState::ObjectState TrackState::objectState(const ObjectBase & object)
+{
+    ObjectState state;
+    state.location = object.location();
+    state.rotation = static_cast<const Object &>(object).rotation();
+    state.forceStationary = object.forceStationary();
+    return state;
+}
+
+TrackState::TargetNodeState TrackState::targetNodeState(const TargetNodeBase & tnode)
+{
+    TargetNodeState state;
+    state.location = tnode.location();
+    state.size = tnode.size();
+    return state;
+}
@@ -0,0 +1,129 @@
+// This file is part of Dust Racing 2D.
+// Copyright (C) 2018 Jussi Lind <jussi.lind@iki.fi>
+//
+// Dust Racing 2D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// Dust Racing 2D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Dust Racing 2D. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef TRACKSTATE_HPP
+#define TRACKSTATE_HPP
+
+#include <QPointF>
+#include <QSizeF>
+#include <QString>
+
+#include <vector>
+
+#include "../common/objectbase.hpp"
+#include "../common/targetnodebase.hpp"
+#include "../common/tracktilebase.hpp"
+
+class TrackData;
+
+/*! Lightweight value snapshot of the editable properties of a track.
+ *  The tiles, objects and target nodes are referenced, not copied, so
+ *  capturing a state doesn't create any new graphics items. Two states
+ *  can be compared to get the set of changes between them. */
+class TrackState
+{
+public:
+
+    struct TileState
+    {
+        QString type;
+
+        qreal rotation = 0;
+
+        TrackTileBase::ComputerHint computerHint = TrackTileBase::CH_NONE;
+
+        bool excludeFromMinimap = false;
+
+        bool operator==(const TileState & other) const;
+
+        bool operator!=(const TileState & other) const;
+    };
+
+    struct ObjectState
+    {
+        QPointF location;
+
+        qreal rotation = 0;
+
+        bool forceStationary = false;
+
+        bool operator==(const ObjectState & other) const;
+
+        bool operator!=(const ObjectState & other) const;
+    };
+
+    struct TargetNodeState
+    {
+        QPointF location;
+
+        QSizeF size;
+
+        bool operator==(const TargetNodeState & other) const;
+
+        bool operator!=(const TargetNodeState & other) const;
+    };
+
+    //! Constructor. Creates an empty state.
+    TrackState() = default;
+
+    //! Constructor. Captures the current state of the given track.
+    explicit TrackState(const TrackData & trackData);
+
+    //! \return true if the tile matrices of the states contain the same tiles.
+    bool hasSameLayout(const TrackState & other) const;
+
+    unsigned int cols() const;
+
+    unsigned int rows() const;
+
+    //! Tiles in row-major order.
+    const std::vector<TrackTileBasePtr> & tiles() const;
+
+    const std::vector<TileState> & tileStates() const;
+
+    const std::vector<ObjectBasePtr> & objects() const;
+
+    const std::vector<ObjectState> & objectStates() const;
+
+    const std::vector<TargetNodeBasePtr> & route() const;
+
+    const std::vector<TargetNodeState> & targetNodeStates() const;
+
+    static TileState tileState(const TrackTileBase & tile);
+
+    static ObjectState objectState(const ObjectBase & object);
+
+    static TargetNodeState targetNodeState(const TargetNodeBase & tnode);
+
+private:
+
+    unsigned int m_cols = 0;
+
+    unsigned int m_rows = 0;
+
+    std::vector<TrackTileBasePtr> m_tiles;
+
+    std::vector<TileState> m_tileStates;
+
+    std::vector<ObjectBasePtr> m_objects;
+
+    std::vector<ObjectState> m_objectStates;
+
+    std::vector<TargetNodeBasePtr> m_route;
+
+    std::vector<TargetNodeState> m_targetNodeStates;
+};
+
+#endif // TRACKSTATE_HPP
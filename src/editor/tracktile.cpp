@@ -24,6 +24,11 @@
 #include <QGraphicsView>
 #include <QGraphicsScene>
 #include <QPainter>
+#include <QPixmapCache>
+#include <QStyleOptionGraphicsItem>
+
+#include <map>
+#include <utility>
 
 TrackTile * TrackTile::m_activeTile = nullptr;
 
@@ -57,22 +62,93 @@ QRectF TrackTile::boundingRect () const
                    m_size.width(), m_size.height());
 }
 
+namespace {
+
+//! Smallest cached size of a scaled tile pixmap.
+const int MIN_CACHED_PIXMAP_SIZE = 16;
+
+//! Max number of remembered scaled pixmap keys. Well above the tile types times
+//! the cached sizes, but new source pixmaps (e.g. from the flood fill) add keys.
+const size_t MAX_SCALED_PIXMAP_KEYS = 256;
+
+/*! Return the given pixmap scaled to the given size. Scaled pixmaps are stored
+ *  in QPixmapCache and shared by all tiles of the same type, so zoomed-out views
+ *  don't need to scale full-size pixmaps on every paint. */
+QPixmap scaledPixmap(const QPixmap & source, int size)
+{
+    if (source.isNull() || size >= source.width())
+    {
+        return source;
+    }
+
+    static std::map<std::pair<qint64, int>, QPixmapCache::Key> keys;
+
+    const auto id = std::make_pair(source.cacheKey(), size);
+    auto iter = keys.find(id);
+
+    QPixmap pixmap;
+    if (iter == keys.end() || !QPixmapCache::find(iter->second, &pixmap))
+    {
+        pixmap = source.scaled(size, size, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+
+        // Forgotten keys only leave unreachable pixmaps that QPixmapCache evicts by itself
+        if (keys.size() >= MAX_SCALED_PIXMAP_KEYS)
+        {
+            keys.clear();
+        }
+
+        keys[id] = QPixmapCache::insert(pixmap);
+    }
+
+    return pixmap;
+}
+
+//! Return the pixmap of a cleared tile. Loaded only once instead of on every paint.
+QPixmap clearPixmap()
+{
+    static QPixmapCache::Key key;
+
+    QPixmap pixmap;
+    if (!QPixmapCache::find(key, &pixmap))
+    {
+        pixmap = QPixmap(Config::Editor::CLEAR_ICON_PATH);
+        key = QPixmapCache::insert(pixmap);
+    }
+
+    return pixmap;
+}
+
+//! Return pixmap size matching the given level of detail in steps of power of two.
+int pixmapSizeForLevelOfDetail(qreal lod, int fullSize)
+{
+    int size = fullSize;
+    while (size > MIN_CACHED_PIXMAP_SIZE && size / 2 >= fullSize * lod)
+    {
+        size /= 2;
+    }
+
+    return size;
+}
+
+} // namespace
+
 void TrackTile::paint(QPainter * painter, const QStyleOptionGraphicsItem * option, QWidget * widget)
 {
     Q_UNUSED(widget);
-    Q_UNUSED(option);
 
     painter->save();
 
     QPen pen;
     pen.setJoinStyle(Qt::MiterJoin);
 
+    const int pixmapSize = pixmapSizeForLevelOfDetail(
+        option->levelOfDetailFromTransform(painter->worldTransform()), static_cast<int>(m_size.width()));
+
     // Render the tile pixmap if tile is not cleared.
     if (tileType() != "clear")
     {
-        painter->drawPixmap(boundingRect().x(), boundingRect().y(),
-            boundingRect().width(), boundingRect().height(),
-            m_pixmap);
+        const QPixmap pixmap = scaledPixmap(m_pixmap, pixmapSize);
+        painter->drawPixmap(boundingRect(), pixmap, QRectF(pixmap.rect()));
 
         // Mark the tile if it has computer hints set
         if (computerHint() == TrackTile::CH_BRAKE_HARD)
@@ -86,9 +162,8 @@ void TrackTile::paint(QPainter * painter, const QStyleOptionGraphicsItem * optio
     }
     else
     {
-        painter->drawPixmap(boundingRect().x(), boundingRect().y(),
-            boundingRect().width(), boundingRect().height(),
-            QPixmap(Config::Editor::CLEAR_ICON_PATH));
+        const QPixmap pixmap = scaledPixmap(clearPixmap(), pixmapSize);
+        painter->drawPixmap(boundingRect(), pixmap, QRectF(pixmap.rect()));
 
         pen.setColor(QColor(0, 0, 0));
         painter->setPen(pen);
@@ -180,6 +255,12 @@ void TrackTile::setPixmap(const QPixmap & pixmap)
     update();
 }
 
+void TrackTile::setTileTypeAndPixmap(const QString & type, const QPixmap & pixmap)
+{
+    TrackTileBase::setTileType(type);
+    m_pixmap = pixmap;
+}
+
 void TrackTile::swap(TrackTile & other)
 {
     // Swap tile types
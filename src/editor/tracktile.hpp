@@ -41,7 +41,7 @@ public:
         const QString & type = "clear");
 
     /*! Copy constructor.
-     *  NOTE!!: This is used when saving undo points so make sure all properties are copied! */
+     *  NOTE!!: This is used when copying whole tracks so make sure all properties are copied! */
     TrackTile(const TrackTile & other);
 
     TrackTile & operator=(const TrackTile & other) = delete;
@@ -82,6 +82,10 @@ public:
     //! Set the current pixmap
     void setPixmap(const QPixmap & pixmap);
 
+    /*! Set type and pixmap without scheduling a repaint. Used by batch
+     *  edits that update the affected scene area only once. */
+    void setTileTypeAndPixmap(const QString & type, const QPixmap & pixmap);
+
     //! Swap data with given tile. Used in drag'n'drop.
     void swap(TrackTile & other);
 
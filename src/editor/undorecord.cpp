@@ -0,0 +1,194 @@
+// This file is part of Dust Racing 2D.
+// Copyright (C) 2018 Jussi Lind <jussi.lind@iki.fi>
+//
+// Dust Racing 2D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// Dust Racing 2D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Dust Racing 2D. If not, see <http://www.gnu.org/licenses/>.
+
+#include "undorecord.hpp"
+
+#include <unordered_map>
+
+namespace {
+
+//! Compare the states of items that exist in both item vectors and
+//! store the ones that differ. Returns true if the item vectors differ.
+template<typename Item, typename State, typename ChangeType>
+bool recordChanges(
+    const std::vector<Item> & beforeItems, const std::vector<State> & beforeStates,
+    const std::vector<Item> & afterItems, const std::vector<State> & afterStates,
+    std::vector<ChangeType> & changes)
+{
+    if (beforeItems == afterItems)
+    {
+        for (size_t i = 0; i < afterItems.size(); i++)
+        {
+            if (beforeStates[i] != afterStates[i])
+            {
+                changes.push_back({afterItems[i], beforeStates[i], afterStates[i]});
+            }
+        }
+
+        return false;
+    }
+
+    std::unordered_map<const void *, size_t> beforeIndices;
+    for (size_t i = 0; i < beforeItems.size(); i++)
+    {
+        beforeIndices[beforeItems[i].get()] = i;
+    }
+
+    for (size_t i = 0; i < afterItems.size(); i++)
+    {
+        auto iter = beforeIndices.find(afterItems[i].get());
+        if (iter != beforeIndices.end() && beforeStates[iter->second] != afterStates[i])
+        {
+            changes.push_back({afterItems[i], beforeStates[iter->second], afterStates[i]});
+        }
+    }
+
+    return true;
+}
+
+} // namespace
+
+UndoRecord::UndoRecord(const TrackState & before, const TrackState & after)
+{
+    recordTileChanges(before, after);
+
+    recordObjectChanges(before, after);
+
+    recordTargetNodeChanges(before, after);
+}
+
+void UndoRecord::recordTileChanges(const TrackState & before, const TrackState & after)
+{
+    if (before.cols() != after.cols() || before.rows() != after.rows())
+    {
+        m_layoutChanged = true;
+    }
+
+    m_layoutChanged |= recordChanges(
+        before.tiles(), before.tileStates(), after.tiles(), after.tileStates(), m_tileChanges);
+
+    if (m_layoutChanged)
+    {
+        m_layoutBefore.cols = before.cols();
+        m_layoutBefore.rows = before.rows();
+        m_layoutBefore.tiles = before.tiles();
+
+        m_layoutAfter.cols = after.cols();
+        m_layoutAfter.rows = after.rows();
+        m_layoutAfter.tiles = after.tiles();
+    }
+}
+
+void UndoRecord::recordObjectChanges(const TrackState & before, const TrackState & after)
+{
+    m_objectsChanged = recordChanges(
+        before.objects(), before.objectStates(), after.objects(), after.objectStates(), m_objectChanges);
+
+    if (m_objectsChanged)
+    {
+        m_objectsBefore = before.objects();
+        m_objectsAfter = after.objects();
+    }
+}
+
+void UndoRecord::recordTargetNodeChanges(const TrackState & before, const TrackState & after)
+{
+    m_routeChanged = recordChanges(
+        before.route(), before.targetNodeStates(), after.route(), after.targetNodeStates(), m_targetNodeChanges);
+
+    if (m_routeChanged)
+    {
+        m_routeBefore = before.route();
+        m_routeAfter = after.route();
+    }
+}
+
+bool UndoRecord::isEmpty() const
+{
+    return m_tileChanges.empty() && !m_layoutChanged &&
+        m_objectChanges.empty() && !m_objectsChanged &&
+        m_targetNodeChanges.empty() && !m_routeChanged;
+}
+
+size_t UndoRecord::memoryUsage() const
+{
+    return sizeof(UndoRecord) +
+        m_tileChanges.capacity() * sizeof(TileChange) +
+        (m_layoutBefore.tiles.capacity() + m_layoutAfter.tiles.capacity()) * sizeof(TrackTileBasePtr) +
+        m_objectChanges.capacity() * sizeof(ObjectChange) +
+        (m_objectsBefore.capacity() + m_objectsAfter.capacity()) * sizeof(ObjectBasePtr) +
+        m_targetNodeChanges.capacity() * sizeof(TargetNodeChange) +
+        (m_routeBefore.capacity() + m_routeAfter.capacity()) * sizeof(TargetNodeBasePtr);
+}
+
+const std::vector<UndoRecord::TileChange> & UndoRecord::tileChanges() const
+{
+    return m_tileChanges;
+}
+
+bool UndoRecord::layoutChanged() const
+{
+    return m_layoutChanged;
+}
+
+const UndoRecord::Layout & UndoRecord::layoutBefore() const
+{
+    return m_layoutBefore;
+}
+
+const UndoRecord::Layout & UndoRecord::layoutAfter() const
+{
+    return m_layoutAfter;
+}
+
+const std::vector<UndoRecord::ObjectChange> & UndoRecord::objectChanges() const
+{
+    return m_objectChanges;
+}
+
+bool UndoRecord::objectsChanged() const
+{
+    return m_objectsChanged;
+}
+
+const std::vector<ObjectBasePtr> & UndoRecord::objectsBefore() const
+{
+    return m_objectsBefore;
+}
+
+const std::vector<ObjectBasePtr> & UndoRecord::objectsAfter() const
+{
+    return m_objectsAfter;
+}
+
+const std::vector<UndoRecord::TargetNodeChange> & UndoRecord::targetNodeChanges() const
+{
+    return m_targetNodeChanges;
+}
+
+bool UndoRecord::routeChanged() const
+{
+    return m_routeChanged;
+}
+
+const std::vector<TargetNodeBasePtr> & UndoRecord::routeBefore() const
+{
+    return m_routeBefore;
+}
+
+const std::vector<TargetNodeBasePtr> & UndoRecord::routeAfter() const
+{
+    return m_routeAfter;
+}
@@ -0,0 +1,127 @@
+// This file is part of Dust Racing 2D.
+// Copyright (C) 2018 Jussi Lind <jussi.lind@iki.fi>
+//
+// Dust Racing 2D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// Dust Racing 2D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Dust Racing 2D. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef UNDORECORD_HPP
+#define UNDORECORD_HPP
+
+#include "trackstate.hpp"
+
+#include <memory>
+#include <vector>
+
+/*! A single undo step. Only the tiles, objects and target nodes that
+ *  were changed are stored together with their states before and after
+ *  the change. The tile matrix, object list and route are stored only if
+ *  they were changed structurally (rows/columns, objects or nodes added
+ *  or removed). */
+class UndoRecord
+{
+public:
+
+    template<typename Item, typename State>
+    struct Change
+    {
+        Item item;
+
+        State before;
+
+        State after;
+    };
+
+    using TileChange = Change<TrackTileBasePtr, TrackState::TileState>;
+
+    using ObjectChange = Change<ObjectBasePtr, TrackState::ObjectState>;
+
+    using TargetNodeChange = Change<TargetNodeBasePtr, TrackState::TargetNodeState>;
+
+    struct Layout
+    {
+        unsigned int cols = 0;
+
+        unsigned int rows = 0;
+
+        //! Tiles in row-major order.
+        std::vector<TrackTileBasePtr> tiles;
+    };
+
+    //! Constructor. Records the differences between the given states.
+    UndoRecord(const TrackState & before, const TrackState & after);
+
+    //! \return true if there's nothing to undo.
+    bool isEmpty() const;
+
+    //! \return approximate heap memory used by the record in bytes.
+    size_t memoryUsage() const;
+
+    const std::vector<TileChange> & tileChanges() const;
+
+    bool layoutChanged() const;
+
+    const Layout & layoutBefore() const;
+
+    const Layout & layoutAfter() const;
+
+    const std::vector<ObjectChange> & objectChanges() const;
+
+    bool objectsChanged() const;
+
+    const std::vector<ObjectBasePtr> & objectsBefore() const;
+
+    const std::vector<ObjectBasePtr> & objectsAfter() const;
+
+    const std::vector<TargetNodeChange> & targetNodeChanges() const;
+
+    bool routeChanged() const;
+
+    const std::vector<TargetNodeBasePtr> & routeBefore() const;
+
+    const std::vector<TargetNodeBasePtr> & routeAfter() const;
+
+private:
+
+    void recordTileChanges(const TrackState & before, const TrackState & after);
+
+    void recordObjectChanges(const TrackState & before, const TrackState & after);
+
+    void recordTargetNodeChanges(const TrackState & before, const TrackState & after);
+
+    std::vector<TileChange> m_tileChanges;
+
+    bool m_layoutChanged = false;
+
+    Layout m_layoutBefore;
+
+    Layout m_layoutAfter;
+
+    std::vector<ObjectChange> m_objectChanges;
+
+    bool m_objectsChanged = false;
+
+    std::vector<ObjectBasePtr> m_objectsBefore;
+
+    std::vector<ObjectBasePtr> m_objectsAfter;
+
+    std::vector<TargetNodeChange> m_targetNodeChanges;
+
+    bool m_routeChanged = false;
+
+    std::vector<TargetNodeBasePtr> m_routeBefore;
+
+    std::vector<TargetNodeBasePtr> m_routeAfter;
+};
+
+using UndoRecordPtr = std::shared_ptr<UndoRecord>;
+
+#endif // UNDORECORD_HPP
@@ -20,49 +20,78 @@ UndoStack::UndoStack(unsigned int maxHistorySize)
 {
 }
 
-void UndoStack::pushUndoPoint(TrackDataPtr trackData)
+bool UndoStack::recordChanges(TrackDataPtr trackData)
 {
-    auto copyData = new TrackData(*trackData.get());
-    m_undoStack.push_back(TrackDataPtr(copyData));
+    m_hasPendingChanges = false;
+
+    TrackState newState(*trackData);
+    UndoRecordPtr record(new UndoRecord(m_baseState, newState));
+    m_baseState = std::move(newState);
+
+    if (record->isEmpty())
+    {
+        return false;
+    }
+
+    m_undoStack.push_back(record);
 
     if (m_undoStack.size() > m_maxHistorySize)
     {
         m_undoStack.pop_front();
     }
+
+    // The redo records are not valid anymore after a new change.
+    m_redoStack.clear();
+
+    return true;
 }
 
-void UndoStack::pushRedoPoint(TrackDataPtr trackData)
+void UndoStack::pushUndoPoint(TrackDataPtr trackData)
 {
-    auto copyData = new TrackData(*trackData.get());
-    m_redoStack.push_back(TrackDataPtr(copyData));
-
-    if (m_redoStack.size() > m_maxHistorySize)
+    if (m_hasPendingChanges)
     {
-        m_redoStack.pop_front();
+        recordChanges(trackData);
     }
+
+    m_hasPendingChanges = true;
+}
+
+void UndoStack::reset(TrackDataPtr trackData)
+{
+    clear();
+
+    setBaseState(trackData);
 }
 
 void UndoStack::clear()
 {
     m_undoStack.clear();
     m_redoStack.clear();
+    m_baseState = TrackState();
+    m_hasPendingChanges = false;
 }
 
 bool UndoStack::isUndoable() const
 {
-    return m_undoStack.size() > 0;
+    return m_undoStack.size() > 0 || m_hasPendingChanges;
 }
 
-TrackDataPtr UndoStack::undo()
+UndoRecordPtr UndoStack::undo(TrackDataPtr trackData)
 {
-    if (isUndoable())
+    if (m_hasPendingChanges)
+    {
+        recordChanges(trackData);
+    }
+
+    if (m_undoStack.size())
     {
         auto head = m_undoStack.back();
         m_undoStack.pop_back();
+        m_redoStack.push_back(head);
         return head;
     }
 
-    return TrackDataPtr();
+    return UndoRecordPtr();
 }
 
 bool UndoStack::isRedoable() const
@@ -70,14 +99,42 @@ bool UndoStack::isRedoable() const
     return m_redoStack.size() > 0;
 }
 
-TrackDataPtr UndoStack::redo()
+UndoRecordPtr UndoStack::redo(TrackDataPtr trackData)
 {
+    if (m_hasPendingChanges)
+    {
+        recordChanges(trackData);
+    }
+
     if (isRedoable())
     {
         auto head = m_redoStack.back();
         m_redoStack.pop_back();
+        m_undoStack.push_back(head);
         return head;
     }
 
-    return TrackDataPtr();
+    return UndoRecordPtr();
+}
+
+void UndoStack::setBaseState(TrackDataPtr trackData)
+{
+    m_baseState = TrackState(*trackData);
+}
+
+size_t UndoStack::memoryUsage() const
+{
+    size_t result = 0;
+
+    for (auto && record : m_undoStack)
+    {
+        result += record->memoryUsage();
+    }
+
+    for (auto && record : m_redoStack)
+    {
+        result += record->memoryUsage();
+    }
+
+    return result;
 }
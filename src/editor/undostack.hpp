@@ -17,36 +17,66 @@
 #define UNDOSTACK_HPP
 
 #include "trackdata.hpp"
+#include "trackstate.hpp"
+#include "undorecord.hpp"
 
 #include <list>
 
+/*! Stores the edit history as UndoRecords. Only the differences between
+ *  consecutive undo points are stored, not copies of the whole track.
+ *
+ *  An undo point is pushed right before an edit. The changes of the edit
+ *  are recorded against the state of the previous undo point when the next
+ *  undo point is pushed, or when the edit is undone. */
 class UndoStack
 {
 public:
 
     UndoStack(unsigned int maxHistorySize = 100);
 
+    //! Record the changes made since the previous undo point.
     void pushUndoPoint(TrackDataPtr trackData);
 
-    void pushRedoPoint(TrackDataPtr trackData);
+    //! Clear the history and use the current state of the given track as the base state.
+    void reset(TrackDataPtr trackData);
 
+    //! Clear the history.
     void clear();
 
     bool isUndoable() const;
 
-    TrackDataPtr undo();
+    /*! Record pending changes and move the latest record to the redo stack.
+     *  The caller must revert the returned record and then call setBaseState().
+     *  \return The record to be reverted or nullptr if nothing to undo. */
+    UndoRecordPtr undo(TrackDataPtr trackData);
 
     bool isRedoable() const;
 
-    TrackDataPtr redo();
+    /*! Move the latest redo record back to the undo stack.
+     *  The caller must re-apply the returned record and then call setBaseState().
+     *  \return The record to be re-applied or nullptr if nothing to redo. */
+    UndoRecordPtr redo(TrackDataPtr trackData);
+
+    //! Set the state that the next changes are recorded against.
+    void setBaseState(TrackDataPtr trackData);
+
+    //! \return approximate memory used by the history in bytes.
+    size_t memoryUsage() const;
 
 private:
 
-    using TrackDataVector = std::list<TrackDataPtr>;
+    //! Record changes made since the base state. Returns true if there were changes.
+    bool recordChanges(TrackDataPtr trackData);
+
+    using UndoRecordList = std::list<UndoRecordPtr>;
+
+    UndoRecordList m_undoStack;
+
+    UndoRecordList m_redoStack;
 
-    TrackDataVector m_undoStack;
+    TrackState m_baseState;
 
-    TrackDataVector m_redoStack;
+    bool m_hasPendingChanges = false;
 
     unsigned int m_maxHistorySize;
 };
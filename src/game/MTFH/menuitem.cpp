@@ -171,11 +171,21 @@ void MenuItem::setSelected(bool flag)
         }
     }
 
+    if (m_view && m_selected != flag)
+    {
+        m_view->invalidate();
+    }
+
     m_selected = flag;
 }
 
 void MenuItem::setFocused(bool focused)
 {
+    if (m_view && m_focused != focused)
+    {
+        m_view->invalidate();
+    }
+
     m_focused = focused;
 }
 
@@ -32,6 +32,10 @@ void MenuItemView::stepTime(int)
 {
 }
 
+void MenuItemView::invalidate()
+{
+}
+
 MenuItemView::~MenuItemView()
 {
 }
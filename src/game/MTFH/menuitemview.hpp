@@ -42,6 +42,10 @@ public:
     //! Re-imp for animations etc.
     virtual void stepTime(int msecs);
 
+    /*! Re-imp to drop cached rendering of the view, if any. Called by the
+     *  owner when its focus or selection changes. */
+    virtual void invalidate();
+
 private:
 
     MenuItem & m_owner;
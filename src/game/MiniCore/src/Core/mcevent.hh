@@ -51,9 +51,13 @@ public:
   //! Return true, if event was accepted.
   bool accepted() const;
 
+protected:
+
+  //! Copy constructor for event types that can be queued.
+  MCEvent(const MCEvent & other) = default;
+
 private:
 
-  DISABLE_COPY(MCEvent);
   DISABLE_ASSI(MCEvent);
 
   static unsigned int m_typeCount;
@@ -0,0 +1,154 @@
+// This file belongs to the "MiniCore" game engine.
+// Copyright (C) 2018 Jussi Lind <jussi.lind@iki.fi>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+// MA  02110-1301, USA.
+//
+#ifndef MCEVENTQUEUE_HH
+#define MCEVENTQUEUE_HH
+
+#include "mceventqueuebase.hh"
+#include "mcobject.hh"
+
+#include <functional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/*! Typed event queue. Handlers are subscribed per receiving object. Events
+ *  posted during a world step are stored into a flat array and delivered in
+ *  bulk by MCWorld after the step. Events posted to objects without a handler
+ *  are only counted, they are never constructed nor stored.
+ *
+ *  EventType must be copy constructible and provide a static typeId(). */
+template<typename EventType>
+class MCEventQueue : public MCEventQueueBase
+{
+public:
+
+    typedef std::function<void (EventType &)> Handler;
+
+    //! \return the queue of the event type.
+    static MCEventQueue & instance()
+    {
+        static MCEventQueue queue;
+        return queue;
+    }
+
+    //! Subscribe handler for events sent to the given object. Replaces the previous handler.
+    void subscribe(MCObject & receiver, Handler handler)
+    {
+        m_handlers[&receiver] = handler;
+        receiver.setHasEventHandler(EventType::typeId(), true);
+    }
+
+    //! \reimp
+    virtual void unsubscribe(MCObject & receiver) override
+    {
+        m_handlers.erase(&receiver);
+        receiver.setHasEventHandler(EventType::typeId(), false);
+
+        for (auto && event : m_events)
+        {
+            if (event.first == &receiver)
+            {
+                event.first = nullptr;
+            }
+        }
+    }
+
+    //! \return true if the object has subscribed a handler.
+    bool hasHandler(const MCObject & receiver) const
+    {
+        return receiver.hasEventHandler(EventType::typeId());
+    }
+
+    /*! Queue an event for the given object. The event is constructed from
+     *  the given arguments only if the object has a handler. */
+    template<typename ... Args>
+    void post(MCObject & receiver, Args && ... args)
+    {
+        m_generatedCount++;
+
+        if (hasHandler(receiver))
+        {
+            m_events.emplace_back(
+                std::piecewise_construct,
+                std::forward_as_tuple(&receiver),
+                std::forward_as_tuple(std::forward<Args>(args)...));
+        }
+    }
+
+    //! \reimp
+    virtual void dispatch() override
+    {
+        // Handlers may post new events, so the size is re-evaluated.
+        for (size_t i = 0; i < m_events.size(); i++)
+        {
+            if (MCObject * receiver = m_events[i].first)
+            {
+                auto iter = m_handlers.find(receiver);
+                if (iter != m_handlers.end())
+                {
+                    iter->second(m_events[i].second);
+                    m_handledCount++;
+                }
+            }
+        }
+
+        m_events.clear();
+    }
+
+    //! \return number of queued events.
+    size_t queuedCount() const
+    {
+        return m_events.size();
+    }
+
+    //! \return number of events posted, including the ones to objects without a handler.
+    size_t generatedCount() const
+    {
+        return m_generatedCount;
+    }
+
+    //! \return number of events delivered to handlers.
+    size_t handledCount() const
+    {
+        return m_handledCount;
+    }
+
+    void resetCounters()
+    {
+        m_generatedCount = 0;
+        m_handledCount = 0;
+    }
+
+private:
+
+    MCEventQueue()
+    : MCEventQueueBase(EventType::typeId())
+    {
+    }
+
+    std::unordered_map<const MCObject *, Handler> m_handlers;
+
+    std::vector<std::pair<MCObject *, EventType>> m_events;
+
+    size_t m_generatedCount = 0;
+
+    size_t m_handledCount = 0;
+};
+
+#endif // MCEVENTQUEUE_HH
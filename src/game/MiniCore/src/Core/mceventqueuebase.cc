@@ -0,0 +1,64 @@
+// This file belongs to the "MiniCore" game engine.
+// Copyright (C) 2018 Jussi Lind <jussi.lind@iki.fi>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+// MA  02110-1301, USA.
+//
+#include "mceventqueuebase.hh"
+#include "mcobject.hh"
+
+MCEventQueueBase::MCEventQueueBase(unsigned int eventTypeId)
+: m_eventTypeId(eventTypeId)
+{
+    if (queues().size() <= eventTypeId)
+    {
+        queues().resize(eventTypeId + 1, nullptr);
+    }
+
+    queues()[eventTypeId] = this;
+}
+
+std::vector<MCEventQueueBase *> & MCEventQueueBase::queues()
+{
+    static std::vector<MCEventQueueBase *> queues;
+    return queues;
+}
+
+void MCEventQueueBase::dispatchAll()
+{
+    for (MCEventQueueBase * queue : queues())
+    {
+        if (queue)
+        {
+            queue->dispatch();
+        }
+    }
+}
+
+void MCEventQueueBase::unsubscribeAll(MCObject & receiver)
+{
+    for (unsigned int eventTypeId = 0; eventTypeId < queues().size(); eventTypeId++)
+    {
+        if (queues()[eventTypeId] && receiver.hasEventHandler(eventTypeId))
+        {
+            queues()[eventTypeId]->unsubscribe(receiver);
+        }
+    }
+}
+
+MCEventQueueBase::~MCEventQueueBase()
+{
+    queues()[m_eventTypeId] = nullptr;
+}
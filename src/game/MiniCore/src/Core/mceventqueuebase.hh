@@ -0,0 +1,66 @@
+// This file belongs to the "MiniCore" game engine.
+// Copyright (C) 2018 Jussi Lind <jussi.lind@iki.fi>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+// MA  02110-1301, USA.
+//
+#ifndef MCEVENTQUEUEBASE_HH
+#define MCEVENTQUEUEBASE_HH
+
+#include "mcmacros.hh"
+
+#include <vector>
+
+class MCObject;
+
+/*! Base class of the typed event queues. Keeps track of the queue of each
+ *  event type so that all queued events can be dispatched after a world step
+ *  and destroyed objects can be removed from all queues they subscribed to.
+ *  \see MCEventQueue */
+class MCEventQueueBase
+{
+public:
+
+    //! Dispatch the queued events of all event types.
+    static void dispatchAll();
+
+    //! Remove the given object from the queues it has subscribed to.
+    static void unsubscribeAll(MCObject & receiver);
+
+    //! Dispatch the queued events to the subscribed handlers.
+    virtual void dispatch() = 0;
+
+    //! Remove handler of the given object and its queued events.
+    virtual void unsubscribe(MCObject & receiver) = 0;
+
+protected:
+
+    //! Constructor. Registers the queue for the given event type id.
+    explicit MCEventQueueBase(unsigned int eventTypeId);
+
+    //! Destructor.
+    virtual ~MCEventQueueBase();
+
+private:
+
+    DISABLE_COPY(MCEventQueueBase);
+    DISABLE_ASSI(MCEventQueueBase);
+
+    static std::vector<MCEventQueueBase *> & queues();
+
+    unsigned int m_eventTypeId;
+};
+
+#endif // MCEVENTQUEUEBASE_HH
@@ -55,6 +55,14 @@ float MCMathUtil::distanceFromVector(const MCVector2dF & p, const MCVector2dF &
     return abs(p.dot(MCVector2dF(-v.j(), v.i()).normalized()));
 }
 
+MCVector2dF MCMathUtil::closestPointOnSegment(const MCVector2dF & p, const MCSegmentF & s, float & fraction)
+{
+    const MCVector2dF v(s.vertex1 - s.vertex0);
+    const float lengthSquared = v.lengthSquared();
+    fraction = lengthSquared > 0 ? std::min(std::max((p - s.vertex0).dot(v) / lengthSquared, 0.0f), 1.0f) : 0.0f;
+    return s.vertex0 + v * fraction;
+}
+
 bool MCMathUtil::crosses(const MCSegmentF & a, const MCSegmentF & b)
 {
     const MCVector2dF a0a1(a.vertex1 - a.vertex0);
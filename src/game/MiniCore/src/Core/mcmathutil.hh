@@ -69,6 +69,10 @@ public:
      *  \param v Vector that defines the line */
     static float distanceFromVector(const MCVector2dF & p, const MCVector2dF & v);
 
+    /*! \returns the point on the given segment that is closest to p.
+     *  \param fraction Set to the position of the point along the segment in [0, 1]. */
+    static MCVector2dF closestPointOnSegment(const MCVector2dF & p, const MCSegmentF & s, float & fraction);
+
     //! Return X-coordinate of the given point rotated by given angle.
     static float rotatedX(float x0, float y0, float angle);
 
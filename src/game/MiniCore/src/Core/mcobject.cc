@@ -23,17 +23,20 @@
 #include "mccircleshape.hh"
 #include "mccollisionevent.hh"
 #include "mcevent.hh"
+#include "mceventqueue.hh"
 #include "mcoutofboundariesevent.hh"
 #include "mcphysicscomponent.hh"
 #include "mcrectshape.hh"
 #include "mcshapeview.hh"
 #include "mcsurface.hh"
 #include "mctimerevent.hh"
+#include "mctriggerevent.hh"
 #include "mctrigonom.hh"
 #include "mcsurfaceview.hh"
 #include "mcworld.hh"
 #include "mcworldrenderer.hh"
 
+#include <algorithm>
 #include <cassert>
 
 namespace {
@@ -48,6 +51,8 @@ const int isParticleBit       = 128;
 MCTypeRegistry MCObject::m_typeRegistry;
 MCObject::TimerEventObjectsList MCObject::m_timerEventObjects;
 
+MCObject::DirtyTransformObjectsList MCObject::m_dirtyTransformObjects;
+
 MCObject::MCObject(const std::string & typeName)
     : m_typeId(MCObject::m_typeRegistry.registerType(typeName))
     , m_typeName(typeName)
@@ -234,6 +239,11 @@ bool MCObject::event(MCEvent & event)
         collisionEvent(static_cast<MCCollisionEvent &>(event));
         return true;
     }
+    else if (event.instanceTypeId() == MCTriggerEvent::typeId())
+    {
+        triggerEvent(static_cast<MCTriggerEvent &>(event));
+        return true;
+    }
     else if (event.instanceTypeId() == MCOutOfBoundariesEvent::typeId())
     {
         outOfBoundariesEvent(static_cast<MCOutOfBoundariesEvent &>(event));
@@ -248,6 +258,11 @@ void MCObject::collisionEvent(MCCollisionEvent & event)
     event.accept();
 }
 
+void MCObject::triggerEvent(MCTriggerEvent & event)
+{
+    event.accept();
+}
+
 void MCObject::outOfBoundariesEvent(MCOutOfBoundariesEvent & event)
 {
     event.accept();
@@ -288,6 +303,49 @@ void MCObject::sendTimerEvent(MCTimerEvent & event)
     }
 }
 
+void MCObject::subscribeCollisionEvent(MCObject & object)
+{
+    MCEventQueue<MCCollisionEvent>::instance().subscribe(object, [&object] (MCCollisionEvent & event) {
+        object.collisionEvent(event);
+    });
+}
+
+void MCObject::unsubscribeCollisionEvent(MCObject & object)
+{
+    MCEventQueue<MCCollisionEvent>::instance().unsubscribe(object);
+}
+
+void MCObject::subscribeTriggerEvent(MCObject & object)
+{
+    MCEventQueue<MCTriggerEvent>::instance().subscribe(object, [&object] (MCTriggerEvent & event) {
+        object.triggerEvent(event);
+    });
+}
+
+void MCObject::unsubscribeTriggerEvent(MCObject & object)
+{
+    MCEventQueue<MCTriggerEvent>::instance().unsubscribe(object);
+}
+
+bool MCObject::hasEventHandler(unsigned int eventTypeId) const
+{
+    return m_eventHandlerMask & (1u << eventTypeId);
+}
+
+void MCObject::setHasEventHandler(unsigned int eventTypeId, bool hasHandler)
+{
+    assert(eventTypeId < 32);
+
+    if (hasHandler)
+    {
+        m_eventHandlerMask |= 1u << eventTypeId;
+    }
+    else
+    {
+        m_eventHandlerMask &= ~(1u << eventTypeId);
+    }
+}
+
 void MCObject::addToWorld()
 {
     MCWorld::instance().addObject(*this);
@@ -372,6 +430,7 @@ bool MCObject::testStatus(int bit) const
 void MCObject::setIsPhysicsObject(bool flag)
 {
     setStatus(physicsObjectBit, flag);
+    updateCollisionFilter();
 }
 
 bool MCObject::isPhysicsObject() const
@@ -382,6 +441,7 @@ bool MCObject::isPhysicsObject() const
 void MCObject::setIsTriggerObject(bool flag)
 {
     setStatus(triggerObjectBit, flag);
+    updateCollisionFilter();
 }
 
 bool MCObject::isTriggerObject() const
@@ -392,6 +452,7 @@ bool MCObject::isTriggerObject() const
 void MCObject::setBypassCollisions(bool flag)
 {
     setStatus(bypassCollisionsBit, flag);
+    updateCollisionFilter();
 }
 
 bool MCObject::bypassCollisions() const
@@ -440,7 +501,7 @@ void MCObject::translate(const MCVector3dF & newLocation)
     {
         m_location = newLocation;
 
-        updateChildTransforms();
+        markChildTransformsDirty();
     }
     else
     {
@@ -461,7 +522,7 @@ void MCObject::translate(const MCVector3dF & newLocation)
 
         m_shape->translate(m_location - MCVector3dF(m_center));
 
-        updateChildTransforms();
+        markChildTransformsDirty();
 
         if (wasInWorld)
         {
@@ -505,7 +566,7 @@ void MCObject::rotate(float newAngle, bool updateChildTransforms_)
 
     if (updateChildTransforms_)
     {
-        updateChildTransforms();
+        markChildTransformsDirty();
     }
 }
 
@@ -570,7 +631,7 @@ void MCObject::setShape(MCShapePtr shape)
     }
 }
 
-MCShapePtr MCObject::shape() const
+const MCShapePtr & MCObject::shape() const
 {
     return m_shape;
 }
@@ -578,6 +639,7 @@ MCShapePtr MCObject::shape() const
 void MCObject::setCollisionLayer(int layer)
 {
     m_collisionLayer = layer;
+    updateCollisionFilter();
 
     for (auto child : m_children) {
         child->setCollisionLayer(layer);
@@ -589,6 +651,46 @@ int MCObject::collisionLayer() const
     return m_collisionLayer;
 }
 
+void MCObject::setCollisionGroup(int group)
+{
+    m_collisionGroup = group;
+    updateCollisionFilter();
+}
+
+int MCObject::collisionGroup() const
+{
+    return m_collisionGroup;
+}
+
+const MCCollisionFilter & MCObject::collisionFilter() const
+{
+    return m_collisionFilter;
+}
+
+void MCObject::updateCollisionFilter()
+{
+    if (!m_physicsComponent)
+    {
+        return;
+    }
+
+    if ((isPhysicsObject() || isTriggerObject()) && !bypassCollisions())
+    {
+        m_collisionFilter = MCCollisionFilter(m_collisionLayer,
+            m_physicsComponent->collisionTag(), m_physicsComponent->neverCollideWithTag(), m_collisionGroup);
+    }
+    else
+    {
+        m_collisionFilter = MCCollisionFilter();
+    }
+
+    // The object grid stores a copy of the filter with the object
+    if (m_shape && !removing() && MCWorld::hasInstance() && MCWorld::instance().objectGrid().remove(*this))
+    {
+        MCWorld::instance().objectGrid().insert(*this);
+    }
+}
+
 void MCObject::setIndex(int newIndex)
 {
     m_index = newIndex;
@@ -671,15 +773,47 @@ int MCObject::initialAngle() const
     return m_initialAngle;
 }
 
+void MCObject::markChildTransformsDirty()
+{
+    if (!m_childTransformsDirty && !m_children.empty())
+    {
+        m_childTransformsDirty = true;
+        m_dirtyTransformObjects.push_back(this);
+    }
+}
+
+void MCObject::resolveChildTransforms()
+{
+    // Updating a subtree clears the dirty flags of its objects, so objects
+    // whose parent was already handled are skipped.
+    for (size_t i = 0; i < m_dirtyTransformObjects.size(); i++)
+    {
+        MCObject * object = m_dirtyTransformObjects[i];
+        if (object->m_childTransformsDirty)
+        {
+            object->updateChildTransforms();
+        }
+    }
+
+    m_dirtyTransformObjects.clear();
+}
+
 void MCObject::updateChildTransforms()
 {
-    for (auto child : m_children)
+    m_childTransformsDirty = false;
+
+    for (auto && child : m_children)
     {
         const float newAngle = m_angle + child->m_relativeAngle;
         child->rotate(newAngle);
         child->translate(m_location - MCVector3dF(m_center) +
             MCVector3dF(MCMathUtil::rotatedVector(child->m_relativeLocation, m_angle),
                 child->m_relativeLocation.k()));
+
+        if (child->m_childTransformsDirty)
+        {
+            child->updateChildTransforms();
+        }
     }
 }
 
@@ -703,6 +837,8 @@ void MCObject::setPhysicsComponent(MCPhysicsComponent & physicsComponent)
     delete m_physicsComponent;
     m_physicsComponent = &physicsComponent;
     m_physicsComponent->setObject(*this);
+
+    updateCollisionFilter();
 }
 
 MCPhysicsComponent & MCObject::physicsComponent()
@@ -714,5 +850,18 @@ MCObject::~MCObject()
 {
     removeFromWorldNow();
     deleteContacts();
+
+    if (m_eventHandlerMask)
+    {
+        MCEventQueueBase::unsubscribeAll(*this);
+    }
+
+    if (m_childTransformsDirty)
+    {
+        m_dirtyTransformObjects.erase(
+            std::remove(m_dirtyTransformObjects.begin(), m_dirtyTransformObjects.end(), this),
+            m_dirtyTransformObjects.end());
+    }
+
     delete m_physicsComponent;
 }
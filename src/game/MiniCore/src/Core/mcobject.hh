@@ -21,6 +21,7 @@
 #define MCOBJECT_HH
 
 #include "mcbbox.hh"
+#include "mccollisionfilter.hh"
 #include "mccontact.hh"
 #include "mcmacros.hh"
 #include "mcobjectgrid.hh"
@@ -42,6 +43,7 @@ class MCCollisionEvent;
 class MCOutOfBoundariesEvent;
 class MCPhysicsComponent;
 class MCTimerEvent;
+class MCTriggerEvent;
 class MCCamera;
 
 typedef std::shared_ptr<MCObject> MCObjectPtr;
@@ -116,6 +118,28 @@ public:
      *  have subscribed to timer events. */
     static void sendTimerEvent(MCTimerEvent & event);
 
+    /*! Subscribe the given object to collision events. Only subscribed objects
+     *  receive collisionEvent(). The events are queued during the world step
+     *  and delivered after it. */
+    static void subscribeCollisionEvent(MCObject & object);
+
+    //! Unsubscribe the given object from collision events.
+    static void unsubscribeCollisionEvent(MCObject & object);
+
+    /*! Subscribe the given trigger object to trigger events. Only subscribed objects
+     *  receive triggerEvent(). The events are queued during the world step
+     *  and delivered after it. */
+    static void subscribeTriggerEvent(MCObject & object);
+
+    //! Unsubscribe the given object from trigger events.
+    static void unsubscribeTriggerEvent(MCObject & object);
+
+    //! \return true if the object has a handler in the MCEventQueue of the given event type.
+    bool hasEventHandler(unsigned int eventTypeId) const;
+
+    //! Used by MCEventQueue to mark the object as having a handler.
+    void setHasEventHandler(unsigned int eventTypeId, bool hasHandler);
+
     /*! Render the object.
      *  \param p Camera window to be used. */
     virtual void render(MCCamera * p = nullptr);
@@ -185,7 +209,8 @@ public:
     //! Return true if the object is a particle.
     bool isParticle() const;
 
-    /*! Set location
+    /*! Set location. The child objects are moved when the transforms
+     *  are resolved by resolveChildTransforms().
      *  \param newLocation The new location. */
     void translate(const MCVector3dF & newLocation);
 
@@ -207,10 +232,16 @@ public:
     //! Return parent-relative location
     const MCVector3dF & relativeLocation() const;
 
-    /*! Set rotation ("yaw") angle about Z-axis.
+    /*! Set rotation ("yaw") angle about Z-axis. The child objects are rotated when
+     *  the transforms are resolved by resolveChildTransforms().
      *  \param newAngle The new angle in degrees [0..360]. */
     void rotate(float newAngle, bool updateChildTransforms = true);
 
+    /*! Update the locations and angles of the children of all objects that have been
+     *  moved or rotated since the previous call. Each subtree is updated once, top-down.
+     *  MCWorld calls this during the step and before rendering. */
+    static void resolveChildTransforms();
+
     //! Set object's center in local coordinates i.e. (0, 0) is the default original center.
     void setCenter(MCVector2dF center);
 
@@ -223,8 +254,8 @@ public:
     //! Set shape.
     void setShape(MCShapePtr shape);
 
-    //! Get shape.
-    MCShapePtr shape() const;
+    //! Get shape. The returned reference doesn't share ownership.
+    const MCShapePtr & shape() const;
 
     /*! \brief Step internal time.
      *  This is called AFTER every update step. Note that you might need to prevent
@@ -235,12 +266,24 @@ public:
 
     /*! Set collision layer. Only objects on the same layer can collide.
      * -1 will collide with all layers. The default is 0.
-     * \param layer The new layer. */
+     * \param layer The new layer, -1..MCCollisionFilter::MAX_LAYERS - 1. */
     void setCollisionLayer(int layer);
 
     //! Return the collision layer.
     int collisionLayer() const;
 
+    /*! Set collision group. Objects sharing a positive group always collide and objects
+     *  sharing a negative group never collide regardless of the layers and tags. The default is 0.
+     *  \param group The new group. */
+    void setCollisionGroup(int group);
+
+    //! Return the collision group.
+    int collisionGroup() const;
+
+    /*! Return the collision filter combining the layer, the tags, the group and
+     *  the physics, trigger and bypass flags. */
+    const MCCollisionFilter & collisionFilter() const;
+
     //! Add a collision contact.
     void addContact(MCContact & contact);
 
@@ -299,12 +342,16 @@ protected:
      *  \return true if event was handled. */
     virtual bool event(MCEvent & event);
 
-    /*! Event handler for MCCollisionEvent. Override this to
-     *  filter out collisions with certain objects.
-     *  All collisions are accepted by default.
+    /*! Event handler for MCCollisionEvent. Called after the world step
+     *  if the object has subscribed via subscribeCollisionEvent().
      *  \param event Event to be handled. */
     virtual void collisionEvent(MCCollisionEvent & event);
 
+    /*! Event handler for MCTriggerEvent. Called after the world step
+     *  if the trigger object has subscribed via subscribeTriggerEvent().
+     *  \param event Event to be handled. */
+    virtual void triggerEvent(MCTriggerEvent & event);
+
     /*! Event handler for MCOutOfBoundariesEvent.
      *  \param event Event to be handled. */
     virtual void outOfBoundariesEvent(MCOutOfBoundariesEvent & event);
@@ -349,12 +396,16 @@ private:
 
     void updateChildTransforms();
 
+    void markChildTransformsDirty();
+
     void updateCenter();
 
     void setStatus(int bit, bool flag);
 
     bool testStatus(int bit) const;
 
+    void updateCollisionFilter();
+
     static MCTypeRegistry m_typeRegistry;
 
     unsigned int m_typeId;
@@ -367,6 +418,10 @@ private:
 
     int m_collisionLayer = 0;
 
+    int m_collisionGroup = 0;
+
+    MCCollisionFilter m_collisionFilter;
+
     int m_index = -1;
 
     unsigned int m_i0 = 0;
@@ -401,6 +456,14 @@ private:
 
     int m_timerEventObjectsIndex = -1;
 
+    unsigned int m_eventHandlerMask = 0;
+
+    typedef std::vector<MCObject *> DirtyTransformObjectsList;
+
+    static DirtyTransformObjectsList m_dirtyTransformObjects;
+
+    bool m_childTransformsDirty = false;
+
     int m_status;
 
     Children m_children;
@@ -417,6 +480,7 @@ private:
     friend class MCObjectGridImpl;
     friend class MCWorld;
     friend class MCCollisionDetector;
+    friend class MCPhysicsComponent;
 };
 
 #endif // MCOBJECT_HH
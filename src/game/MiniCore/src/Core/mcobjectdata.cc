@@ -81,6 +81,13 @@ float MCObjectData::shapeHeight() const
     return m_shapeHeight;
 }
 
+void MCObjectData::setShapeCapsule(float length, float capRadius)
+{
+    m_shape       = MCObjectData::Capsule;
+    m_shapeWidth  = length;
+    m_shapeRadius = capRadius;
+}
+
 MCObjectData::Shape MCObjectData::shape() const
 {
     return m_shape;
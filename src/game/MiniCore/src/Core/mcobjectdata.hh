@@ -37,9 +37,10 @@ class MCObjectData
 public:
 
     /*! Possible shape types:
-     *  Rect   = MCRectShape.
-     *  Circle = MCCircleShape. */
-    enum Shape {Default, Rect, Circle};
+     *  Rect    = MCRectShape.
+     *  Circle  = MCCircleShape.
+     *  Capsule = MCCapsuleShape. */
+    enum Shape {Default, Rect, Circle, Capsule};
 
     //! Constructor.
     explicit MCObjectData(const std::string & typeId);
@@ -74,6 +75,10 @@ public:
     //! Return shape height.
     float shapeHeight() const;
 
+    /*! Select capsule shape along the x-axis.
+     *  Length is returned by shapeWidth() and cap radius by shapeRadius(). */
+    void setShapeCapsule(float length, float capRadius);
+
     //! Return shape type.
     Shape shape() const;
 
@@ -20,6 +20,7 @@
 #include "mcobjectfactory.hh"
 
 #include "mcassetmanager.hh"
+#include "mccapsuleshape.hh"
 #include "mccircleshape.hh"
 #include "mcmeshview.hh"
 #include "mcphysicscomponent.hh"
@@ -78,6 +79,14 @@ MCObjectPtr MCObjectFactory::build(const MCSurfaceObjectData & data)
         shape.reset(new MCRectShape(view, data.shapeWidth(), data.shapeHeight()));
         object->setShape(shape);
         break;
+
+    // Explicit capsule shape
+    case MCObjectData::Capsule:
+        object = new MCObject(data.typeId());
+        view.reset(new MCSurfaceView(data.typeId(), &surface));
+        shape.reset(new MCCapsuleShape(view, data.shapeWidth(), data.shapeRadius()));
+        object->setShape(shape);
+        break;
     }
 
     assert(object);
@@ -130,6 +139,14 @@ MCObjectPtr MCObjectFactory::build(const MCMeshObjectData & data)
         shape.reset(new MCRectShape(view, data.shapeWidth(), data.shapeHeight()));
         object->setShape(shape);
         break;
+
+    // Explicit capsule shape
+    case MCObjectData::Capsule:
+        object = new MCObject(data.typeId());
+        view.reset(new MCMeshView(data.typeId(), &mesh));
+        shape.reset(new MCCapsuleShape(view, data.shapeWidth(), data.shapeRadius()));
+        object->setShape(shape);
+        break;
     }
 
     assert(object);
@@ -163,6 +180,13 @@ MCObjectPtr MCObjectFactory::build(const MCObjectData & data, MCShapeViewPtr vie
         shape.reset(new MCRectShape(view, data.shapeWidth(), data.shapeHeight()));
         object->setShape(shape);
         break;
+
+    // Explicit capsule shape
+    case MCObjectData::Capsule:
+        object = new MCObject(data.typeId());
+        shape.reset(new MCCapsuleShape(view, data.shapeWidth(), data.shapeRadius()));
+        object->setShape(shape);
+        break;
     }
 
     assert(object);
@@ -22,10 +22,12 @@
 #include "mcbbox.hh"
 #include "mccamera.hh"
 #include "mccollisiondetector.hh"
+#include "mceventqueuebase.hh"
 #include "mcforcegenerator.hh"
 #include "mcforceregistry.hh"
 #include "mcfrictiongenerator.hh"
 #include "mcimpulsegenerator.hh"
+#include "mclogger.hh"
 #include "mcmathutil.hh"
 #include "mcobject.hh"
 #include "mcobjectgrid.hh"
@@ -33,6 +35,8 @@
 #include "mcphysicscomponent.hh"
 #include "mcshape.hh"
 #include "mcshapeview.hh"
+#include "mcstaticbroadphase.hh"
+#include "mctriggersystem.hh"
 #include "mcrectshape.hh"
 #include "mctrigonom.hh"
 #include "mcworldrenderer.hh"
@@ -53,6 +57,8 @@ MCWorld::MCWorld()
 , m_collisionDetector(new MCCollisionDetector)
 , m_impulseGenerator(new MCImpulseGenerator)
 , m_objectGrid(nullptr)
+, m_staticBroadphase(new MCStaticBroadphase)
+, m_triggerSystem(new MCTriggerSystem)
 , m_minX(0)
 , m_maxX(0)
 , m_minY(0)
@@ -64,6 +70,9 @@ MCWorld::MCWorld()
 , m_topWallObject(nullptr)
 , m_bottomWallObject(nullptr)
 , m_numCollisions(0)
+, m_dynamicPairCount(0)
+, m_staticPairCount(0)
+, m_resolverIterationCount(0)
 , m_resolverLoopCount(5)
 , m_resolverStep(1.0 / m_resolverLoopCount)
 , m_gravity(MCVector3dF(0, 0, -9.81))
@@ -91,6 +100,8 @@ MCWorld::~MCWorld()
     delete m_collisionDetector;
     delete m_impulseGenerator;
     delete m_objectGrid;
+    delete m_staticBroadphase;
+    delete m_triggerSystem;
 
     MCWorld::m_instance = nullptr;
 
@@ -110,15 +121,36 @@ void MCWorld::integrate(int step)
         {
             object->physicsComponent().stepTime(step);
         }
+    }
+
+    // Move the children with their integrated parents before they are updated
+    MCObject::resolveChildTransforms();
 
+    for (auto && object : m_objs)
+    {
         object->onStepTime(step);
     }
 }
 
-void MCWorld::detectCollisions()
+void MCWorld::detectCollisions(bool countPairs)
 {
+    MCObject::resolveChildTransforms();
+
     // Check collisions for all registered objects
-    m_numCollisions = m_collisionDetector->detectCollisions(*m_objectGrid);
+    const auto & dynamicCollisions = m_objectGrid->getPossibleCollisions();
+    m_numCollisions = m_collisionDetector->detectCollisions(dynamicCollisions);
+
+    // Check the moving objects against the static colliders
+    m_staticCollisions.clear();
+    const int staticPairs = m_staticBroadphase->getPossibleCollisions(m_objs, m_staticCollisions);
+    m_numCollisions += m_collisionDetector->detectCollisions(m_staticCollisions);
+
+    if (countPairs)
+    {
+        // Both orderings of a pair are listed
+        m_dynamicPairCount = static_cast<int>(dynamicCollisions.size() / 2);
+        m_staticPairCount = staticPairs;
+    }
 }
 
 void MCWorld::generateImpulses()
@@ -133,9 +165,18 @@ void MCWorld::resolvePositions(float accuracy)
 
 void MCWorld::prepareRendering(MCCamera * camera)
 {
+    MCObject::resolveChildTransforms();
+
     m_renderer->buildBatches(camera);
 }
 
+void MCWorld::prepareRenderingAsync(const std::vector<MCCamera *> & cameras)
+{
+    MCObject::resolveChildTransforms();
+
+    m_renderer->buildBatchesAsync(cameras);
+}
+
 void MCWorld::render(MCCamera * camera, MCRenderGroup renderGroup)
 {
     m_renderer->render(camera, renderGroup);
@@ -176,6 +217,8 @@ void MCWorld::clear()
 
     m_renderer->clear();
     m_objectGrid->removeAll();
+    m_staticBroadphase->clear();
+    m_triggerSystem->clear();
     m_objs.clear();
     m_removeObjs.clear();
 }
@@ -316,7 +359,15 @@ void MCWorld::addObject(MCObject & object)
             m_objs.push_back(&object);
             object.setIndex(static_cast<int>(m_objs.size()) - 1);
 
-            m_objectGrid->insert(object);
+            // Triggers only produce trigger events and never take part in the collision resolution
+            if (object.isTriggerObject() && !object.isPhysicsObject())
+            {
+                m_triggerSystem->addTrigger(object);
+            }
+            else
+            {
+                m_objectGrid->insert(object);
+            }
 
             // Add xy friction
             const float FrictionThreshold = 0.001f;
@@ -377,8 +428,11 @@ void MCWorld::doRemoveObject(MCObject & object)
     if (object.isPhysicsObject() && !object.bypassCollisions())
     {
         m_objectGrid->remove(object);
+        m_staticBroadphase->remove(object);
     }
 
+    m_triggerSystem->removeObject(object);
+
     object.setRemoving(false);
 }
 
@@ -404,6 +458,27 @@ void MCWorld::restoreObjectToIntegration(MCObject & object)
     }
 }
 
+void MCWorld::buildStaticBroadphase()
+{
+    // The shapes must be at their final locations before binning
+    MCObject::resolveChildTransforms();
+
+    for (MCObject * object : m_objs)
+    {
+        // Children follow their parents, so only top-level objects can be static
+        if (object->physicsComponent().isStationary() && object->isPhysicsObject() &&
+            !object->isTriggerObject() && !object->bypassCollisions() && object->shape() &&
+            &object->parent() == object && m_objectGrid->remove(*object))
+        {
+            m_staticBroadphase->add(*object);
+        }
+    }
+
+    m_staticBroadphase->build(MCBBox<float>(m_minX, m_minY, m_maxX, m_maxY));
+
+    MCLogger().info() << "Static broadphase: " << m_staticBroadphase->colliderCount() << " colliders.";
+}
+
 void MCWorld::processRemovedObjects()
 {
     for (MCObject * obj : m_removeObjs)
@@ -419,8 +494,9 @@ void MCWorld::processRemovedObjects()
 
 void MCWorld::processCollisions()
 {
-    detectCollisions();
+    detectCollisions(true);
 
+    m_resolverIterationCount = 0;
     if (m_numCollisions)
     {
         generateImpulses();
@@ -431,6 +507,7 @@ void MCWorld::processCollisions()
         {
             detectCollisions();
             resolvePositions(m_resolverStep);
+            m_resolverIterationCount++;
         }
         m_collisionDetector->enablePrimaryCollisionEvents(true);
     }
@@ -447,11 +524,20 @@ void MCWorld::stepTime(int step)
     // Integrate physics
     integrate(step);
 
+    // Check the triggers once against the integrated locations
+    m_triggerSystem->update(m_objs);
+
     // Process collisions and generate impulses
     processCollisions();
 
+    // Deliver the events queued during the step, e.g. collision events
+    MCEventQueueBase::dispatchAll();
+
     // Remove objects that are marked to be removed
     processRemovedObjects();
+
+    // Leave the children at their final locations for the game logic
+    MCObject::resolveChildTransforms();
 }
 
 MCWorld::ObjectVector MCWorld::objects() const
@@ -465,6 +551,18 @@ MCObjectGrid & MCWorld::objectGrid() const
     return *m_objectGrid;
 }
 
+MCStaticBroadphase & MCWorld::staticBroadphase() const
+{
+    assert(m_staticBroadphase);
+    return *m_staticBroadphase;
+}
+
+MCTriggerSystem & MCWorld::triggerSystem() const
+{
+    assert(m_triggerSystem);
+    return *m_triggerSystem;
+}
+
 MCWorldRenderer & MCWorld::renderer() const
 {
     assert(m_renderer);
@@ -513,3 +611,18 @@ void MCWorld::setResolverLoopCount(unsigned int resolverLoopCount)
     m_resolverLoopCount = resolverLoopCount;
     m_resolverStep = 1.0f / resolverLoopCount;
 }
+
+int MCWorld::dynamicPairCount() const
+{
+    return m_dynamicPairCount;
+}
+
+int MCWorld::staticPairCount() const
+{
+    return m_staticPairCount;
+}
+
+int MCWorld::resolverIterationCount() const
+{
+    return m_resolverIterationCount;
+}
@@ -25,6 +25,7 @@
 #include "mcvector3d.hh"
 #include "mcrendergroup.hh"
 
+#include <utility>
 #include <vector>
 
 class MCCamera;
@@ -34,6 +35,8 @@ class MCForceRegistry;
 class MCImpulseGenerator;
 class MCObject;
 class MCObjectGrid;
+class MCStaticBroadphase;
+class MCTriggerSystem;
 class MCWorldRenderer;
 
 /*! \class World base class.
@@ -111,6 +114,7 @@ public:
     static void toMeters(MCVector3dF & units);
 
     /*! Add object to the world. Object's current location is used.
+     *  Trigger objects go to the trigger system instead of the object grid.
      *  \param object Object to be added. */
     void addObject(MCObject & object);
 
@@ -132,6 +136,11 @@ public:
     //! Restart integrating the given object.
     void restoreObjectToIntegration(MCObject & object);
 
+    /*! Move the stationary colliders that are currently in the world from the object grid
+     *  into the static broadphase. Call this once after the static objects have been added
+     *  and placed, e.g. after loading a level. The moved objects must not be translated anymore. */
+    void buildStaticBroadphase();
+
     //! \return Force registry. Use this to add force generators to objects.
     MCForceRegistry & forceRegistry() const;
 
@@ -145,6 +154,11 @@ public:
      *         no any translations or clipping done. */
     virtual void prepareRendering(MCCamera * camera);
 
+    /*! \brief Like prepareRendering(), but the batches of the given cameras
+     *  are built on a worker thread. The world must not be changed until
+     *  render() has been called, which waits for the batches. */
+    void prepareRenderingAsync(const std::vector<MCCamera *> & cameras);
+
     /*! \brief Render given component.
      *  \param camera Camera box, can be nullptr. */
     virtual void render(MCCamera * camera, MCRenderGroup renderGroup);
@@ -152,6 +166,12 @@ public:
     //! \return Reference to the objectGrid.
     MCObjectGrid & objectGrid() const;
 
+    //! \return Reference to the static broadphase.
+    MCStaticBroadphase & staticBroadphase() const;
+
+    //! \return Reference to the trigger system.
+    MCTriggerSystem & triggerSystem() const;
+
     //! \return The world renderer.
     MCWorldRenderer & renderer() const;
 
@@ -180,6 +200,15 @@ public:
      *  Lower loop count results in faster collision calculations, but lower accuracy. */
     void setResolverLoopCount(unsigned int resolverLoopCount = 5);
 
+    //! \return number of possible collisions between moving objects found on the latest step.
+    int dynamicPairCount() const;
+
+    //! \return number of possible collisions between moving objects and static colliders found on the latest step.
+    int staticPairCount() const;
+
+    //! \return number of position resolver iterations run on the latest step. \see setResolverLoopCount().
+    int resolverIterationCount() const;
+
 protected:
 
     //! Get registered objects
@@ -198,7 +227,7 @@ private:
 
     void doRemoveObject(MCObject & object);
 
-    void detectCollisions();
+    void detectCollisions(bool countPairs = false);
 
     void generateImpulses();
 
@@ -218,6 +247,12 @@ private:
 
     MCObjectGrid * m_objectGrid;
 
+    MCStaticBroadphase * m_staticBroadphase;
+
+    MCTriggerSystem * m_triggerSystem;
+
+    std::vector<std::pair<MCObject *, MCObject *> > m_staticCollisions;
+
     static float m_metersPerUnit;
 
     static float m_metersPerUnitSquared;
@@ -238,6 +273,12 @@ private:
 
     unsigned int m_numCollisions;
 
+    int m_dynamicPairCount;
+
+    int m_staticPairCount;
+
+    int m_resolverIterationCount;
+
     unsigned int m_resolverLoopCount;
 
     float m_resolverStep;
@@ -0,0 +1,90 @@
+// This file belongs to the "MiniCore" game engine.
+// Copyright (C) 2018 Jussi Lind <jussi.lind@iki.fi>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+// MA  02110-1301, USA.
+//
+#include "mcdepthsorter.hh"
+#include "mcobject.hh"
+
+#include <cstring>
+
+namespace {
+const int RADIX_BITS = 8;
+const int RADIX_SIZE = 1 << RADIX_BITS;
+const int NUM_PASSES = 32 / RADIX_BITS;
+}
+
+uint32_t MCDepthSorter::key(float z)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &z, sizeof(bits));
+
+    // Flip all bits of negative numbers and only the sign bit of positive
+    // numbers so that the unsigned keys order like the floats.
+    return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+}
+
+void MCDepthSorter::sort(std::vector<MCObject *> & objects)
+{
+    if (objects.size() < 2)
+    {
+        return;
+    }
+
+    m_keys.resize(objects.size());
+    m_scratch.resize(objects.size());
+    for (size_t i = 0; i < objects.size(); i++)
+    {
+        m_keys[i] = KeyedObject(key(objects[i]->location().k()), objects[i]);
+    }
+
+    for (int pass = 0; pass < NUM_PASSES; pass++)
+    {
+        const int shift = pass * RADIX_BITS;
+
+        size_t counts[RADIX_SIZE] = {};
+        for (auto && keyedObject : m_keys)
+        {
+            counts[(keyedObject.first >> shift) & (RADIX_SIZE - 1)]++;
+        }
+
+        // All keys share the digit
+        if (counts[(m_keys[0].first >> shift) & (RADIX_SIZE - 1)] == m_keys.size())
+        {
+            continue;
+        }
+
+        size_t offset = 0;
+        for (auto && count : counts)
+        {
+            const size_t digitCount = count;
+            count = offset;
+            offset += digitCount;
+        }
+
+        for (auto && keyedObject : m_keys)
+        {
+            m_scratch[counts[(keyedObject.first >> shift) & (RADIX_SIZE - 1)]++] = keyedObject;
+        }
+
+        m_keys.swap(m_scratch);
+    }
+
+    for (size_t i = 0; i < objects.size(); i++)
+    {
+        objects[i] = m_keys[i].second;
+    }
+}
@@ -0,0 +1,52 @@
+// This file belongs to the "MiniCore" game engine.
+// Copyright (C) 2018 Jussi Lind <jussi.lind@iki.fi>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+// MA  02110-1301, USA.
+//
+#ifndef MCDEPTHSORTER_HH
+#define MCDEPTHSORTER_HH
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+class MCObject;
+
+/*! Sorts objects by the Z-coordinate of their location with a stable LSD
+ *  radix sort. The buffers are kept between the calls, so sorting a batch
+ *  doesn't allocate once the buffers have grown to the batch size. Passes
+ *  where all the keys share the same digit are skipped, which makes the
+ *  common case of particles on a few depth levels cheap. */
+class MCDepthSorter
+{
+public:
+
+    //! Sort the objects by ascending Z. The order of objects with the same Z is kept.
+    void sort(std::vector<MCObject *> & objects);
+
+    //! \return radix sort key that orders like the given float.
+    static uint32_t key(float z);
+
+private:
+
+    typedef std::pair<uint32_t, MCObject *> KeyedObject;
+
+    std::vector<KeyedObject> m_keys;
+
+    std::vector<KeyedObject> m_scratch;
+};
+
+#endif // MCDEPTHSORTER_HH
@@ -20,6 +20,13 @@
 #include "mcglmaterial.hh"
 #include <cassert>
 
+#ifdef __MC_QOPENGLFUNCTIONS__
+#include <QOpenGLContext>
+#include <QOpenGLFunctions>
+#endif
+
+bool MCGLMaterial::m_premultipliedTarget = false;
+
 MCGLMaterial::MCGLMaterial()
     : m_specularCoeff(1.0)
     , m_diffuseCoeff(1.0)
@@ -77,7 +84,19 @@ void MCGLMaterial::doAlphaBlend()
     if (m_useAlphaBlend)
     {
         glEnable(GL_BLEND);
-        glBlendFunc(m_src, m_dst);
+
+        if (m_premultipliedTarget)
+        {
+#ifdef __MC_QOPENGLFUNCTIONS__
+            QOpenGLContext::currentContext()->functions()->glBlendFuncSeparate(m_src, m_dst, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+#else
+            glBlendFuncSeparate(m_src, m_dst, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+#endif
+        }
+        else
+        {
+            glBlendFunc(m_src, m_dst);
+        }
     }
     else
     {
@@ -85,3 +104,7 @@ void MCGLMaterial::doAlphaBlend()
     }
 }
 
+void MCGLMaterial::setPremultipliedTarget(bool premultipliedTarget)
+{
+    m_premultipliedTarget = premultipliedTarget;
+}
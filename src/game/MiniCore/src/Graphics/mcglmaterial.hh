@@ -63,8 +63,16 @@ public:
      *  handle and wants to run the configured alpha blending. */
     void doAlphaBlend();
 
+    /*! Blend alpha with GL_ONE, GL_ONE_MINUS_SRC_ALPHA regardless of the configured
+     *  functions while enabled. This should be enabled when rendering into a cleared,
+     *  transparent texture: the texture then ends up with correct coverage in alpha
+     *  and colors premultiplied by it, ready to be composited with GL_ONE, GL_ONE_MINUS_SRC_ALPHA. */
+    static void setPremultipliedTarget(bool premultipliedTarget);
+
 private:
 
+    static bool m_premultipliedTarget;
+
     GLuint m_textures[MAX_TEXTURES];
 
     GLfloat m_specularCoeff;
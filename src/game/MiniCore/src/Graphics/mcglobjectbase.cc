@@ -28,6 +28,8 @@
 
 GLuint MCGLObjectBase::m_boundVbo = 0;
 
+int MCGLObjectBase::m_drawCallCount = 0;
+
 MCGLObjectBase::MCGLObjectBase(std::string handle)
     : m_handle(handle)
     , m_program(MCGLScene::instance().defaultShaderProgram())
@@ -124,7 +126,14 @@ void MCGLObjectBase::createVBO()
 
 void MCGLObjectBase::render()
 {
-    glDrawArrays(GL_TRIANGLES, 0, m_vertices.size());
+    drawArrays(GL_TRIANGLES, m_vertices.size());
+}
+
+void MCGLObjectBase::drawArrays(GLenum mode, GLsizei count)
+{
+    glDrawArrays(mode, 0, count);
+
+    m_drawCallCount++;
 }
 
 void MCGLObjectBase::render(MCCamera * camera, MCVector3dFR pos, float angle)
@@ -423,6 +432,16 @@ void MCGLObjectBase::setHandle(const std::string & handle)
     m_handle = handle;
 }
 
+int MCGLObjectBase::drawCallCount()
+{
+    return m_drawCallCount;
+}
+
+void MCGLObjectBase::resetDrawCallCount()
+{
+    m_drawCallCount = 0;
+}
+
 float MCGLObjectBase::width() const
 {
     return m_width * m_scale.i();
@@ -169,6 +169,12 @@ public:
 
     void setHandle(const std::string & handle);
 
+    //! \return number of draw calls issued via drawArrays() since the last reset.
+    static int drawCallCount();
+
+    //! Reset the draw call count, e.g. at the beginning of a frame.
+    static void resetDrawCallCount();
+
 
 protected:
 
@@ -218,6 +224,10 @@ protected:
 
     virtual void setAttributePointers();
 
+    //! Call glDrawArrays() starting from the first vertex and count the draw call.
+    //! Subclasses should draw only through this so that drawCallCount() stays valid.
+    void drawArrays(GLenum mode, GLsizei count);
+
     void enableAttributePointers();
 
     void disableAttributePointers();
@@ -226,6 +236,8 @@ private:
 
     static GLuint m_boundVbo;
 
+    static int m_drawCallCount;
+
     std::string m_handle;
 
 #ifdef __MC_QOPENGLFUNCTIONS__
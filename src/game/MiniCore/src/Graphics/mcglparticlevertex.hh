@@ -0,0 +1,65 @@
+// This file belongs to the "MiniCore" game engine.
+// Copyright (C) 2018 Jussi Lind <jussi.lind@iki.fi>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+// MA  02110-1301, USA.
+//
+#ifndef MCGLPARTICLEVERTEX_HH
+#define MCGLPARTICLEVERTEX_HH
+
+#include <MCGLEW>
+
+#include "mcglcolor.hh"
+
+#include <algorithm>
+
+/*! Compact interleaved vertex of a particle batch. Every corner of a particle
+ *  quad gets the same vertex and the particle vertex shader expands the quad
+ *  from the static corner coordinates. The color is packed into bytes. */
+struct MCGLParticleVertex
+{
+    MCGLParticleVertex()
+    {
+    }
+
+    MCGLParticleVertex(GLfloat x, GLfloat y, GLfloat z, GLfloat size, GLfloat angle, const MCGLColor & color)
+        : x(x)
+        , y(y)
+        , z(z)
+        , size(size)
+        , angle(angle)
+        , r(toByte(color.r()))
+        , g(toByte(color.g()))
+        , b(toByte(color.b()))
+        , a(toByte(color.a()))
+    {
+    }
+
+    static GLubyte toByte(GLfloat value)
+    {
+        return static_cast<GLubyte>(std::min(std::max(value, 0.0f), 1.0f) * 255.0f + 0.5f);
+    }
+
+    GLfloat x = 0, y = 0, z = 0;
+
+    GLfloat size = 0;
+
+    //! Angle in degrees.
+    GLfloat angle = 0;
+
+    GLubyte r = 0, g = 0, b = 0, a = 0;
+};
+
+#endif // MCGLPARTICLEVERTEX_HH
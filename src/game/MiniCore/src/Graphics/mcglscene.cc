@@ -95,6 +95,18 @@ MCGLShaderProgramPtr MCGLScene::defaultShadowShaderProgram()
     return m_defaultShadowShader;
 }
 
+MCGLShaderProgramPtr MCGLScene::defaultParticleShaderProgram()
+{
+    assert(m_defaultParticleShader.get());
+    return m_defaultParticleShader;
+}
+
+MCGLShaderProgramPtr MCGLScene::defaultParticleShadowShaderProgram()
+{
+    assert(m_defaultParticleShadowShader.get());
+    return m_defaultParticleShadowShader;
+}
+
 MCGLShaderProgramPtr MCGLScene::defaultTextShaderProgram()
 {
     assert(m_defaultTextShader.get());
@@ -151,6 +163,12 @@ void MCGLScene::createDefaultShaderPrograms()
     m_defaultShadowShader.reset(new MCGLShaderProgram(
         MCGLShaderProgram::getDefaultShadowVertexShaderSource(), MCGLShaderProgram::getDefaultShadowFragmentShaderSource()));
 
+    m_defaultParticleShader.reset(new MCGLShaderProgram(
+        MCGLShaderProgram::getDefaultParticleVertexShaderSource(), MCGLShaderProgram::getDefaultFragmentShaderSource()));
+
+    m_defaultParticleShadowShader.reset(new MCGLShaderProgram(
+        MCGLShaderProgram::getDefaultParticleShadowVertexShaderSource(), MCGLShaderProgram::getDefaultShadowFragmentShaderSource()));
+
     m_defaultTextShader.reset(new MCGLShaderProgram(
         MCGLShaderProgram::getDefaultTextVertexShaderSource(), MCGLShaderProgram::getDefaultTextFragmentShaderSource()));
 
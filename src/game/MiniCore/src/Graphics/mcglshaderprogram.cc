@@ -259,6 +259,16 @@ const char * MCGLShaderProgram::getDefaultShadowFragmentShaderSource()
     return MCDefaultShadowFsh;
 }
 
+const char * MCGLShaderProgram::getDefaultParticleVertexShaderSource()
+{
+    return MCDefaultParticleVsh;
+}
+
+const char * MCGLShaderProgram::getDefaultParticleShadowVertexShaderSource()
+{
+    return MCDefaultParticleShadowVsh;
+}
+
 const char * MCGLShaderProgram::getDefaultTextVertexShaderSource()
 {
     return MCDefaultTextVsh;
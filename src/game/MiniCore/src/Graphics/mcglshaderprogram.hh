@@ -112,6 +112,13 @@ public:
     /*! Get the default shadow fragment shader source. Defining __MC_GLES__ will select GLES version. */
     static const char * getDefaultShadowFragmentShaderSource();
 
+    /*! Get the default particle vertex shader source. The shader expands particle
+     *  centers to quads. Defining __MC_GLES__ will select GLES version. */
+    static const char * getDefaultParticleVertexShaderSource();
+
+    /*! Get the default particle shadow vertex shader source. Defining __MC_GLES__ will select GLES version. */
+    static const char * getDefaultParticleShadowVertexShaderSource();
+
     /*! Get the default text vertex shader source. Defining __MC_GLES__ will select GLES version. */
     static const char * getDefaultTextVertexShaderSource();
 
@@ -0,0 +1,100 @@
+// This file belongs to the "MiniCore" game engine.
+// Copyright (C) 2018 Jussi Lind <jussi.lind@iki.fi>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+// MA  02110-1301, USA.
+//
+#include "mcobjectbatchtable.hh"
+
+#include <algorithm>
+
+namespace {
+bool byPriority(const MCObjectBatchTable::Batch & l, const MCObjectBatchTable::Batch & r)
+{
+    return l.priority < r.priority;
+}
+}
+
+void MCObjectBatchTable::clear()
+{
+    // Priorities are kept so that the empty batches don't cause re-sorting.
+    for (Batch & batch : m_batches)
+    {
+        batch.objects.clear();
+    }
+}
+
+MCObjectBatchTable::Batch & MCObjectBatchTable::add(int objectViewId, MCObject & object, float priority)
+{
+    auto iter = m_indices.find(objectViewId);
+    if (iter == m_indices.end())
+    {
+        m_indices[objectViewId] = m_batches.size();
+        m_batches.push_back(Batch());
+        m_batches.back().objectViewId = objectViewId;
+        m_batches.back().priority = priority;
+        m_batches.back().objects.push_back(&object);
+        return m_batches.back();
+    }
+
+    Batch & batch = m_batches[iter->second];
+    batch.priority = batch.objects.empty() ? priority : std::max(priority, batch.priority);
+    batch.objects.push_back(&object);
+    return batch;
+}
+
+bool MCObjectBatchTable::sort()
+{
+    if (std::is_sorted(m_batches.begin(), m_batches.end(), byPriority))
+    {
+        return false;
+    }
+
+    std::stable_sort(m_batches.begin(), m_batches.end(), byPriority);
+
+    for (size_t i = 0; i < m_batches.size(); i++)
+    {
+        m_indices[m_batches[i].objectViewId] = i;
+    }
+
+    return true;
+}
+
+void MCObjectBatchTable::reset()
+{
+    m_batches.clear();
+    m_indices.clear();
+}
+
+size_t MCObjectBatchTable::size() const
+{
+    return m_batches.size();
+}
+
+MCObjectBatchTable::Batch * MCObjectBatchTable::batch(int objectViewId)
+{
+    auto iter = m_indices.find(objectViewId);
+    return iter != m_indices.end() ? &m_batches[iter->second] : nullptr;
+}
+
+MCObjectBatchTable::BatchVector::iterator MCObjectBatchTable::begin()
+{
+    return m_batches.begin();
+}
+
+MCObjectBatchTable::BatchVector::iterator MCObjectBatchTable::end()
+{
+    return m_batches.end();
+}
@@ -0,0 +1,82 @@
+// This file belongs to the "MiniCore" game engine.
+// Copyright (C) 2018 Jussi Lind <jussi.lind@iki.fi>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+// MA  02110-1301, USA.
+//
+#ifndef MCOBJECTBATCHTABLE_HH
+#define MCOBJECTBATCHTABLE_HH
+
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+class MCObject;
+
+/*! Groups objects into batches by view id. The table is meant to be kept
+ *  from frame to frame: clear() only empties the batches, so the batches and
+ *  their capacities are reused, a batch is found in O(1) by its view id, and
+ *  the batches are re-sorted only when their priorities have changed order. */
+class MCObjectBatchTable
+{
+public:
+
+    struct Batch
+    {
+        int objectViewId = -1;
+        float priority = 0;
+
+        /*! True if the objects are plain surface views that can be transformed
+         *  on CPU and drawn with a single draw call. Set by the batch builder. */
+        bool isCpuBatchable = false;
+
+        std::vector<MCObject *> objects;
+    };
+
+    typedef std::vector<Batch> BatchVector;
+
+    //! Empty the batches but keep them for the next frame.
+    void clear();
+
+    /*! Add the object to the batch of the given view id. The priority of the
+     *  batch is the highest priority of its objects.
+     *  \return the batch. The reference is valid until the next call to add(). */
+    Batch & add(int objectViewId, MCObject & object, float priority);
+
+    /*! Order the batches by ascending priority.
+     *  \return true if the batches needed to be re-sorted. */
+    bool sort();
+
+    //! Remove all batches.
+    void reset();
+
+    //! \return number of batches including the empty ones.
+    size_t size() const;
+
+    //! \return the batch of the given view id or nullptr.
+    Batch * batch(int objectViewId);
+
+    BatchVector::iterator begin();
+
+    BatchVector::iterator end();
+
+private:
+
+    BatchVector m_batches;
+
+    std::unordered_map<int, size_t> m_indices;
+};
+
+#endif // MCOBJECTBATCHTABLE_HH
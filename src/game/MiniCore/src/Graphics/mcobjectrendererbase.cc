@@ -19,6 +19,125 @@
 
 #include "mcobjectrendererbase.hh"
 
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+/*! Persistent worker threads for MCObjectRendererBase::fillInParallel(). The
+ *  threads are started on the first parallel fill and wait for chunks after that. */
+class FillPool
+{
+public:
+
+    explicit FillPool(int workerCount)
+    {
+        for (int i = 0; i < workerCount; i++)
+        {
+            m_workers.push_back(std::thread(&FillPool::runWorker, this));
+        }
+    }
+
+    ~FillPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_quit = true;
+        }
+
+        m_workAvailable.notify_all();
+
+        for (auto && worker : m_workers)
+        {
+            worker.join();
+        }
+    }
+
+    //! Call fill() for chunkCount consecutive chunks covering [0, count) and wait for them.
+    void fill(int count, int chunkCount, const std::function<void (int, int)> & fill)
+    {
+        std::lock_guard<std::mutex> fillLock(m_fillMutex);
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_fill = &fill;
+        m_count = count;
+        m_chunkSize = (count + chunkCount - 1) / chunkCount;
+        m_chunkCount = chunkCount;
+        m_nextChunk = 0;
+        m_pendingChunks = chunkCount;
+        m_workAvailable.notify_all();
+
+        // The calling thread fills chunks too
+        fillChunks(lock);
+
+        m_chunksDone.wait(lock, [this] { return m_pendingChunks == 0; });
+        m_fill = nullptr;
+    }
+
+private:
+
+    void fillChunks(std::unique_lock<std::mutex> & lock)
+    {
+        while (m_nextChunk < m_chunkCount)
+        {
+            const int first = m_nextChunk++ * m_chunkSize;
+            const int last = std::min(first + m_chunkSize, m_count);
+            const std::function<void (int, int)> & fill = *m_fill;
+
+            lock.unlock();
+            fill(first, last);
+            lock.lock();
+
+            if (--m_pendingChunks == 0)
+            {
+                m_chunksDone.notify_all();
+            }
+        }
+    }
+
+    void runWorker()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (true)
+        {
+            m_workAvailable.wait(lock, [this] { return m_quit || m_nextChunk < m_chunkCount; });
+            if (m_quit)
+            {
+                return;
+            }
+
+            fillChunks(lock);
+        }
+    }
+
+    std::vector<std::thread> m_workers;
+
+    std::mutex m_fillMutex;
+
+    std::mutex m_mutex;
+
+    std::condition_variable m_workAvailable;
+
+    std::condition_variable m_chunksDone;
+
+    const std::function<void (int, int)> * m_fill = nullptr;
+
+    int m_count = 0;
+
+    int m_chunkSize = 0;
+
+    int m_chunkCount = 0;
+
+    int m_nextChunk = 0;
+
+    int m_pendingChunks = 0;
+
+    bool m_quit = false;
+};
+}
+
 MCObjectRendererBase::MCObjectRendererBase(int maxBatchSize)
     : MCGLObjectBase("mcobjectrendererbase")
     , m_batchSize(0)
@@ -62,6 +181,21 @@ bool MCObjectRendererBase::hasShadow() const
     return m_hasShadow;
 }
 
+void MCObjectRendererBase::fillInParallel(int count, const std::function<void (int, int)> & fill)
+{
+    const int maxThreads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    const int threadCount = std::min(maxThreads, count / MIN_OBJECTS_PER_THREAD);
+    if (threadCount <= 1)
+    {
+        fill(0, count);
+        return;
+    }
+
+    // The calling thread is one of the threads
+    static FillPool pool(maxThreads - 1);
+    pool.fill(count, threadCount, fill);
+}
+
 bool MCObjectRendererBase::useAlphaBlend() const
 {
     return m_useAlphaBlend;
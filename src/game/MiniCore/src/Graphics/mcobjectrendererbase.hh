@@ -27,6 +27,7 @@
 #include "mcgltexcoord.hh"
 #include "mcrenderlayer.hh"
 
+#include <functional>
 #include <memory>
 
 class MCObjectRendererBase : public MCGLObjectBase
@@ -55,6 +56,14 @@ public:
     //! \return True if shadow needs to be rendered
     bool hasShadow() const;
 
+    /*! Call fill(first, last) for consecutive ranges covering [0, count).
+     *  Large counts are split into chunks that are filled by persistent worker threads,
+     *  so fill must only write to its own range. */
+    static void fillInParallel(int count, const std::function<void (int, int)> & fill);
+
+    //! Minimum number of objects filled by one worker thread.
+    static const int MIN_OBJECTS_PER_THREAD = 256;
+
 protected:
 
     //! Set current batch size
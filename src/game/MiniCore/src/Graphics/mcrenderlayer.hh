@@ -20,6 +20,8 @@
 #ifndef MCRENDERLAYER_HH
 #define MCRENDERLAYER_HH
 
+#include "mcobjectbatchtable.hh"
+
 #include <map>
 #include <set>
 #include <vector>
@@ -44,14 +46,9 @@ public:
 
     bool depthMaskEnabled() const;
 
-    struct ObjectBatch
-    {
-        int objectViewId = -1;
-        float priority = 0;
-        std::vector<MCObject *> objects;
-    };
+    typedef MCObjectBatchTable::Batch ObjectBatch;
 
-    typedef std::map<MCCamera *, std::vector<ObjectBatch> > CameraBatchMap;
+    typedef std::map<MCCamera *, MCObjectBatchTable> CameraBatchMap;
 
     CameraBatchMap & objectBatches();
 
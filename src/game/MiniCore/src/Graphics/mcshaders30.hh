@@ -154,6 +154,66 @@ static const char * MCDefaultShadowFsh =
 "    }\n"
 "}\n";
 
+static const char * MCDefaultParticleVsh =
+"#version 130\n"
+""
+"in      vec3  inVertex;   // Center of the particle\n"
+"in      vec2  inNormal;   // Size and angle (degrees) of the particle\n"
+"in      vec2  inTexCoord; // Corner of the quad in [-1, 1]\n"
+"in      vec4  inColor;\n"
+"uniform vec4  scale = vec4(1, 1, 1, 1);\n"
+"uniform vec4  color = vec4(1, 1, 1, 1);\n"
+"uniform mat4  vp;\n"
+"uniform mat4  model;\n"
+"uniform vec4  dd = vec4(1, 1, 1, 1);\n"
+"uniform vec4  dc = vec4(1, 1, 1, 1);\n"
+"uniform vec4  ac = vec4(1, 1, 1, 1);\n"
+"uniform float dCoeff = 1;\n"
+"out     vec2  texCoord0;\n"
+"out     vec4  vColor;\n"
+""
+"void main()\n"
+"{\n"
+"    float a = radians(inNormal.y);\n"
+"    vec2  corner = inTexCoord * inNormal.x;\n"
+"    vec2  offset = vec2(\n"
+"        cos(a) * corner.x - sin(a) * corner.y,\n"
+"        sin(a) * corner.x + cos(a) * corner.y);\n"
+""
+"    gl_Position = vp * model * (vec4(inVertex.xy + offset, inVertex.z, 1) * scale);\n"
+""
+"    mat4 normalRot = mat4(mat3(model));\n"
+"    float di = dot(dd.xyz, (normalRot * vec4(0, 0, -1, 1)).xyz) * dc.a;\n"
+"    vColor = inColor * color * (\n"
+"        vec4(ac.rgb * ac.a, 1.0) +\n"
+"        vec4(dc.rgb * di * dCoeff, 1.0));\n"
+""
+"    texCoord0 = inTexCoord * 0.5 + 0.5;\n"
+"}\n";
+
+static const char * MCDefaultParticleShadowVsh =
+"#version 130\n"
+""
+"in      vec3 inVertex;\n"
+"in      vec2 inNormal;\n"
+"in      vec2 inTexCoord;\n"
+"uniform vec4 scale = vec4(1, 1, 1, 1);\n"
+"uniform mat4 vp;\n"
+"uniform mat4 model;\n"
+"out     vec2 texCoord0;\n"
+""
+"void main()\n"
+"{\n"
+"    float a = radians(inNormal.y);\n"
+"    vec2  corner = inTexCoord * inNormal.x;\n"
+"    vec2  offset = vec2(\n"
+"        cos(a) * corner.x - sin(a) * corner.y,\n"
+"        sin(a) * corner.x + cos(a) * corner.y);\n"
+""
+"    gl_Position = vp * model * (vec4(inVertex.xy + offset, 0, 1) * scale);\n"
+"    texCoord0   = inTexCoord * 0.5 + 0.5;\n"
+"}\n";
+
 static const char * MCDefaultTextVsh =
 "#version 130\n"
 ""
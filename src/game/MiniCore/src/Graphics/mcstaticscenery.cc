@@ -0,0 +1,175 @@
+// This file belongs to the "MiniCore" game engine.
+// Copyright (C) 2018 Jussi Lind <jussi.lind@iki.fi>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+// MA  02110-1301, USA.
+//
+#include "mcstaticscenery.hh"
+
+#include "mccamera.hh"
+#include "mcglshaderprogram.hh"
+#include "mclogger.hh"
+#include "mcobject.hh"
+#include "mcshape.hh"
+#include "mcstaticscenerychunk.hh"
+#include "mcsurfaceview.hh"
+
+#include <algorithm>
+#include <cmath>
+
+MCStaticScenery::MCStaticScenery(float regionSize)
+    : m_regionSize(regionSize)
+{
+}
+
+bool MCStaticScenery::canBake(MCObject & object) const
+{
+    if (object.isRenderable() && object.shape() && object.shape()->view())
+    {
+        auto view = dynamic_cast<MCSurfaceView *>(object.shape()->view().get());
+        if (!view || !view->surface())
+        {
+            return false;
+        }
+    }
+
+    for (auto child : object.children())
+    {
+        if (!canBake(*child))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void MCStaticScenery::collect(MCObject & object)
+{
+    if (object.isRenderable() && object.shape() && object.shape()->view())
+    {
+        auto view = static_cast<MCSurfaceView *>(object.shape()->view().get());
+        const MCShape & shape = *object.shape();
+
+        const ChunkKey key(
+            static_cast<int>(std::floor(shape.location().i() / m_regionSize)),
+            static_cast<int>(std::floor(shape.location().j() / m_regionSize)),
+            view->surface(),
+            view->shaderProgram().get(),
+            view->shadowShaderProgram().get(),
+            shape.shadowOffset().k());
+
+        m_views[key].push_back(&object);
+
+        if (view->hasShadow())
+        {
+            m_shadows[key].push_back(&object);
+        }
+
+        object.setIsRenderable(false);
+    }
+
+    for (auto child : object.children())
+    {
+        collect(*child);
+    }
+}
+
+bool MCStaticScenery::add(MCObject & object)
+{
+    if (!canBake(object))
+    {
+        return false;
+    }
+
+    collect(object);
+
+    return true;
+}
+
+void MCStaticScenery::build()
+{
+    // The children must be at their final locations before baking
+    MCObject::resolveChildTransforms();
+
+    m_viewChunks.clear();
+    m_shadowChunks.clear();
+
+    for (auto && views : m_views)
+    {
+        m_viewChunks.push_back(std::unique_ptr<MCStaticSceneryChunk>(new MCStaticSceneryChunk(views.second, false)));
+    }
+
+    for (auto && shadows : m_shadows)
+    {
+        m_shadowChunks.push_back(std::unique_ptr<MCStaticSceneryChunk>(new MCStaticSceneryChunk(shadows.second, true)));
+    }
+
+    // Render the lower chunks first like the object batches
+    auto byPriority = [] (const std::unique_ptr<MCStaticSceneryChunk> & l, const std::unique_ptr<MCStaticSceneryChunk> & r) {
+        return l->priority() < r->priority();
+    };
+    std::stable_sort(m_viewChunks.begin(), m_viewChunks.end(), byPriority);
+    std::stable_sort(m_shadowChunks.begin(), m_shadowChunks.end(), byPriority);
+
+    MCLogger().info() << "Static scenery: " << m_viewChunks.size() << " view chunks, "
+                      << m_shadowChunks.size() << " shadow chunks.";
+}
+
+void MCStaticScenery::renderChunks(MCCamera * camera, std::vector<std::unique_ptr<MCStaticSceneryChunk>> & chunks)
+{
+    for (auto && chunk : chunks)
+    {
+        if (!camera || camera->isVisible(chunk->bbox()))
+        {
+            chunk->render(camera);
+        }
+    }
+}
+
+void MCStaticScenery::render(MCCamera * camera)
+{
+    renderChunks(camera, m_viewChunks);
+}
+
+void MCStaticScenery::renderShadows(MCCamera * camera)
+{
+    renderChunks(camera, m_shadowChunks);
+}
+
+void MCStaticScenery::clear()
+{
+    for (auto && views : m_views)
+    {
+        for (MCObject * object : views.second)
+        {
+            object->setIsRenderable(true);
+        }
+    }
+
+    m_views.clear();
+    m_shadows.clear();
+    m_viewChunks.clear();
+    m_shadowChunks.clear();
+}
+
+int MCStaticScenery::chunkCount() const
+{
+    return static_cast<int>(m_viewChunks.size() + m_shadowChunks.size());
+}
+
+MCStaticScenery::~MCStaticScenery()
+{
+}
@@ -0,0 +1,100 @@
+// This file belongs to the "MiniCore" game engine.
+// Copyright (C) 2018 Jussi Lind <jussi.lind@iki.fi>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+// MA  02110-1301, USA.
+//
+#ifndef MCSTATICSCENERY_HH
+#define MCSTATICSCENERY_HH
+
+#include "mcmacros.hh"
+
+#include <map>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+class MCCamera;
+class MCGLShaderProgram;
+class MCObject;
+class MCShapeView;
+class MCStaticSceneryChunk;
+class MCSurface;
+
+/*! Renders objects that never move nor animate from vertex buffers that
+ *  are built once. The views of the added objects (and their children)
+ *  are grouped by world region and surface into MCStaticSceneryChunk's,
+ *  which are then drawn with a single call each if visible to the camera.
+ *
+ *  Added objects are marked as non-renderable so that they are skipped
+ *  when MCWorldRenderer builds the dynamic object batches, but they stay
+ *  in the world for collisions. */
+class MCStaticScenery
+{
+public:
+
+    //! Constructor.
+    //! \param regionSize Width and height of a region in world units.
+    explicit MCStaticScenery(float regionSize = 1024);
+
+    //! Destructor.
+    ~MCStaticScenery();
+
+    /*! Add the given object and its children. build() must be called to take effect.
+     *  \return false if the object tree has views that can't be baked
+     *          (e.g. meshes), in which case nothing is added. */
+    bool add(MCObject & object);
+
+    //! Bake the added objects into chunks.
+    void build();
+
+    //! Render the visible chunks.
+    void render(MCCamera * camera);
+
+    //! Render the shadows of the visible chunks.
+    void renderShadows(MCCamera * camera);
+
+    //! Remove all objects and chunks.
+    void clear();
+
+    //! \return number of chunks (views and shadows) built.
+    int chunkCount() const;
+
+private:
+
+    DISABLE_COPY(MCStaticScenery);
+    DISABLE_ASSI(MCStaticScenery);
+
+    bool canBake(MCObject & object) const;
+
+    void collect(MCObject & object);
+
+    void renderChunks(MCCamera * camera, std::vector<std::unique_ptr<MCStaticSceneryChunk>> & chunks);
+
+    //! Region x, region y, surface, shader program, shadow shader program, shadow z.
+    typedef std::tuple<int, int, MCSurface *, MCGLShaderProgram *, MCGLShaderProgram *, float> ChunkKey;
+
+    std::map<ChunkKey, std::vector<MCObject *>> m_views;
+
+    std::map<ChunkKey, std::vector<MCObject *>> m_shadows;
+
+    std::vector<std::unique_ptr<MCStaticSceneryChunk>> m_viewChunks;
+
+    std::vector<std::unique_ptr<MCStaticSceneryChunk>> m_shadowChunks;
+
+    float m_regionSize;
+};
+
+#endif // MCSTATICSCENERY_HH
@@ -0,0 +1,191 @@
+// This file belongs to the "MiniCore" game engine.
+// Copyright (C) 2018 Jussi Lind <jussi.lind@iki.fi>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+// MA  02110-1301, USA.
+//
+#include "mcstaticscenerychunk.hh"
+
+#include "mccamera.hh"
+#include "mcglshaderprogram.hh"
+#include "mcmathutil.hh"
+#include "mcobject.hh"
+#include "mcshape.hh"
+#include "mcsurface.hh"
+#include "mcsurfaceview.hh"
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+
+namespace {
+const int NUM_VERTICES_PER_SURFACE = 6;
+}
+
+static MCSurface & surfaceOf(const std::vector<MCObject *> & objects)
+{
+    assert(objects.size());
+    auto view = dynamic_cast<MCSurfaceView *>(objects.at(0)->shape()->view().get());
+    assert(view && view->surface());
+    return *view->surface();
+}
+
+MCStaticSceneryChunk::MCStaticSceneryChunk(const std::vector<MCObject *> & objects, bool isShadow)
+    : MCGLObjectBase("MCStaticSceneryChunk")
+    , m_surface(surfaceOf(objects))
+    , m_isShadow(isShadow)
+    , m_numVertices(static_cast<int>(objects.size()) * NUM_VERTICES_PER_SURFACE)
+    , m_shadowZ(objects.at(0)->shape()->shadowOffset().k())
+    , m_priority(std::numeric_limits<float>::lowest())
+    , m_bbox(std::numeric_limits<float>::max(), std::numeric_limits<float>::max(),
+             std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest())
+{
+    // Take common properties from the first object
+    auto view = objects.at(0)->shape()->view();
+    setShaderProgram(view->shaderProgram());
+    setShadowShaderProgram(view->shadowShaderProgram());
+    setMaterial(m_surface.material());
+
+    // Draw the lower objects first like the object batches do
+    std::vector<MCObject *> sorted(objects);
+    std::stable_sort(sorted.begin(), sorted.end(), [] (const MCObject * l, const MCObject * r) {
+        return l->location().k() < r->location().k();
+    });
+
+    std::vector<MCGLVertex> vertices(m_numVertices);
+    std::vector<MCGLVertex> normals(m_numVertices);
+    std::vector<MCGLTexCoord> texCoords(m_numVertices);
+    std::vector<MCGLColor> colors(m_numVertices);
+
+    int vertexIndex = 0;
+    for (MCObject * object : sorted)
+    {
+        const MCShape & shape = *object->shape();
+        const MCVector3dF & scale = shape.view()->scale();
+        const float angle = object->angle();
+
+        float x = shape.location().i();
+        float y = shape.location().j();
+        if (m_isShadow)
+        {
+            x += shape.shadowOffset().i();
+            y += shape.shadowOffset().j();
+        }
+
+        m_priority = std::max(m_priority, object->location().k());
+
+        for (int j = 0; j < NUM_VERTICES_PER_SURFACE; j++)
+        {
+            // Scale first and then rotate like the shaders do
+            const MCGLVertex & vertex = m_surface.vertex(j);
+            const float vx = vertex.x() * scale.i();
+            const float vy = vertex.y() * scale.j();
+
+            vertices[vertexIndex] = MCGLVertex(
+                x + MCMathUtil::rotatedX(vx, vy, angle),
+                y + MCMathUtil::rotatedY(vx, vy, angle),
+                m_isShadow ? 0 : shape.location().k() + vertex.z() * scale.k());
+
+            const MCGLVertex & normal = m_surface.normal(j);
+            normals[vertexIndex] = MCGLVertex(
+                MCMathUtil::rotatedX(normal.x(), normal.y(), angle),
+                MCMathUtil::rotatedY(normal.x(), normal.y(), angle),
+                normal.z());
+
+            texCoords[vertexIndex] = m_surface.texCoord(j);
+
+            colors[vertexIndex] = static_cast<MCGLObjectBase &>(m_surface).color(j);
+
+            m_bbox.setX1(std::min(m_bbox.x1(), vertices[vertexIndex].x()));
+            m_bbox.setY1(std::min(m_bbox.y1(), vertices[vertexIndex].y()));
+            m_bbox.setX2(std::max(m_bbox.x2(), vertices[vertexIndex].x()));
+            m_bbox.setY2(std::max(m_bbox.y2(), vertices[vertexIndex].y()));
+
+            vertexIndex++;
+        }
+    }
+
+    const int VERTEX_DATA_SIZE = sizeof(MCGLVertex) * m_numVertices;
+    const int NORMAL_DATA_SIZE = sizeof(MCGLVertex) * m_numVertices;
+    const int TEXCOORD_DATA_SIZE = sizeof(MCGLTexCoord) * m_numVertices;
+    const int COLOR_DATA_SIZE = sizeof(MCGLColor) * m_numVertices;
+    const int TOTAL_DATA_SIZE = VERTEX_DATA_SIZE + NORMAL_DATA_SIZE + TEXCOORD_DATA_SIZE + COLOR_DATA_SIZE;
+
+    initBufferData(TOTAL_DATA_SIZE, GL_STATIC_DRAW);
+
+    addBufferSubData(
+        MCGLShaderProgram::VAL_Vertex, VERTEX_DATA_SIZE, reinterpret_cast<const GLfloat *>(vertices.data()));
+    addBufferSubData(
+        MCGLShaderProgram::VAL_Normal, NORMAL_DATA_SIZE, reinterpret_cast<const GLfloat *>(normals.data()));
+    addBufferSubData(
+        MCGLShaderProgram::VAL_TexCoords, TEXCOORD_DATA_SIZE, reinterpret_cast<const GLfloat *>(texCoords.data()));
+    addBufferSubData(
+        MCGLShaderProgram::VAL_Color, COLOR_DATA_SIZE, reinterpret_cast<const GLfloat *>(colors.data()));
+
+    finishBufferData();
+}
+
+const MCBBoxF & MCStaticSceneryChunk::bbox() const
+{
+    return m_bbox;
+}
+
+float MCStaticSceneryChunk::priority() const
+{
+    return m_priority;
+}
+
+void MCStaticSceneryChunk::render(MCCamera * camera)
+{
+    // The vertices are in world coordinates, so only
+    // the camera offset needs to be applied.
+    float x = 0;
+    float y = 0;
+    if (camera)
+    {
+        camera->mapToCamera(x, y);
+    }
+
+    if (m_isShadow)
+    {
+        bindShadow();
+
+        // The shadow shader flattens the vertices, so the
+        // shadow height is given in the transformation.
+        shadowShaderProgram()->setScale(1.0f, 1.0f, 1.0f);
+        shadowShaderProgram()->setTransform(0, MCVector3dF(x, y, m_shadowZ));
+
+        render();
+
+        releaseShadow();
+    }
+    else
+    {
+        bind();
+
+        shaderProgram()->setScale(1.0f, 1.0f, 1.0f);
+        shaderProgram()->setColor(m_surface.color());
+        shaderProgram()->setTransform(0, MCVector3dF(x, y, 0));
+
+        render();
+
+        release();
+    }
+}
+
+void MCStaticSceneryChunk::render()
+{
+    drawArrays(GL_TRIANGLES, m_numVertices);
+}
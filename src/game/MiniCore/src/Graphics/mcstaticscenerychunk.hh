@@ -0,0 +1,77 @@
+// This file belongs to the "MiniCore" game engine.
+// Copyright (C) 2018 Jussi Lind <jussi.lind@iki.fi>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+// MA  02110-1301, USA.
+//
+#ifndef MCSTATICSCENERYCHUNK_HH
+#define MCSTATICSCENERYCHUNK_HH
+
+#include "mcbbox.hh"
+#include "mcglobjectbase.hh"
+#include "mcmacros.hh"
+
+#include <vector>
+
+class MCCamera;
+class MCObject;
+class MCSurface;
+
+/*! A vertex buffer with the surface views of stationary objects baked in
+ *  world coordinates. All objects must share the same surface, shader programs
+ *  and shadow offset, so that the whole chunk can be drawn with a single call.
+ *  A chunk contains either the views or the shadows of the objects. */
+class MCStaticSceneryChunk : public MCGLObjectBase
+{
+public:
+
+    /*! Constructor. Bakes the given objects.
+     *  \param objects Objects with MCSurfaceView's of the same surface.
+     *  \param isShadow Bake the shadows of the objects instead of the views. */
+    MCStaticSceneryChunk(const std::vector<MCObject *> & objects, bool isShadow);
+
+    //! \return bounding box of the baked geometry in world coordinates.
+    const MCBBoxF & bbox() const;
+
+    //! \return the highest location of the baked objects.
+    float priority() const;
+
+    //! Render as seen through the given camera (can be nullptr).
+    void render(MCCamera * camera);
+
+    //! \reimp
+    virtual void render() override;
+
+    using MCGLObjectBase::render;
+
+private:
+
+    DISABLE_COPY(MCStaticSceneryChunk);
+    DISABLE_ASSI(MCStaticSceneryChunk);
+
+    MCSurface & m_surface;
+
+    bool m_isShadow;
+
+    int m_numVertices;
+
+    float m_shadowZ;
+
+    float m_priority;
+
+    MCBBoxF m_bbox;
+};
+
+#endif // MCSTATICSCENERYCHUNK_HH
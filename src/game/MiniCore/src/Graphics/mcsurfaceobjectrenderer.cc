@@ -62,40 +62,12 @@ MCSurfaceObjectRenderer::MCSurfaceObjectRenderer(int maxBatchSize)
     finishBufferData();
 }
 
-void MCSurfaceObjectRenderer::setBatch(MCRenderLayer::ObjectBatch & batch, MCCamera * camera, bool isShadow)
+void MCSurfaceObjectRenderer::fillVertexData(MCRenderLayer::ObjectBatch & batch, MCCamera * camera, bool isShadow, int first, int last)
 {
-    if (!batch.objects.size()) {
-        return;
-    }
-
-    setBatchSize(std::min(static_cast<int>(batch.objects.size()), maxBatchSize()));
-    std::sort(batch.objects.begin(), batch.objects.end(), [] (const MCObject * l, const MCObject * r) {
-        return l->location().k() < r->location().k();
-    });
-
-    const int NUM_VERTICES = batchSize() * NUM_VERTICES_PER_SURFACE;
-    const int VERTEX_DATA_SIZE = sizeof(MCGLVertex) * NUM_VERTICES;
-    const int NORMAL_DATA_SIZE = sizeof(MCGLVertex) * NUM_VERTICES;
-    const int TEXCOORD_DATA_SIZE = sizeof(MCGLTexCoord) * NUM_VERTICES;
-    const int COLOR_DATA_SIZE  = sizeof(MCGLColor) * NUM_VERTICES;
-
-    // Take common properties from the first Object in the batch
-    MCObject * object = batch.objects.at(0);
-    MCSurfaceView * view = dynamic_cast<MCSurfaceView *>(object->shape()->view().get());
-    assert(view);
-
-    m_surface = view->surface();
-
-    setShaderProgram(view->shaderProgram());
-    setShadowShaderProgram(view->shadowShaderProgram());
-
-    setMaterial(m_surface->material());
-    setHasShadow(view->hasShadow());
-
-    int vertexIndex = 0;
-    for (int i = 0; i < batchSize(); i++)
+    int vertexIndex = first * NUM_VERTICES_PER_SURFACE;
+    for (int i = first; i < last; i++)
     {
-        object = batch.objects[i];
+        MCObject * object = batch.objects[i];
         MCSurfaceView * view = static_cast<MCSurfaceView *>(object->shape()->view().get());
         MCVector3dF location(object->shape()->location());
 
@@ -126,8 +98,8 @@ void MCSurfaceObjectRenderer::setBatch(MCRenderLayer::ObjectBatch & batch, MCCam
 
             m_vertices[vertexIndex] =
                     MCGLVertex(
-                        x + MCMathUtil::rotatedX(vertex.x(), vertex.y(), object->angle()) * view->scale().i(),
-                        y + MCMathUtil::rotatedY(vertex.x(), vertex.y(), object->angle()) * view->scale().j(),
+                        x + MCMathUtil::rotatedX(vertex.x(), vertex.y(), object->shape()->angle()) * view->scale().i(),
+                        y + MCMathUtil::rotatedY(vertex.x(), vertex.y(), object->shape()->angle()) * view->scale().j(),
                         !isShadow ? z + vertex.z() : z);
 
             m_normals[vertexIndex] = m_surface->normal(j);
@@ -137,6 +109,41 @@ void MCSurfaceObjectRenderer::setBatch(MCRenderLayer::ObjectBatch & batch, MCCam
             vertexIndex++;
         }
     }
+}
+
+void MCSurfaceObjectRenderer::setBatch(MCRenderLayer::ObjectBatch & batch, MCCamera * camera, bool isShadow)
+{
+    if (!batch.objects.size()) {
+        return;
+    }
+
+    setBatchSize(std::min(static_cast<int>(batch.objects.size()), maxBatchSize()));
+    std::sort(batch.objects.begin(), batch.objects.end(), [] (const MCObject * l, const MCObject * r) {
+        return l->location().k() < r->location().k();
+    });
+
+    const int NUM_VERTICES = batchSize() * NUM_VERTICES_PER_SURFACE;
+    const int VERTEX_DATA_SIZE = sizeof(MCGLVertex) * NUM_VERTICES;
+    const int NORMAL_DATA_SIZE = sizeof(MCGLVertex) * NUM_VERTICES;
+    const int TEXCOORD_DATA_SIZE = sizeof(MCGLTexCoord) * NUM_VERTICES;
+    const int COLOR_DATA_SIZE  = sizeof(MCGLColor) * NUM_VERTICES;
+
+    // Take common properties from the first Object in the batch
+    MCObject * object = batch.objects.at(0);
+    MCSurfaceView * view = dynamic_cast<MCSurfaceView *>(object->shape()->view().get());
+    assert(view);
+
+    m_surface = view->surface();
+
+    setShaderProgram(view->shaderProgram());
+    setShadowShaderProgram(view->shadowShaderProgram());
+
+    setMaterial(m_surface->material());
+    setHasShadow(view->hasShadow());
+
+    fillInParallel(batchSize(), [&] (int first, int last) {
+        fillVertexData(batch, camera, isShadow, first, last);
+    });
 
     initUpdateBufferData();
 
@@ -171,7 +178,7 @@ void MCSurfaceObjectRenderer::render()
     shaderProgram()->setScale(1.0f, 1.0f, 1.0f);
     shaderProgram()->setColor(m_surface->color());
 
-    glDrawArrays(GL_TRIANGLES, 0, batchSize() * NUM_VERTICES_PER_SURFACE);
+    drawArrays(GL_TRIANGLES, batchSize() * NUM_VERTICES_PER_SURFACE);
 
     releaseVBO();
     releaseVAO();
@@ -186,7 +193,7 @@ void MCSurfaceObjectRenderer::renderShadows()
     shadowShaderProgram()->setTransform(0, MCVector3dF(0, 0, 0));
     shadowShaderProgram()->setScale(1.0f, 1.0f, 1.0f);
 
-    glDrawArrays(GL_TRIANGLES, 0, batchSize() * NUM_VERTICES_PER_SURFACE);
+    drawArrays(GL_TRIANGLES, batchSize() * NUM_VERTICES_PER_SURFACE);
 
     releaseVBO();
     releaseVAO();
@@ -55,6 +55,9 @@ private:
      *  \param camera The camera window. */
     void setBatch(MCRenderLayer::ObjectBatch & batch, MCCamera * camera = nullptr, bool isShadow = false) override;
 
+    //! Transform the vertices of the objects [first, last) of the batch.
+    void fillVertexData(MCRenderLayer::ObjectBatch & batch, MCCamera * camera, bool isShadow, int first, int last);
+
     //! Render the current Object batch.
     void render() override;
 
@@ -43,34 +43,12 @@ MCSurfaceObjectRendererLegacy::MCSurfaceObjectRendererLegacy(int maxBatchSize)
 {
 }
 
-void MCSurfaceObjectRendererLegacy::setBatch(MCRenderLayer::ObjectBatch & batch, MCCamera * camera, bool isShadow)
+void MCSurfaceObjectRendererLegacy::fillVertexData(MCRenderLayer::ObjectBatch & batch, MCCamera * camera, bool isShadow, int first, int last)
 {
-    if (!batch.objects.size()) {
-        return;
-    }
-
-    setBatchSize(std::min(static_cast<int>(batch.objects.size()), maxBatchSize()));
-    std::sort(batch.objects.begin(), batch.objects.end(), [] (const MCObject * l, const MCObject * r) {
-        return l->location().k() < r->location().k();
-    });
-
-    // Take common properties from the first Object in the batch
-    MCObject * object = batch.objects.at(0);
-    MCSurfaceView * view = dynamic_cast<MCSurfaceView *>(object->shape()->view().get());
-    assert(view);
-
-    m_surface = view->surface();
-
-    setShaderProgram(view->shaderProgram());
-    setShadowShaderProgram(view->shadowShaderProgram());
-
-    setMaterial(m_surface->material());
-    setHasShadow(view->hasShadow());
-
-    int vertexIndex = 0;
-    for (int i = 0; i < batchSize(); i++)
+    int vertexIndex = first * NUM_VERTICES_PER_SURFACE;
+    for (int i = first; i < last; i++)
     {
-        object = batch.objects[i];
+        MCObject * object = batch.objects[i];
         MCSurfaceView * view = static_cast<MCSurfaceView *>(object->shape()->view().get());
         MCVector3dF location(object->shape()->location());
 
@@ -101,8 +79,8 @@ void MCSurfaceObjectRendererLegacy::setBatch(MCRenderLayer::ObjectBatch & batch,
 
             m_vertices[vertexIndex] =
                     MCGLVertex(
-                        x + MCMathUtil::rotatedX(vertex.x(), vertex.y(), object->angle()) * view->scale().i(),
-                        y + MCMathUtil::rotatedY(vertex.x(), vertex.y(), object->angle()) * view->scale().j(),
+                        x + MCMathUtil::rotatedX(vertex.x(), vertex.y(), object->shape()->angle()) * view->scale().i(),
+                        y + MCMathUtil::rotatedY(vertex.x(), vertex.y(), object->shape()->angle()) * view->scale().j(),
                         !isShadow ? z + vertex.z() : z);
 
             m_normals[vertexIndex] = m_surface->normal(j);
@@ -114,6 +92,35 @@ void MCSurfaceObjectRendererLegacy::setBatch(MCRenderLayer::ObjectBatch & batch,
     }
 }
 
+void MCSurfaceObjectRendererLegacy::setBatch(MCRenderLayer::ObjectBatch & batch, MCCamera * camera, bool isShadow)
+{
+    if (!batch.objects.size()) {
+        return;
+    }
+
+    setBatchSize(std::min(static_cast<int>(batch.objects.size()), maxBatchSize()));
+    std::sort(batch.objects.begin(), batch.objects.end(), [] (const MCObject * l, const MCObject * r) {
+        return l->location().k() < r->location().k();
+    });
+
+    // Take common properties from the first Object in the batch
+    MCObject * object = batch.objects.at(0);
+    MCSurfaceView * view = dynamic_cast<MCSurfaceView *>(object->shape()->view().get());
+    assert(view);
+
+    m_surface = view->surface();
+
+    setShaderProgram(view->shaderProgram());
+    setShadowShaderProgram(view->shadowShaderProgram());
+
+    setMaterial(m_surface->material());
+    setHasShadow(view->hasShadow());
+
+    fillInParallel(batchSize(), [&] (int first, int last) {
+        fillVertexData(batch, camera, isShadow, first, last);
+    });
+}
+
 void MCSurfaceObjectRendererLegacy::setAttributePointers()
 {
     glVertexAttribPointer(MCGLShaderProgram::VAL_Vertex, 3, GL_FLOAT, GL_FALSE,
@@ -143,7 +150,7 @@ void MCSurfaceObjectRendererLegacy::render()
     enableAttributePointers();
     setAttributePointers();
 
-    glDrawArrays(GL_TRIANGLES, 0, batchSize() * NUM_VERTICES_PER_SURFACE);
+    drawArrays(GL_TRIANGLES, batchSize() * NUM_VERTICES_PER_SURFACE);
 }
 
 void MCSurfaceObjectRendererLegacy::renderShadows()
@@ -162,7 +169,7 @@ void MCSurfaceObjectRendererLegacy::renderShadows()
     enableAttributePointers();
     setAttributePointers();
 
-    glDrawArrays(GL_TRIANGLES, 0, batchSize() * NUM_VERTICES_PER_SURFACE);
+    drawArrays(GL_TRIANGLES, batchSize() * NUM_VERTICES_PER_SURFACE);
 }
 
 MCSurfaceObjectRendererLegacy::~MCSurfaceObjectRendererLegacy()
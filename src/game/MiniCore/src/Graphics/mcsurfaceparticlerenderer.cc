@@ -19,11 +19,12 @@
 
 #include "mcsurfaceparticlerenderer.hh"
 
-#include "mcmathutil.hh"
+#include "mcglscene.hh"
 #include "mcsurfaceparticle.hh"
-#include "mctrigonom.hh"
 
 #include <algorithm>
+#include <cstddef>
+#include <vector>
 
 #include <QDebug>
 
@@ -33,36 +34,68 @@ const int NUM_VERTICES_PER_PARTICLE = 6;
 #else
 const int NUM_VERTICES_PER_PARTICLE = 4;
 #endif
+
+// Corners of a particle quad
+const MCGLTexCoord CORNERS[NUM_VERTICES_PER_PARTICLE] =
+{
+#ifdef __MC_GLES__
+    {-1, -1},
+    { 1,  1},
+#endif
+    {-1,  1},
+    {-1, -1},
+    { 1, -1},
+    { 1,  1}
+};
 }
 
 MCSurfaceParticleRenderer::MCSurfaceParticleRenderer(int maxBatchSize)
     : MCParticleRendererBase(maxBatchSize)
-    , m_vertices(new MCGLVertex[maxBatchSize * NUM_VERTICES_PER_PARTICLE])
-    , m_normals(new MCGLVertex[maxBatchSize * NUM_VERTICES_PER_PARTICLE])
-    , m_texCoords(new MCGLTexCoord[maxBatchSize * NUM_VERTICES_PER_PARTICLE])
-    , m_colors(new MCGLColor[maxBatchSize * NUM_VERTICES_PER_PARTICLE])
+    , m_vertices(new MCGLParticleVertex[maxBatchSize * NUM_VERTICES_PER_PARTICLE])
 {
-    const int NUM_VERTICES = maxBatchSize * NUM_VERTICES_PER_PARTICLE;
-    const int VERTEX_DATA_SIZE = sizeof(MCGLVertex) * NUM_VERTICES;
-    const int NORMAL_DATA_SIZE = sizeof(MCGLVertex) * NUM_VERTICES;
-    const int TEXCOORD_DATA_SIZE = sizeof(MCGLTexCoord) * NUM_VERTICES;
-    const int COLOR_DATA_SIZE = sizeof(MCGLColor) * NUM_VERTICES;
-    const int TOTAL_DATA_SIZE = VERTEX_DATA_SIZE + NORMAL_DATA_SIZE + TEXCOORD_DATA_SIZE + COLOR_DATA_SIZE;
-
-    initBufferData(TOTAL_DATA_SIZE, GL_DYNAMIC_DRAW);
-
-    addBufferSubData(
-        MCGLShaderProgram::VAL_Vertex, VERTEX_DATA_SIZE, reinterpret_cast<const GLfloat *>(m_vertices));
-    addBufferSubData(
-        MCGLShaderProgram::VAL_Normal, NORMAL_DATA_SIZE, reinterpret_cast<const GLfloat *>(m_normals));
-    addBufferSubData(
-        MCGLShaderProgram::VAL_TexCoords, TEXCOORD_DATA_SIZE, reinterpret_cast<const GLfloat *>(m_texCoords));
-    addBufferSubData(
-        MCGLShaderProgram::VAL_Color, COLOR_DATA_SIZE, reinterpret_cast<const GLfloat *>(m_colors));
+    setShaderProgram(MCGLScene::instance().defaultParticleShaderProgram());
+    setShadowShaderProgram(MCGLScene::instance().defaultParticleShadowShaderProgram());
+
+    // The corners are the same for every batch, so they are uploaded only once
+    // to a buffer of their own and the vertex buffer can be orphaned.
+    std::vector<MCGLTexCoord> corners;
+    corners.reserve(maxBatchSize * NUM_VERTICES_PER_PARTICLE);
+    for (int i = 0; i < maxBatchSize; i++)
+    {
+        corners.insert(corners.end(), CORNERS, CORNERS + NUM_VERTICES_PER_PARTICLE);
+    }
+
+    glGenBuffers(1, &m_cornerVbo);
+    glBindBuffer(GL_ARRAY_BUFFER, m_cornerVbo);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(MCGLTexCoord) * corners.size(), &corners[0], GL_STATIC_DRAW);
+
+    initBufferData(sizeof(MCGLParticleVertex) * maxBatchSize * NUM_VERTICES_PER_PARTICLE, GL_DYNAMIC_DRAW);
 
     finishBufferData();
 }
 
+void MCSurfaceParticleRenderer::setAttributePointers()
+{
+    enableAttributePointers();
+
+    const GLsizei stride = sizeof(MCGLParticleVertex);
+
+    glVertexAttribPointer(MCGLShaderProgram::VAL_Vertex, 3, GL_FLOAT, GL_FALSE, stride,
+        reinterpret_cast<GLvoid *>(offsetof(MCGLParticleVertex, x)));
+
+    // Size and angle
+    glVertexAttribPointer(MCGLShaderProgram::VAL_Normal, 2, GL_FLOAT, GL_FALSE, stride,
+        reinterpret_cast<GLvoid *>(offsetof(MCGLParticleVertex, size)));
+
+    glVertexAttribPointer(MCGLShaderProgram::VAL_Color, 4, GL_UNSIGNED_BYTE, GL_TRUE, stride,
+        reinterpret_cast<GLvoid *>(offsetof(MCGLParticleVertex, r)));
+
+    glBindBuffer(GL_ARRAY_BUFFER, m_cornerVbo);
+    glVertexAttribPointer(MCGLShaderProgram::VAL_TexCoords, 2, GL_FLOAT, GL_FALSE, 0, 0);
+
+    bindVBO();
+}
+
 void MCSurfaceParticleRenderer::setBatch(MCRenderLayer::ObjectBatch & batch, MCCamera * camera, bool isShadow)
 {
     if (!batch.objects.size()) {
@@ -70,56 +103,11 @@ void MCSurfaceParticleRenderer::setBatch(MCRenderLayer::ObjectBatch & batch, MCC
     }
 
     setBatchSize(std::min(static_cast<int>(batch.objects.size()), maxBatchSize()));
-    std::sort(batch.objects.begin(), batch.objects.end(), [] (const MCObject * l, const MCObject * r) {
-        return l->location().k() < r->location().k();
-    });
+    m_depthSorter.sort(batch.objects);
 
-    const int NUM_VERTICES = batchSize() * NUM_VERTICES_PER_PARTICLE;
-    const int VERTEX_DATA_SIZE = sizeof(MCGLVertex) * NUM_VERTICES;
-    const int NORMAL_DATA_SIZE = sizeof(MCGLVertex) * NUM_VERTICES;
-    const int TEXCOORD_DATA_SIZE = sizeof(MCGLTexCoord) * NUM_VERTICES;
-    const int COLOR_DATA_SIZE  = sizeof(MCGLColor) * NUM_VERTICES;
-
-    // Init vertice data for a quad
-
-    static const MCGLVertex vertices[NUM_VERTICES_PER_PARTICLE] =
-    {
-    #ifdef __MC_GLES__
-        {-1, -1, 0},
-        { 1,  1, 0},
-    #endif
-        {-1,  1, 0},
-        {-1, -1, 0},
-        { 1, -1, 0},
-        { 1,  1, 0}
-    };
-
-    static const MCGLVertex normals[NUM_VERTICES_PER_PARTICLE] =
-    {
-    #ifdef __MC_GLES__
-        { 0, 0, 1},
-        { 0, 0, 1},
-    #endif
-        { 0, 0, 1},
-        { 0, 0, 1},
-        { 0, 0, 1},
-        { 0, 0, 1}
-    };
-
-    const MCGLTexCoord texCoords[NUM_VERTICES_PER_PARTICLE] =
-    {
-    #ifdef __MC_GLES__
-        {0, 0},
-        {1, 1},
-    #endif
-        {0, 1},
-        {0, 0},
-        {1, 0},
-        {1, 1}
-    };
-
-    // Take common properties from the first particle in the batch
-    MCSurfaceParticle * particle = dynamic_cast<MCSurfaceParticle *>(batch.objects.at(0));
+    // Take common properties from the first particle in the batch.
+    // MCWorldRenderer gives only batches of surface particles.
+    MCSurfaceParticle * particle = static_cast<MCSurfaceParticle *>(batch.objects[0]);
     setMaterial(particle->surface().material());
     setHasShadow(particle->hasShadow());
     setAlphaBlend(particle->useAlphaBlend(), particle->alphaSrc(), particle->alphaDst());
@@ -150,61 +138,34 @@ void MCSurfaceParticleRenderer::setBatch(MCRenderLayer::ObjectBatch & batch, MCC
             camera->mapToCamera(x, y);
         }
 
+        float size = particle->radius();
+        MCGLColor color = particle->color();
+        if (particle->animationStyle() == MCParticle::AnimationStyle::FadeOut)
+        {
+            color.setA(color.a() * particle->scale());
+        }
+        else if (particle->animationStyle() == MCParticle::AnimationStyle::FadeOutAndExpand)
+        {
+            color.setA(color.a() * particle->scale());
+            size *= particle->scale();
+        }
+        else if (particle->animationStyle() == MCParticle::AnimationStyle::Shrink)
+        {
+            size *= particle->scale();
+        }
+
+        const MCGLParticleVertex vertex(x, y, z, size, particle->angle(), color);
         for (int j = 0; j < NUM_VERTICES_PER_PARTICLE; j++)
         {
-            float vertexX = vertices[j].x() * particle->radius();
-            float vertexY = vertices[j].y() * particle->radius();
-
-            m_colors[vertexIndex] = particle->color();
-            if (particle->animationStyle() == MCParticle::AnimationStyle::FadeOut)
-            {
-                m_colors[vertexIndex].setA(m_colors[vertexIndex].a() * particle->scale());
-            }
-            else if (particle->animationStyle() == MCParticle::AnimationStyle::FadeOutAndExpand)
-            {
-                m_colors[vertexIndex].setA(m_colors[vertexIndex].a() * particle->scale());
-                vertexX *= particle->scale();
-                vertexY *= particle->scale();
-            }
-            else if (particle->animationStyle() == MCParticle::AnimationStyle::Shrink)
-            {
-                vertexX *= particle->scale();
-                vertexY *= particle->scale();
-            }
-
-            m_vertices[vertexIndex] =
-                MCGLVertex(
-                    x + MCMathUtil::rotatedX(vertexX, vertexY, particle->angle()),
-                    y + MCMathUtil::rotatedY(vertexX, vertexY, particle->angle()),
-                    z);
-
-            m_normals[vertexIndex] = normals[j];
-
-            m_texCoords[vertexIndex] = texCoords[j];
-
-            vertexIndex++;
+            m_vertices[vertexIndex++] = vertex;
         }
     }
 
+    // Orphan the previous data so that the driver doesn't need to wait for
+    // the previous batch to be drawn.
     initUpdateBufferData();
 
-    const int MAX_VERTEX_DATA_SIZE = sizeof(MCGLVertex) * maxBatchSize() * NUM_VERTICES_PER_PARTICLE;
-    addBufferSubData(
-        MCGLShaderProgram::VAL_Vertex, VERTEX_DATA_SIZE, MAX_VERTEX_DATA_SIZE,
-                reinterpret_cast<const GLfloat *>(m_vertices));
-
-    const int MAX_NORMAL_DATA_SIZE = sizeof(MCGLVertex) * maxBatchSize() * NUM_VERTICES_PER_PARTICLE;
-    addBufferSubData(
-        MCGLShaderProgram::VAL_Normal, NORMAL_DATA_SIZE, MAX_NORMAL_DATA_SIZE,
-                reinterpret_cast<const GLfloat *>(m_normals));
-
-    const int MAX_TEXCOORD_DATA_SIZE = sizeof(MCGLTexCoord) * maxBatchSize() * NUM_VERTICES_PER_PARTICLE;
-    addBufferSubData(
-        MCGLShaderProgram::VAL_TexCoords, TEXCOORD_DATA_SIZE, MAX_TEXCOORD_DATA_SIZE,
-                reinterpret_cast<const GLfloat *>(m_texCoords));
-
-    addBufferSubData(
-        MCGLShaderProgram::VAL_Color, COLOR_DATA_SIZE, reinterpret_cast<const GLfloat *>(m_colors));
+    glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(MCGLParticleVertex) * vertexIndex, m_vertices);
 }
 
 void MCSurfaceParticleRenderer::render()
@@ -218,9 +179,9 @@ void MCSurfaceParticleRenderer::render()
     shaderProgram()->setColor(MCGLColor(1.0f, 1.0f, 1.0f, 1.0f));
 
 #ifdef __MC_GLES__
-    glDrawArrays(GL_TRIANGLES, 0, batchSize() * NUM_VERTICES_PER_PARTICLE);
+    drawArrays(GL_TRIANGLES, batchSize() * NUM_VERTICES_PER_PARTICLE);
 #else
-    glDrawArrays(GL_QUADS, 0, batchSize() * NUM_VERTICES_PER_PARTICLE);
+    drawArrays(GL_QUADS, batchSize() * NUM_VERTICES_PER_PARTICLE);
 #endif
     glDisable(GL_BLEND);
 
@@ -238,9 +199,9 @@ void MCSurfaceParticleRenderer::renderShadows()
     shadowShaderProgram()->setScale(1.0f, 1.0f, 1.0f);
 
 #ifdef __MC_GLES__
-    glDrawArrays(GL_TRIANGLES, 0, batchSize() * NUM_VERTICES_PER_PARTICLE);
+    drawArrays(GL_TRIANGLES, batchSize() * NUM_VERTICES_PER_PARTICLE);
 #else
-    glDrawArrays(GL_QUADS, 0, batchSize() * NUM_VERTICES_PER_PARTICLE);
+    drawArrays(GL_QUADS, batchSize() * NUM_VERTICES_PER_PARTICLE);
 #endif
 
     releaseVBO();
@@ -250,8 +211,7 @@ void MCSurfaceParticleRenderer::renderShadows()
 MCSurfaceParticleRenderer::~MCSurfaceParticleRenderer()
 {
     delete [] m_vertices;
-    delete [] m_normals;
-    delete [] m_texCoords;
-    delete [] m_colors;
+
+    glDeleteBuffers(1, &m_cornerVbo);
 }
 
@@ -22,6 +22,8 @@
 
 #include <MCGLEW>
 
+#include "mcdepthsorter.hh"
+#include "mcglparticlevertex.hh"
 #include "mcmacros.hh"
 #include "mcparticlerendererbase.hh"
 #include "mcworldrenderer.hh"
@@ -34,7 +36,8 @@ class MCObject;
 
 /*! Renders surface particle (textured particles) batches.
  *  Each MCSurfaceParticle id should have a corresponding MCSurfaceParticleRenderer
- *  registered to MCWorldRenderer. */
+ *  registered to MCWorldRenderer. The particles are streamed as compact
+ *  MCGLParticleVertex data and expanded to quads by the default particle shaders. */
 class MCSurfaceParticleRenderer : public MCParticleRendererBase
 {
 public:
@@ -60,13 +63,15 @@ private:
     //! Render the current particle batch as shadows.
     void renderShadows() override;
 
-    MCGLVertex * m_vertices;
+    //! \reimp
+    void setAttributePointers() override;
 
-    MCGLVertex * m_normals;
+    MCGLParticleVertex * m_vertices;
 
-    MCGLTexCoord * m_texCoords;
+    //! Static buffer of the quad corners.
+    GLuint m_cornerVbo = 0;
 
-    MCGLColor * m_colors;
+    MCDepthSorter m_depthSorter;
 
     friend class MCWorldRenderer;
 };
@@ -190,9 +190,9 @@ void MCSurfaceParticleRendererLegacy::render()
     setAttributePointers();
 
 #ifdef __MC_GLES__
-    glDrawArrays(GL_TRIANGLES, 0, batchSize() * NUM_VERTICES_PER_PARTICLE);
+    drawArrays(GL_TRIANGLES, batchSize() * NUM_VERTICES_PER_PARTICLE);
 #else
-    glDrawArrays(GL_QUADS, 0, batchSize() * NUM_VERTICES_PER_PARTICLE);
+    drawArrays(GL_QUADS, batchSize() * NUM_VERTICES_PER_PARTICLE);
 #endif
     glDisable(GL_BLEND);
 }
@@ -214,9 +214,9 @@ void MCSurfaceParticleRendererLegacy::renderShadows()
     setAttributePointers();
 
 #ifdef __MC_GLES__
-    glDrawArrays(GL_TRIANGLES, 0, batchSize() * NUM_VERTICES_PER_PARTICLE);
+    drawArrays(GL_TRIANGLES, batchSize() * NUM_VERTICES_PER_PARTICLE);
 #else
-    glDrawArrays(GL_QUADS, 0, batchSize() * NUM_VERTICES_PER_PARTICLE);
+    drawArrays(GL_QUADS, batchSize() * NUM_VERTICES_PER_PARTICLE);
 #endif
 }
 
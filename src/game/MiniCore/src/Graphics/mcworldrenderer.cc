@@ -21,6 +21,8 @@
 
 #include "mccamera.hh"
 #include "mclogger.hh"
+#include "mcsurfaceobjectrenderer.hh"
+#include "mcsurfaceobjectrendererlegacy.hh"
 #include "mcsurfaceparticle.hh"
 #include "mcsurfaceparticlerenderer.hh"
 #include "mcsurfaceparticlerendererlegacy.hh"
@@ -28,14 +30,23 @@
 #include "mcparticle.hh"
 #include "mcshape.hh"
 #include "mcshapeview.hh"
+#include "mcstaticbroadphase.hh"
 #include "mcsurfaceview.hh"
-
-#include <algorithm>
+#include "mctriggersystem.hh"
 
 #include <MCGLEW>
 
+#include <algorithm>
+#include <chrono>
+
 MCWorldRenderer::MCWorldRenderer()
     : m_surfaceParticleRenderer(nullptr)
+    , m_surfaceObjectRenderer(nullptr)
+    , m_cpuBatchThreshold(16)
+    , m_batchBuildNsecs(0)
+    , m_batchWaitNsecs(0)
+    , m_hasBatchJob(false)
+    , m_quitBatchBuilder(false)
 {
 }
 
@@ -46,11 +57,32 @@ MCGLScene & MCWorldRenderer::glScene()
 
 void MCWorldRenderer::buildObjectBatches(MCCamera * camera)
 {
-    m_defaultLayer.objectBatches()[camera].clear();
-    auto & batchVector = m_defaultLayer.objectBatches()[camera];
+    // The batch table is kept from frame to frame so that the batches don't
+    // need to be re-allocated nor re-sorted unless their priorities change.
+    auto & batchTable = m_defaultLayer.objectBatches()[camera];
+    batchTable.clear();
     static std::vector<MCObject *> childStack;
     childStack.clear();
+
+    // The stationary colliders and the triggers are not in the object grid
+    static std::vector<MCObject *> visibleObjects;
+    visibleObjects.clear();
     for (auto && object : MCWorld::instance().objectGrid().getObjectsWithinBBox(camera->bbox()))
+    {
+        visibleObjects.push_back(object);
+    }
+
+    for (auto && object : MCWorld::instance().staticBroadphase().getObjectsWithinBBox(camera->bbox()))
+    {
+        visibleObjects.push_back(object);
+    }
+
+    for (auto && object : MCWorld::instance().triggerSystem().getObjectsWithinBBox(camera->bbox()))
+    {
+        visibleObjects.push_back(object);
+    }
+
+    for (auto && object : visibleObjects)
     {
         childStack.push_back(object);
         while (childStack.size())
@@ -61,22 +93,11 @@ void MCWorldRenderer::buildObjectBatches(MCCamera * camera)
             if (parent->isRenderable() && parent->shape() && parent->shape()->view())
             {
                 const int objectViewId = object->typeId() * 1024 + parent->shape()->view()->viewId();
-                auto batchIter = std::find_if(batchVector.begin(), batchVector.end(), [&](const MCRenderLayer::ObjectBatch & batch) {
-                    return batch.objectViewId == objectViewId;
-                });
-                if (batchIter != batchVector.end())
-                {
-                    auto & batch = (*batchIter);
-                    batch.objects.push_back(parent);
-                    batch.priority = std::max(parent->location().k(), batch.priority);
-                }
-                else
+                auto & batch = batchTable.add(objectViewId, *parent, parent->location().k());
+                if (batch.objects.size() == 1)
                 {
-                    MCRenderLayer::ObjectBatch batch;
-                    batch.objectViewId = objectViewId;
-                    batch.objects.push_back(parent);
-                    batch.priority = parent->location().k();
-                    batchVector.push_back(batch);
+                    // The objects of a batch share the view handle and thus the surface
+                    batch.isCpuBatchable = dynamic_cast<MCSurfaceView *>(parent->shape()->view().get()) != nullptr;
                 }
             }
 
@@ -87,15 +108,13 @@ void MCWorldRenderer::buildObjectBatches(MCCamera * camera)
         }
     }
 
-    std::stable_sort(batchVector.begin(), batchVector.end(), [](const MCRenderLayer::ObjectBatch & l, const MCRenderLayer::ObjectBatch & r) {
-        return l.priority < r.priority;
-    });
+    batchTable.sort();
 }
 
 void MCWorldRenderer::buildParticleBatches(MCCamera * camera)
 {
-    m_defaultLayer.particleBatches()[camera].clear();
-    auto & batchVector = m_defaultLayer.particleBatches()[camera];
+    auto & batchTable = m_defaultLayer.particleBatches()[camera];
+    batchTable.clear();
     for (auto && particleIter : m_particleSet)
     {
         MCParticle & particle = *particleIter;
@@ -107,23 +126,7 @@ void MCWorldRenderer::buildParticleBatches(MCCamera * camera)
 
         if (camera->isVisible(bbox))
         {
-            auto batchIter = std::find_if(batchVector.begin(), batchVector.end(), [&](const MCRenderLayer::ObjectBatch & batch) {
-                return batch.objectViewId == static_cast<int>(particle.typeId());
-            });
-            if (batchIter != batchVector.end())
-            {
-                auto & batch = (*batchIter);
-                batch.objects.push_back(&particle);
-                batch.priority = std::max(particle.location().k(), batch.priority);
-            }
-            else
-            {
-                MCRenderLayer::ObjectBatch batch;
-                batch.objectViewId = particle.typeId();
-                batch.objects.push_back(&particle);
-                batch.priority = particle.location().k();
-                batchVector.push_back(batch);
-            }
+            batchTable.add(static_cast<int>(particle.typeId()), particle, particle.location().k());
         }
         else
         {
@@ -140,20 +143,20 @@ void MCWorldRenderer::buildParticleBatches(MCCamera * camera)
                     }
                 }
 
+                // The batches may be built on the worker thread, so the particle
+                // is killed later on the calling thread of waitForBatches()
                 if (!isVisibleInAnyCamera)
                 {
-                    particle.die();
+                    m_expiredParticles.push_back(&particle);
                 }
             }
         }
     }
 
-    std::stable_sort(batchVector.begin(), batchVector.end(), [](const MCRenderLayer::ObjectBatch & l, const MCRenderLayer::ObjectBatch & r) {
-        return l.priority < r.priority;
-    });
+    batchTable.sort();
 }
 
-void MCWorldRenderer::buildBatches(MCCamera * camera)
+void MCWorldRenderer::buildCameraBatches(MCCamera * camera)
 {
     // This code tests the visibility and sorts the objects with respect
     // to their view id's into "batches". MCWorld::render()
@@ -168,18 +171,137 @@ void MCWorldRenderer::buildBatches(MCCamera * camera)
         return;
     }
 
-    if (!m_surfaceParticleRenderer)
+    buildObjectBatches(camera);
+
+    buildParticleBatches(camera);
+}
+
+void MCWorldRenderer::buildBatches(MCCamera * camera)
+{
+    waitForBatches();
+
+    buildCameraBatches(camera);
+
+    killExpiredParticles();
+}
+
+void MCWorldRenderer::runBatchBuilder()
+{
+    std::unique_lock<std::mutex> lock(m_batchMutex);
+    while (true)
     {
-        createSurfaceParticleRenderer();
+        m_batchCondition.wait(lock, [this] () {
+            return m_hasBatchJob || m_quitBatchBuilder;
+        });
+
+        if (m_quitBatchBuilder)
+        {
+            return;
+        }
+
+        lock.unlock();
+
+        const auto start = std::chrono::steady_clock::now();
+
+        for (auto && camera : m_batchCameras)
+        {
+            buildCameraBatches(camera);
+        }
+
+        m_batchBuildNsecs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count();
+
+        lock.lock();
+
+        m_hasBatchJob = false;
+        m_batchCondition.notify_all();
     }
+}
 
-    buildObjectBatches(camera);
+void MCWorldRenderer::buildBatchesAsync(const std::vector<MCCamera *> & cameras)
+{
+    waitForBatches();
 
-    buildParticleBatches(camera);
+    // The worker is started once and then woken up for each frame
+    if (!m_batchBuilder.joinable())
+    {
+        m_batchBuilder = std::thread(&MCWorldRenderer::runBatchBuilder, this);
+    }
+
+    std::lock_guard<std::mutex> lock(m_batchMutex);
+    m_batchCameras = cameras;
+    m_hasBatchJob = true;
+    m_batchCondition.notify_all();
+}
+
+void MCWorldRenderer::waitForBatches()
+{
+    // Never wait for the worker from the worker itself
+    if (m_batchBuilder.get_id() == std::this_thread::get_id())
+    {
+        return;
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(m_batchMutex);
+        if (m_hasBatchJob)
+        {
+            const auto start = std::chrono::steady_clock::now();
+
+            m_batchCondition.wait(lock, [this] () {
+                return !m_hasBatchJob;
+            });
+
+            m_batchWaitNsecs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start).count();
+        }
+    }
+
+    killExpiredParticles();
+}
+
+void MCWorldRenderer::killExpiredParticles()
+{
+    // Dying particles are removed from the world, which may re-enter here
+    m_dyingParticles.swap(m_expiredParticles);
+    for (auto && particle : m_dyingParticles)
+    {
+        particle->die();
+    }
+
+    m_dyingParticles.clear();
+}
+
+void MCWorldRenderer::stopBatchBuilder()
+{
+    if (m_batchBuilder.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_batchMutex);
+            m_quitBatchBuilder = true;
+            m_batchCondition.notify_all();
+        }
+
+        m_batchBuilder.join();
+    }
+}
+
+int64_t MCWorldRenderer::batchBuildNsecs() const
+{
+    return m_batchBuildNsecs;
+}
+
+int64_t MCWorldRenderer::batchWaitNsecs() const
+{
+    return m_batchWaitNsecs;
 }
 
 void MCWorldRenderer::render(MCCamera * camera, MCRenderGroup renderGroup)
 {
+    waitForBatches();
+
+    createRenderers();
+
     switch (renderGroup)
     {
     case MCRenderGroup::Objects:
@@ -214,6 +336,8 @@ void MCWorldRenderer::renderObjects(MCCamera * camera)
 
     renderObjectBatches(camera, m_defaultLayer);
 
+    m_staticScenery.render(camera);
+
     glDepthMask(GL_TRUE);
 }
 
@@ -235,31 +359,94 @@ void MCWorldRenderer::renderParticles(MCCamera * camera)
     glDepthMask(GL_TRUE);
 }
 
-void MCWorldRenderer::renderObjectBatches(MCCamera * camera, MCRenderLayer & layer)
+namespace {
+//! Renders the batches with the surface object renderer and the shape views.
+class GLObjectBatchRenderer : public MCWorldRenderer::ObjectBatchRenderer
 {
-    for (auto && batch : layer.objectBatches()[camera])
+public:
+
+    GLObjectBatchRenderer(MCObjectRendererBase & surfaceObjectRenderer, MCCamera * camera)
+        : m_surfaceObjectRenderer(surfaceObjectRenderer)
+        , m_camera(camera)
+    {}
+
+    void renderCpuBatch(MCRenderLayer::ObjectBatch & batch) override
     {
-        const int itemCountInBatch = static_cast<const int>(batch.objects.size());
-        if (itemCountInBatch > 0)
-        {
-            MCObject * object = batch.objects[0];
-            std::shared_ptr<MCShapeView> view = object->shape()->view();
+        m_surfaceObjectRenderer.setBatch(batch, m_camera);
+        m_surfaceObjectRenderer.render();
+    }
+
+    void bindBatch(MCRenderLayer::ObjectBatch & batch) override
+    {
+        batch.objects[0]->shape()->view()->bind();
+    }
+
+    void renderObject(MCObject & object) override
+    {
+        object.render(m_camera);
+    }
+
+    void releaseBatch(MCRenderLayer::ObjectBatch & batch) override
+    {
+        batch.objects[0]->shape()->view()->release();
+    }
+
+private:
 
-            view->bind();
-            object->render(camera);
+    MCObjectRendererBase & m_surfaceObjectRenderer;
 
-            for (int i = 1; i < itemCountInBatch - 1; i++)
+    MCCamera * m_camera;
+};
+}
+
+void MCWorldRenderer::renderObjectBatches(MCCamera * camera, MCRenderLayer & layer)
+{
+    GLObjectBatchRenderer renderer(*m_surfaceObjectRenderer, camera);
+    renderObjectBatches(layer.objectBatches()[camera], m_cpuBatchThreshold, renderer);
+}
+
+void MCWorldRenderer::renderObjectBatches(MCObjectBatchTable & batches, int cpuBatchThreshold, ObjectBatchRenderer & renderer)
+{
+    for (auto && batch : batches)
+    {
+        if (isCpuBatched(batch, cpuBatchThreshold))
+        {
+            renderer.renderCpuBatch(batch);
+        }
+        else if (batch.objects.size())
+        {
+            renderer.bindBatch(batch);
+            for (auto && object : batch.objects)
             {
-                batch.objects[i]->render(camera);
+                renderer.renderObject(*object);
             }
-
-            object = batch.objects[itemCountInBatch - 1];
-            object->render(camera);
-            view->release();
+            renderer.releaseBatch(batch);
         }
     }
 }
 
+bool MCWorldRenderer::isCpuBatched(const MCRenderLayer::ObjectBatch & batch, int cpuBatchThreshold)
+{
+    const int itemCountInBatch = static_cast<int>(batch.objects.size());
+    return batch.isCpuBatchable && cpuBatchThreshold > 0 &&
+        itemCountInBatch >= cpuBatchThreshold && itemCountInBatch <= MAX_CPU_BATCH_SIZE;
+}
+
+int MCWorldRenderer::drawCallCount(const MCRenderLayer::ObjectBatch & batch, int cpuBatchThreshold)
+{
+    return isCpuBatched(batch, cpuBatchThreshold) ? 1 : static_cast<int>(batch.objects.size());
+}
+
+void MCWorldRenderer::setCpuBatchThreshold(int threshold)
+{
+    m_cpuBatchThreshold = threshold;
+}
+
+int MCWorldRenderer::cpuBatchThreshold() const
+{
+    return m_cpuBatchThreshold;
+}
+
 void MCWorldRenderer::createSurfaceParticleRenderer()
 {
 #ifdef __MC_GLES__
@@ -271,6 +458,29 @@ void MCWorldRenderer::createSurfaceParticleRenderer()
 #endif
 }
 
+void MCWorldRenderer::createRenderers()
+{
+    // The renderers own GL resources, so they are created on the GL thread
+    if (!m_surfaceParticleRenderer)
+    {
+        createSurfaceParticleRenderer();
+    }
+
+    if (!m_surfaceObjectRenderer)
+    {
+        createSurfaceObjectRenderer();
+    }
+}
+
+void MCWorldRenderer::createSurfaceObjectRenderer()
+{
+#ifdef __MC_GLES__
+    m_surfaceObjectRenderer = new MCSurfaceObjectRendererLegacy(MAX_CPU_BATCH_SIZE);
+#else
+    m_surfaceObjectRenderer = new MCSurfaceObjectRenderer(MAX_CPU_BATCH_SIZE);
+#endif
+}
+
 void MCWorldRenderer::renderParticleBatches(MCCamera * camera, MCRenderLayer & layer)
 {
     for (auto && batch : layer.particleBatches()[camera])
@@ -294,6 +504,8 @@ void MCWorldRenderer::renderObjectShadows(MCCamera * camera)
 
     renderObjectShadowBatches(camera, m_defaultLayer);
 
+    m_staticScenery.renderShadows(camera);
+
     glDisable(GL_BLEND);
     glDisable(GL_DEPTH_TEST);
 }
@@ -315,24 +527,25 @@ void MCWorldRenderer::renderObjectShadowBatches(MCCamera * camera, MCRenderLayer
     // Render batches
     for (auto && batch : layer.objectBatches()[camera])
     {
-        const int itemCountInBatch = static_cast<const int>(batch.objects.size());
-        if (itemCountInBatch > 0)
+        if (batch.objects.size())
         {
-            MCObject * object = batch.objects[0];
-            std::shared_ptr<MCShapeView> view = object->shape()->view();
+            MCShapeView * view = batch.objects[0]->shape()->view().get();
             if (view && view->hasShadow())
             {
-                view->bindShadow();
-                object->renderShadow(camera);
-
-                for (int i = 1; i < itemCountInBatch - 1; i++)
+                if (isCpuBatched(batch, m_cpuBatchThreshold))
                 {
-                    batch.objects[i]->renderShadow(camera);
+                    m_surfaceObjectRenderer->setBatch(batch, camera, true);
+                    m_surfaceObjectRenderer->renderShadows();
+                }
+                else
+                {
+                    view->bindShadow();
+                    for (auto && object : batch.objects)
+                    {
+                        object->renderShadow(camera);
+                    }
+                    view->releaseShadow();
                 }
-
-                object = batch.objects[itemCountInBatch - 1];
-                object->renderShadow(camera);
-                view->releaseShadow();
             }
         }
     }
@@ -369,6 +582,8 @@ void MCWorldRenderer::enableDepthMask(bool enable)
 
 void MCWorldRenderer::addObject(MCObject & object)
 {
+    waitForBatches();
+
     if (object.isParticle())
     {
         MCParticle * particle = static_cast<MCParticle *>(&object);
@@ -382,6 +597,8 @@ void MCWorldRenderer::addObject(MCObject & object)
 
 void MCWorldRenderer::removeObject(MCObject & object)
 {
+    waitForBatches();
+
     if (object.isParticle())
     {
         MCParticle * particle = static_cast<MCParticle *>(&object);
@@ -392,9 +609,18 @@ void MCWorldRenderer::removeObject(MCObject & object)
             m_particleSet.pop_back();
             particle->m_indexInRenderArray = -1;
         }
+
+        // A removed particle can be recycled, so it must not be killed later
+        m_expiredParticles.erase(
+            std::remove(m_expiredParticles.begin(), m_expiredParticles.end(), particle), m_expiredParticles.end());
     }
 }
 
+MCStaticScenery & MCWorldRenderer::staticScenery()
+{
+    return m_staticScenery;
+}
+
 void MCWorldRenderer::addParticleVisibilityCamera(MCCamera & camera)
 {
     m_visibilityCameras.push_back(&camera);
@@ -407,8 +633,14 @@ void MCWorldRenderer::removeParticleVisibilityCameras()
 
 void MCWorldRenderer::clear()
 {
+    waitForBatches();
+
+    m_expiredParticles.clear();
+
     m_defaultLayer.clear();
 
+    m_staticScenery.clear();
+
     for (auto particle : m_particleSet)
     {
         particle->m_indexInRenderArray = -1;
@@ -418,5 +650,10 @@ void MCWorldRenderer::clear()
 
 MCWorldRenderer::~MCWorldRenderer()
 {
+    waitForBatches();
+
+    stopBatchBuilder();
+
     delete m_surfaceParticleRenderer;
+    delete m_surfaceObjectRenderer;
 }
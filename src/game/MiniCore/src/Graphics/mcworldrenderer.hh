@@ -23,10 +23,15 @@
 #include "mcglscene.hh"
 #include "mcrenderlayer.hh"
 #include "mcrendergroup.hh"
+#include "mcstaticscenery.hh"
 
 #include "mcworld.hh"
 
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
 #include <set>
+#include <thread>
 #include <vector>
 
 class MCCamera;
@@ -66,12 +71,75 @@ public:
 
     void removeObject(MCObject & object);
 
+    /*! Objects that never move nor animate can be added to the static scenery,
+     *  which is rendered together with the object batches. */
+    MCStaticScenery & staticScenery();
+
     /*! Must be called before calls to render() or renderShadows() */
     void buildBatches(MCCamera * camera);
 
+    /*! Build the batches of the given cameras on a persistent worker thread.
+     *  Meanwhile the GL thread can render anything that doesn't touch the world
+     *  objects. Once built, the batches are only read by render(), which waits
+     *  for the worker. The worker doesn't modify the world: the particles found
+     *  outside all cameras are killed by waitForBatches() on the calling thread. */
+    void buildBatchesAsync(const std::vector<MCCamera *> & cameras);
+
+    /*! Wait until the batches started by buildBatchesAsync() are built.
+     *  The particles found outside all cameras are then killed. */
+    void waitForBatches();
+
+    //! \return duration of the latest batch build in nsecs.
+    int64_t batchBuildNsecs() const;
+
+    /*! \return time the latest waitForBatches() waited for the worker in nsecs.
+     *  The rest of the build overlapped with the GL thread. */
+    int64_t batchWaitNsecs() const;
+
     //! Render the given object group. \see MCRenderGroup.
     void render(MCCamera * camera, MCRenderGroup renderGroup);
 
+    /*! Batches of at least the given number of plain surface view objects
+     *  (crates, tires, cones..) are transformed on CPU and drawn with a single
+     *  draw call. Default is 16. 0 disables the CPU batching. */
+    void setCpuBatchThreshold(int threshold);
+
+    int cpuBatchThreshold() const;
+
+    //! \return true if the batch is drawn with a single CPU-transformed draw call.
+    static bool isCpuBatched(const MCRenderLayer::ObjectBatch & batch, int cpuBatchThreshold);
+
+    //! \return number of draw calls needed to render the batch.
+    static int drawCallCount(const MCRenderLayer::ObjectBatch & batch, int cpuBatchThreshold);
+
+    //! Max number of objects in a CPU-transformed batch. Larger batches are drawn object by object.
+    static const int MAX_CPU_BATCH_SIZE = 4096;
+
+    //! Submits the draws of the object batches, see renderObjectBatches().
+    class ObjectBatchRenderer
+    {
+    public:
+
+        virtual ~ObjectBatchRenderer() {}
+
+        //! Draw the whole batch with a single CPU-transformed draw call.
+        virtual void renderCpuBatch(MCRenderLayer::ObjectBatch & batch) = 0;
+
+        //! Called before the objects of a batch are drawn one by one.
+        virtual void bindBatch(MCRenderLayer::ObjectBatch & batch) = 0;
+
+        //! Draw a single object of the bound batch.
+        virtual void renderObject(MCObject & object) = 0;
+
+        //! Called after the objects of a batch have been drawn one by one.
+        virtual void releaseBatch(MCRenderLayer::ObjectBatch & batch) = 0;
+    };
+
+    /*! Render the given batches. Batches accepted by isCpuBatched() are passed to
+     *  ObjectBatchRenderer::renderCpuBatch(), the objects of other non-empty batches
+     *  to ObjectBatchRenderer::renderObject() one by one. */
+    static void renderObjectBatches(MCObjectBatchTable & batches, int cpuBatchThreshold, ObjectBatchRenderer & renderer);
+
     void clear();
 
 private:
@@ -80,8 +148,21 @@ private:
 
     void buildParticleBatches(MCCamera * camera);
 
+    void buildCameraBatches(MCCamera * camera);
+
+    void runBatchBuilder();
+
+    void stopBatchBuilder();
+
+    //! Kill the particles that buildParticleBatches() found outside all cameras.
+    void killExpiredParticles();
+
     void createSurfaceParticleRenderer();
 
+    void createSurfaceObjectRenderer();
+
+    void createRenderers();
+
     void renderObjects(MCCamera * camera);
 
     void renderObjectShadows(MCCamera * camera);
@@ -100,6 +181,8 @@ private:
 
     MCRenderLayer m_defaultLayer;
 
+    MCStaticScenery m_staticScenery;
+
     typedef std::vector<MCParticle *> ParticleSet;
     ParticleSet m_particleSet;
 
@@ -107,6 +190,30 @@ private:
 
     MCParticleRendererBase * m_surfaceParticleRenderer;
 
+    MCObjectRendererBase * m_surfaceObjectRenderer;
+
+    int m_cpuBatchThreshold;
+
+    std::vector<MCParticle *> m_expiredParticles;
+
+    std::vector<MCParticle *> m_dyingParticles;
+
+    int64_t m_batchBuildNsecs;
+
+    int64_t m_batchWaitNsecs;
+
+    std::thread m_batchBuilder;
+
+    std::mutex m_batchMutex;
+
+    std::condition_variable m_batchCondition;
+
+    std::vector<MCCamera *> m_batchCameras;
+
+    bool m_hasBatchJob;
+
+    bool m_quitBatchBuilder;
+
     MCGLScene m_glScene;
 
     friend class MCObject;
@@ -0,0 +1,120 @@
+// This file belongs to the "MiniCore" game engine.
+// Copyright (C) 2018 Jussi Lind <jussi.lind@iki.fi>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+// MA  02110-1301, USA.
+//
+
+#include "mccapsuleshape.hh"
+#include "mcmathutil.hh"
+
+#include <algorithm>
+
+unsigned int MCCapsuleShape::m_typeId = MCShape::registerType();
+
+MCCapsuleShape::MCCapsuleShape(MCShapeViewPtr view, float length, float capRadius)
+    : MCShape(view, MCShape::Kind::Capsule)
+    , m_length(std::max(length, capRadius * 2))
+    , m_capRadius(capRadius)
+{
+    setRadius(m_length / 2);
+    updateSegment();
+}
+
+void MCCapsuleShape::updateSegment()
+{
+    const MCVector2dF halfSegment(MCMathUtil::rotatedVector(MCVector2dF(m_length / 2 - m_capRadius, 0), angle()));
+    const MCVector2dF l(location());
+    m_segment = MCSegmentF(l - halfSegment, l + halfSegment);
+}
+
+void MCCapsuleShape::translate(const MCVector3dF & p)
+{
+    MCShape::translate(p);
+    updateSegment();
+}
+
+void MCCapsuleShape::rotate(float a)
+{
+    MCShape::rotate(a);
+    updateSegment();
+}
+
+MCBBoxF MCCapsuleShape::bbox() const
+{
+    return MCBBoxF(
+        std::min(m_segment.vertex0.i(), m_segment.vertex1.i()) - m_capRadius,
+        std::min(m_segment.vertex0.j(), m_segment.vertex1.j()) - m_capRadius,
+        std::max(m_segment.vertex0.i(), m_segment.vertex1.i()) + m_capRadius,
+        std::max(m_segment.vertex0.j(), m_segment.vertex1.j()) + m_capRadius);
+}
+
+bool MCCapsuleShape::contains(const MCVector2dF & p) const
+{
+    float fraction = 0;
+    return (p - MCMathUtil::closestPointOnSegment(p, m_segment, fraction)).lengthSquared() <= m_capRadius * m_capRadius;
+}
+
+float MCCapsuleShape::interpenetrationDepth(const MCSegmentF & p, MCVector2dF & contactNormal) const
+{
+    float fraction = 0;
+    const MCVector2dF closest(MCMathUtil::closestPointOnSegment(p.vertex0, m_segment, fraction));
+    contactNormal = this->contactNormal(p);
+    return m_capRadius - (p.vertex0 - closest).length();
+}
+
+MCVector2dF MCCapsuleShape::contactNormal(const MCSegmentF & p) const
+{
+    float fraction = 0;
+    const MCVector2dF closest(MCMathUtil::closestPointOnSegment(p.vertex0, m_segment, fraction));
+    const MCVector2dF normal(p.vertex0 - closest);
+    if (normal.lengthSquared() > 0)
+    {
+        return normal.normalized();
+    }
+
+    // The point is on the core segment: push it out sideways.
+    const MCVector2dF side(MCMathUtil::rotatedVector(MCVector2dF(0, 1), angle()));
+    return (p.vertex1 - closest).dot(side) < 0 ? -side : side;
+}
+
+const MCSegmentF & MCCapsuleShape::segment() const
+{
+    return m_segment;
+}
+
+float MCCapsuleShape::capRadius() const
+{
+    return m_capRadius;
+}
+
+float MCCapsuleShape::length() const
+{
+    return m_length;
+}
+
+unsigned int MCCapsuleShape::typeId()
+{
+    return m_typeId;
+}
+
+unsigned int MCCapsuleShape::instanceTypeId() const
+{
+    return m_typeId;
+}
+
+MCCapsuleShape::~MCCapsuleShape()
+{
+}
@@ -0,0 +1,95 @@
+// This file belongs to the "MiniCore" game engine.
+// Copyright (C) 2018 Jussi Lind <jussi.lind@iki.fi>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+// MA  02110-1301, USA.
+//
+
+#ifndef MCCAPSULESHAPE_HH
+#define MCCAPSULESHAPE_HH
+
+#include "mcshape.hh"
+#include "mcshapeview.hh"
+
+/*! \class MCCapsuleShape
+ *  \brief Capsule shape model
+ *
+ * Capsule shape model for an MCObject: a segment along the local x-axis that is
+ * swept by a circle. Capsules have no corners, so contacts against them stay
+ * smooth when objects slide along their ends.
+ */
+class MCCapsuleShape : public MCShape
+{
+public:
+
+    /*! Constructor
+     * \param view View for the shape. May be nullptr.
+     * \param length Total length of the capsule along the local x-axis.
+     * \param capRadius Radius of the rounded ends, i.e. half of the thickness. */
+    MCCapsuleShape(MCShapeViewPtr view, float length, float capRadius);
+
+    //! Destructor
+    virtual ~MCCapsuleShape();
+
+    //! \reimp
+    virtual void translate(const MCVector3dF & p) override;
+
+    //! \reimp
+    virtual void rotate(float a) override;
+
+    //! \reimp
+    virtual MCBBoxF bbox() const override;
+
+    //! \reimp
+    virtual bool contains(const MCVector2dF & p) const override;
+
+    //! \reimp
+    virtual float interpenetrationDepth(const MCSegmentF & p, MCVector2dF & contactNormal) const override;
+
+    //! \reimp
+    virtual MCVector2dF contactNormal(const MCSegmentF & p) const override;
+
+    //! Return the core segment between the centers of the ends in world coordinates.
+    const MCSegmentF & segment() const;
+
+    //! Return the radius of the rounded ends.
+    float capRadius() const;
+
+    //! Return the total length.
+    float length() const;
+
+    //! Return the typeId
+    static unsigned int typeId();
+
+    //! \reimp
+    virtual unsigned int instanceTypeId() const override;
+
+private:
+
+    DISABLE_COPY(MCCapsuleShape);
+    DISABLE_ASSI(MCCapsuleShape);
+
+    void updateSegment();
+
+    static unsigned int m_typeId;
+
+    float m_length;
+
+    float m_capRadius;
+
+    MCSegmentF m_segment;
+};
+
+#endif // MCCAPSULESHAPE_HH
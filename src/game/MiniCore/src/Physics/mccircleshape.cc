@@ -23,7 +23,7 @@
 unsigned int MCCircleShape::m_typeId = MCShape::registerType();
 
 MCCircleShape::MCCircleShape(MCShapeViewPtr view, float radius)
-    : MCShape(view)
+    : MCShape(view, MCShape::Kind::Circle)
 {
     setRadius(radius);
 }
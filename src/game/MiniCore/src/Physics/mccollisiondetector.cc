@@ -24,10 +24,405 @@
 #include "mcshape.hh"
 #include "mccircleshape.hh"
 #include "mcrectshape.hh"
+#include "mcpolygonshape.hh"
+#include "mccapsuleshape.hh"
 #include "mccollisionevent.hh"
+#include "mceventqueue.hh"
+#include "mcmathutil.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+/*! Shape reduced to a convex core and a rounding radius: a point for circles,
+ *  a segment for capsules and a counter-clockwise polygon for rects and polygons. */
+struct ConvexCore
+{
+    MCVector2dF vertices[MCPolygonShape::MAX_VERTICES];
+
+    //! Outward normal of the edge from the vertex of the same index to the next one.
+    MCVector2dF normals[MCPolygonShape::MAX_VERTICES];
+
+    size_t count = 0;
+
+    float radius = 0;
+};
+
+//! Contact manifold of two convex cores.
+struct ContactManifold
+{
+    //! Normal pointing from the first core to the second one.
+    MCVector2dF normal;
+
+    MCVector2dF points[2];
+
+    float depths[2];
+
+    size_t count = 0;
+};
+
+//! Separations smaller than this are considered to be touching.
+const float LINEAR_SLOP = 0.01f;
+
+void addPolygonEdgeNormals(ConvexCore & core)
+{
+    for (size_t i = 0; i < core.count; i++)
+    {
+        const MCVector2dF edge(core.vertices[(i + 1) % core.count] - core.vertices[i]);
+        core.normals[i] = MCVector2dF(edge.j(), -edge.i()).normalized();
+    }
+}
+
+void buildConvexCore(const MCShape & shape, ConvexCore & core)
+{
+    switch (shape.kind())
+    {
+    case MCShape::Kind::Rect:
+    {
+        // Vertices of MCOBBox go clockwise.
+        auto && obbox = static_cast<const MCRectShape &>(shape).obbox();
+        core.count = 4;
+        for (unsigned int i = 0; i < 4; i++)
+        {
+            core.vertices[i] = obbox.vertex((4 - i) % 4);
+        }
+        addPolygonEdgeNormals(core);
+        break;
+    }
+    case MCShape::Kind::Polygon:
+    {
+        auto && polygon = static_cast<const MCPolygonShape &>(shape);
+        core.count = polygon.vertexCount();
+        for (size_t i = 0; i < core.count; i++)
+        {
+            core.vertices[i] = polygon.vertex(i);
+            core.normals[i] = polygon.normal(i);
+        }
+        break;
+    }
+    case MCShape::Kind::Capsule:
+    {
+        auto && capsule = static_cast<const MCCapsuleShape &>(shape);
+        core.radius = capsule.capRadius();
+        core.vertices[0] = capsule.segment().vertex0;
+        core.vertices[1] = capsule.segment().vertex1;
+        core.count = (core.vertices[1] - core.vertices[0]).lengthSquared() > 0 ? 2 : 1;
+        if (core.count == 2)
+        {
+            addPolygonEdgeNormals(core);
+        }
+        break;
+    }
+    default:
+        core.count = 1;
+        core.vertices[0] = MCVector2dF(shape.location());
+        core.radius = shape.radius();
+        break;
+    }
+}
+
+//! Return the largest separation of core2 along the edge normals of core1.
+float findMaxSeparation(const ConvexCore & core1, const ConvexCore & core2, size_t & edgeIndex)
+{
+    float maxSeparation = -std::numeric_limits<float>::max();
+    for (size_t i = 0; i < core1.count; i++)
+    {
+        float separation = std::numeric_limits<float>::max();
+        for (size_t j = 0; j < core2.count; j++)
+        {
+            separation = std::min(separation, core1.normals[i].dot(core2.vertices[j] - core1.vertices[i]));
+        }
+
+        if (separation > maxSeparation)
+        {
+            maxSeparation = separation;
+            edgeIndex = i;
+        }
+    }
+
+    return maxSeparation;
+}
+
+//! Collide a rounded point against a core. The normal points from the core to the point.
+bool collidePoint(const MCVector2dF & point, float pointRadius, const ConvexCore & core, ContactManifold & manifold)
+{
+    const float totalRadius = pointRadius + core.radius;
+
+    MCVector2dF closest(core.vertices[0]);
+    if (core.count >= 3)
+    {
+        size_t edgeIndex = 0;
+        float separation = -std::numeric_limits<float>::max();
+        for (size_t i = 0; i < core.count; i++)
+        {
+            const float edgeSeparation = core.normals[i].dot(point - core.vertices[i]);
+            if (edgeSeparation > separation)
+            {
+                separation = edgeSeparation;
+                edgeIndex = i;
+            }
+        }
+
+        if (separation > totalRadius)
+        {
+            return false;
+        }
+
+        // The point is inside the polygon: push it out through the closest edge.
+        if (separation <= 0)
+        {
+            manifold.normal = core.normals[edgeIndex];
+            manifold.points[0] = point - manifold.normal * ((pointRadius - core.radius + separation) / 2);
+            manifold.depths[0] = totalRadius - separation;
+            manifold.count = 1;
+            return true;
+        }
+
+        float minDistanceSquared = std::numeric_limits<float>::max();
+        for (size_t i = 0; i < core.count; i++)
+        {
+            float fraction = 0;
+            const MCVector2dF edgePoint(MCMathUtil::closestPointOnSegment(
+                point, MCSegmentF(core.vertices[i], core.vertices[(i + 1) % core.count]), fraction));
+            const float distanceSquared = (point - edgePoint).lengthSquared();
+            if (distanceSquared < minDistanceSquared)
+            {
+                minDistanceSquared = distanceSquared;
+                closest = edgePoint;
+            }
+        }
+    }
+    else if (core.count == 2)
+    {
+        float fraction = 0;
+        closest = MCMathUtil::closestPointOnSegment(point, MCSegmentF(core.vertices[0], core.vertices[1]), fraction);
+    }
+
+    const MCVector2dF delta(point - closest);
+    const float distance = delta.length();
+    if (distance >= totalRadius)
+    {
+        return false;
+    }
+
+    manifold.normal = distance > 0 ? delta / distance : (core.count == 2 ? core.normals[0] : MCVector2dF(1, 0));
+    manifold.points[0] = (point - manifold.normal * pointRadius + closest + manifold.normal * core.radius) / 2;
+    manifold.depths[0] = totalRadius - distance;
+    manifold.count = 1;
+    return true;
+}
+
+/*! Find the closest points of segments p1-q1 and p2-q2.
+ *  \return true if both points are at the end points of the segments. */
+bool closestPointsOfSegments(
+    const MCVector2dF & p1, const MCVector2dF & q1, const MCVector2dF & p2, const MCVector2dF & q2,
+    MCVector2dF & c1, MCVector2dF & c2)
+{
+    const MCVector2dF d1(q1 - p1);
+    const MCVector2dF d2(q2 - p2);
+    const MCVector2dF r(p1 - p2);
+    const float a = d1.dot(d1);
+    const float b = d1.dot(d2);
+    const float c = d1.dot(r);
+    const float e = d2.dot(d2);
+    const float f = d2.dot(r);
+    const float denominator = a * e - b * b;
+
+    float s = denominator > 0 ? std::min(std::max((b * f - c * e) / denominator, 0.0f), 1.0f) : 0.0f;
+    float t = (b * s + f) / e;
+    if (t < 0)
+    {
+        t = 0;
+        s = std::min(std::max(-c / a, 0.0f), 1.0f);
+    }
+    else if (t > 1)
+    {
+        t = 1;
+        s = std::min(std::max((b - c) / a, 0.0f), 1.0f);
+    }
+
+    c1 = p1 + d1 * s;
+    c2 = p2 + d2 * t;
+
+    return (s == 0 || s == 1) && (t == 0 || t == 1);
+}
+
+/*! Collide two cores that both have edges. The reference edge is the one with the
+ *  largest separation and the incident edge is clipped against its side planes.
+ *  This gives at most two contact points. */
+bool collidePolygons(const ConvexCore & core1, const ConvexCore & core2, ContactManifold & manifold)
+{
+    const float totalRadius = core1.radius + core2.radius;
+
+    size_t edge1 = 0;
+    const float separation1 = findMaxSeparation(core1, core2, edge1);
+    if (separation1 > totalRadius)
+    {
+        return false;
+    }
+
+    size_t edge2 = 0;
+    const float separation2 = findMaxSeparation(core2, core1, edge2);
+    if (separation2 > totalRadius)
+    {
+        return false;
+    }
+
+    // Prefer core1 as the reference to keep the manifold stable between steps.
+    const bool flip = separation2 > separation1 + LINEAR_SLOP;
+    const ConvexCore & ref = flip ? core2 : core1;
+    const ConvexCore & inc = flip ? core1 : core2;
+    const size_t refEdge = flip ? edge2 : edge1;
+    const float separation = flip ? separation2 : separation1;
+
+    MCVector2dF normal(ref.normals[refEdge]);
+
+    // Find the incident edge that is the most anti-parallel to the reference normal.
+    size_t incEdge = 0;
+    float minDot = std::numeric_limits<float>::max();
+    for (size_t i = 0; i < inc.count; i++)
+    {
+        const float dot = normal.dot(inc.normals[i]);
+        if (dot < minDot)
+        {
+            minDot = dot;
+            incEdge = i;
+        }
+    }
+
+    const MCVector2dF v11(ref.vertices[refEdge]);
+    const MCVector2dF v12(ref.vertices[(refEdge + 1) % ref.count]);
+    const MCVector2dF v21(inc.vertices[incEdge]);
+    const MCVector2dF v22(inc.vertices[(incEdge + 1) % inc.count]);
+
+    const MCVector2dF tangent((v12 - v11).normalized());
+
+    // Cores that are apart may be too far from each other beyond the ends of the
+    // edges (e.g. collinear capsules) or touch only at their corners.
+    if (separation > -LINEAR_SLOP)
+    {
+        MCVector2dF c1, c2;
+        const bool vertexToVertex = closestPointsOfSegments(v11, v12, v21, v22, c1, c2);
+        const MCVector2dF delta(c2 - c1);
+        const float distance = delta.length();
+        if (distance >= totalRadius)
+        {
+            return false;
+        }
+
+        // Parallel edges that face each other are clipped below.
+        if (vertexToVertex && std::abs(delta.dot(tangent)) > LINEAR_SLOP)
+        {
+            normal = delta / distance;
+            manifold.normal = flip ? -normal : normal;
+            manifold.points[0] = (c1 + normal * ref.radius + c2 - normal * inc.radius) / 2;
+            manifold.depths[0] = totalRadius - distance;
+            manifold.count = 1;
+            return true;
+        }
+
+        // Edges that touch end to end give no direction, so push along the reference edge.
+        if (distance <= LINEAR_SLOP)
+        {
+            const float inc1 = (v21 - v11).dot(tangent);
+            const float inc2 = (v22 - v11).dot(tangent);
+            const float refLength = (v12 - v11).dot(tangent);
+            const bool beyondEnd = std::min(inc1, inc2) >= refLength - LINEAR_SLOP;
+            if (beyondEnd || std::max(inc1, inc2) <= LINEAR_SLOP)
+            {
+                normal = beyondEnd ? tangent : -tangent;
+                manifold.normal = flip ? -normal : normal;
+                manifold.points[0] = (c1 + normal * ref.radius + c2 - normal * inc.radius) / 2;
+                manifold.depths[0] = totalRadius - distance;
+                manifold.count = 1;
+                return true;
+            }
+        }
+    }
+
+    // Clip the incident edge against the side planes of the reference edge.
+    // The incident edge runs in the opposite direction.
+    const float lower1 = 0;
+    const float upper1 = (v12 - v11).dot(tangent);
+    const float upper2 = (v21 - v11).dot(tangent);
+    const float lower2 = (v22 - v11).dot(tangent);
+
+    MCVector2dF vLower(v22);
+    MCVector2dF vUpper(v21);
+    if (upper2 - lower2 > std::numeric_limits<float>::epsilon())
+    {
+        if (lower2 < lower1)
+        {
+            vLower = v22 + (v21 - v22) * ((lower1 - lower2) / (upper2 - lower2));
+        }
+
+        if (upper2 > upper1)
+        {
+            vUpper = v22 + (v21 - v22) * ((upper1 - lower2) / (upper2 - lower2));
+        }
+    }
+
+    manifold.count = 0;
+    for (auto && incVertex : {vLower, vUpper})
+    {
+        const float vertexSeparation = (incVertex - v11).dot(normal);
+        const float depth = totalRadius - vertexSeparation;
+        if (depth > 0)
+        {
+            manifold.points[manifold.count] = incVertex + normal * ((ref.radius - inc.radius - vertexSeparation) / 2);
+            manifold.depths[manifold.count] = depth;
+            manifold.count++;
+        }
+    }
+
+    manifold.normal = flip ? -normal : normal;
+    return manifold.count > 0;
+}
+
+bool collideCores(const ConvexCore & core1, const ConvexCore & core2, ContactManifold & manifold)
+{
+    if (core1.count == 1)
+    {
+        if (!collidePoint(core1.vertices[0], core1.radius, core2, manifold))
+        {
+            return false;
+        }
+
+        manifold.normal = -manifold.normal;
+        return true;
+    }
+
+    if (core2.count == 1)
+    {
+        return collidePoint(core2.vertices[0], core2.radius, core1, manifold);
+    }
+
+    return collidePolygons(core1, core2, manifold);
+}
+
+//! Polygons and capsules are tested with the manifold test against all but custom shapes.
+constexpr bool usesConvexTest(MCShape::Kind kind1, MCShape::Kind kind2)
+{
+    return kind1 != MCShape::Kind::Custom && kind2 != MCShape::Kind::Custom &&
+        (kind1 == MCShape::Kind::Polygon || kind1 == MCShape::Kind::Capsule ||
+         kind2 == MCShape::Kind::Polygon || kind2 == MCShape::Kind::Capsule);
+}
+
+/*! The broadphases list every pair in both orderings, but the convex test creates
+ *  the contacts and the events of both shapes at once. \return true for the ordering
+ *  that is tested. */
+bool isTestedOrdering(MCShape::Kind kind1, MCShape::Kind kind2, const MCShape & shape1, const MCShape & shape2)
+{
+    return kind1 < kind2 || (kind1 == kind2 && &shape1 < &shape2);
+}
+
+} // namespace
 
 MCCollisionDetector::MCCollisionDetector()
 : m_arePrimaryCollisionEventsEnabled(true)
+, m_collisionEvents(MCEventQueue<MCCollisionEvent>::instance())
 {}
 
 void MCCollisionDetector::enablePrimaryCollisionEvents(bool enable)
@@ -48,15 +443,11 @@ bool MCCollisionDetector::testRectAgainstRect(MCRectShape & rect1, MCRectShape &
         {
             const bool triggerObjectInvolved = rect1.parent().isTriggerObject() || rect2.parent().isTriggerObject();
 
-            // Send collision event to owner of rect1
-            MCCollisionEvent ev1(rect2.parent(), obbox1.vertex(i), m_arePrimaryCollisionEventsEnabled);
-            MCObject::sendEvent(rect1.parent(), ev1);
-
-            // Send collision event to owner of rect2
-            MCCollisionEvent ev2(rect1.parent(), obbox1.vertex(i), m_arePrimaryCollisionEventsEnabled);
-            MCObject::sendEvent(rect2.parent(), ev2);
+            // Queue collision events to the owners of rect1 and rect2
+            m_collisionEvents.post(rect1.parent(), rect2.parent(), obbox1.vertex(i), m_arePrimaryCollisionEventsEnabled);
+            m_collisionEvents.post(rect2.parent(), rect1.parent(), obbox1.vertex(i), m_arePrimaryCollisionEventsEnabled);
 
-            if (!triggerObjectInvolved && (ev1.accepted() && ev2.accepted())) // Trigger objects should only trigger events
+            if (!triggerObjectInvolved) // Trigger objects should only trigger events
             {
                 MCVector2dF contactNormal;
                 MCVector2dF vertex = obbox1.vertex(i);
@@ -113,15 +504,11 @@ bool MCCollisionDetector::testRectAgainstCircle(MCRectShape & rect, MCCircleShap
         {
             const bool triggerObjectInvolved = rect.parent().isTriggerObject() || circle.parent().isTriggerObject();
 
-            // Send collision event to owner of circle
-            MCCollisionEvent ev1(rect.parent(), circleVertex, m_arePrimaryCollisionEventsEnabled);
-            MCObject::sendEvent(circle.parent(), ev1);
-
-            // Send collision event to owner of rect
-            MCCollisionEvent ev2(circle.parent(), circleVertex, m_arePrimaryCollisionEventsEnabled);
-            MCObject::sendEvent(rect.parent(), ev2);
+            // Queue collision events to the owners of circle and rect
+            m_collisionEvents.post(circle.parent(), rect.parent(), circleVertex, m_arePrimaryCollisionEventsEnabled);
+            m_collisionEvents.post(rect.parent(), circle.parent(), circleVertex, m_arePrimaryCollisionEventsEnabled);
 
-            if (!triggerObjectInvolved && (ev1.accepted() && ev2.accepted())) // Trigger objects should only trigger events
+            if (!triggerObjectInvolved) // Trigger objects should only trigger events
             {
                 MCVector2dF contactNormal;
                 float depth = rect.interpenetrationDepth(
@@ -161,15 +548,11 @@ bool MCCollisionDetector::testCircleAgainstCircle(MCCircleShape & circle1, MCCir
     {
         const bool triggerObjectInvolved = circle1.parent().isTriggerObject() || circle2.parent().isTriggerObject();
 
-        // Send collision event to owner of circle2
-        MCCollisionEvent ev1(circle1.parent(), contactPoint, m_arePrimaryCollisionEventsEnabled);
-        MCObject::sendEvent(circle2.parent(), ev1);
+        // Queue collision events to the owners of circle2 and circle1
+        m_collisionEvents.post(circle2.parent(), circle1.parent(), contactPoint, m_arePrimaryCollisionEventsEnabled);
+        m_collisionEvents.post(circle1.parent(), circle2.parent(), contactPoint, m_arePrimaryCollisionEventsEnabled);
 
-        // Send collision event to owner of circle1
-        MCCollisionEvent ev2(circle2.parent(), contactPoint, m_arePrimaryCollisionEventsEnabled);
-        MCObject::sendEvent(circle1.parent(), ev2);
-
-        if (!triggerObjectInvolved && (ev1.accepted() && ev2.accepted())) // Trigger objects should only trigger events
+        if (!triggerObjectInvolved) // Trigger objects should only trigger events
         {
             {
                 MCContact & contact = MCContact::create();
@@ -179,7 +562,7 @@ bool MCCollisionDetector::testCircleAgainstCircle(MCCircleShape & circle1, MCCir
 
             {
                 MCContact & contact = MCContact::create();
-                contact.init(circle1.parent(), contactPoint, contactNormal, depth);
+                contact.init(circle2.parent(), contactPoint, contactNormal, depth);
                 circle1.parent().addContact(contact);
             }
 
@@ -190,56 +573,164 @@ bool MCCollisionDetector::testCircleAgainstCircle(MCCircleShape & circle1, MCCir
     return collided;
 }
 
-bool MCCollisionDetector::processPossibleCollision(MCObject & object1, MCObject & object2)
+bool MCCollisionDetector::testConvexShapes(MCShape & shape1, MCShape & shape2)
 {
-    const unsigned int id1 = object1.shape()->instanceTypeId();
-    const unsigned int id2 = object2.shape()->instanceTypeId();
+    ConvexCore core1;
+    buildConvexCore(shape1, core1);
+
+    ConvexCore core2;
+    buildConvexCore(shape2, core2);
 
-    // Rect against rect
-    if (id1 == MCRectShape::typeId() && id2 == MCRectShape::typeId())
+    ContactManifold manifold;
+    if (!collideCores(core1, core2, manifold))
     {
-        // We must test first object1 against object2 and then
-        // the other way around.
-        if (testRectAgainstRect(
-            // Static cast because we know the types now.
-            *static_cast<MCRectShape *>(object1.shape().get()),
-            *static_cast<MCRectShape *>(object2.shape().get())))
-        {
-            return true;
-        }
-        else if (testRectAgainstRect(
-            // Static cast because we know the types now.
-            *static_cast<MCRectShape *>(object2.shape().get()),
-            *static_cast<MCRectShape *>(object1.shape().get())))
+        return false;
+    }
+
+    const bool triggerObjectInvolved = shape1.parent().isTriggerObject() || shape2.parent().isTriggerObject();
+
+    for (size_t i = 0; i < manifold.count; i++)
+    {
+        // Queue collision events to the owners of shape1 and shape2
+        m_collisionEvents.post(shape1.parent(), shape2.parent(), manifold.points[i], m_arePrimaryCollisionEventsEnabled);
+        m_collisionEvents.post(shape2.parent(), shape1.parent(), manifold.points[i], m_arePrimaryCollisionEventsEnabled);
+
+        if (!triggerObjectInvolved) // Trigger objects should only trigger events
         {
-            return true;
+            {
+                MCContact & contact = MCContact::create();
+                contact.init(shape2.parent(), manifold.points[i], -manifold.normal, manifold.depths[i]);
+                shape1.parent().addContact(contact);
+            }
+
+            {
+                MCContact & contact = MCContact::create();
+                contact.init(shape1.parent(), manifold.points[i], manifold.normal, manifold.depths[i]);
+                shape2.parent().addContact(contact);
+            }
         }
     }
-    // Rect against circle
-    else if (id1 == MCRectShape::typeId() && id2 == MCCircleShape::typeId())
+
+    return !triggerObjectInvolved;
+}
+
+template<MCShape::Kind Kind1, MCShape::Kind Kind2>
+bool MCCollisionDetector::testShapes(MCCollisionDetector & detector, MCShape & shape1, MCShape & shape2)
+{
+    return usesConvexTest(Kind1, Kind2) && isTestedOrdering(Kind1, Kind2, shape1, shape2) &&
+        detector.testConvexShapes(shape1, shape2);
+}
+
+template<>
+bool MCCollisionDetector::testShapes<MCShape::Kind::Rect, MCShape::Kind::Rect>(
+    MCCollisionDetector & detector, MCShape & shape1, MCShape & shape2)
+{
+    // Static casts because we know the types now.
+    auto && rect1 = static_cast<MCRectShape &>(shape1);
+    auto && rect2 = static_cast<MCRectShape &>(shape2);
+
+    // We must test first rect1 against rect2 and then the other way around.
+    return detector.testRectAgainstRect(rect1, rect2) || detector.testRectAgainstRect(rect2, rect1);
+}
+
+template<>
+bool MCCollisionDetector::testShapes<MCShape::Kind::Rect, MCShape::Kind::Circle>(
+    MCCollisionDetector & detector, MCShape & shape1, MCShape & shape2)
+{
+    return detector.testRectAgainstCircle(static_cast<MCRectShape &>(shape1), static_cast<MCCircleShape &>(shape2));
+}
+
+template<>
+bool MCCollisionDetector::testShapes<MCShape::Kind::Circle, MCShape::Kind::Rect>(
+    MCCollisionDetector &, MCShape &, MCShape &)
+{
+    // The pair is also listed as rect against circle, which creates the contacts of both.
+    return false;
+}
+
+template<>
+bool MCCollisionDetector::testShapes<MCShape::Kind::Circle, MCShape::Kind::Circle>(
+    MCCollisionDetector & detector, MCShape & shape1, MCShape & shape2)
+{
+    return detector.testCircleAgainstCircle(static_cast<MCCircleShape &>(shape1), static_cast<MCCircleShape &>(shape2));
+}
+
+static_assert(static_cast<int>(MCShape::Kind::Count) == 5, "Add the new shape kind to the narrowphase dispatch table");
+
+const MCCollisionDetector::NarrowphaseTest MCCollisionDetector::m_narrowphaseTests[KIND_COUNT][KIND_COUNT] =
+{
+    {
+        &testShapes<MCShape::Kind::Custom, MCShape::Kind::Custom>,
+        &testShapes<MCShape::Kind::Custom, MCShape::Kind::Rect>,
+        &testShapes<MCShape::Kind::Custom, MCShape::Kind::Circle>,
+        &testShapes<MCShape::Kind::Custom, MCShape::Kind::Polygon>,
+        &testShapes<MCShape::Kind::Custom, MCShape::Kind::Capsule>
+    },
+    {
+        &testShapes<MCShape::Kind::Rect, MCShape::Kind::Custom>,
+        &testShapes<MCShape::Kind::Rect, MCShape::Kind::Rect>,
+        &testShapes<MCShape::Kind::Rect, MCShape::Kind::Circle>,
+        &testShapes<MCShape::Kind::Rect, MCShape::Kind::Polygon>,
+        &testShapes<MCShape::Kind::Rect, MCShape::Kind::Capsule>
+    },
+    {
+        &testShapes<MCShape::Kind::Circle, MCShape::Kind::Custom>,
+        &testShapes<MCShape::Kind::Circle, MCShape::Kind::Rect>,
+        &testShapes<MCShape::Kind::Circle, MCShape::Kind::Circle>,
+        &testShapes<MCShape::Kind::Circle, MCShape::Kind::Polygon>,
+        &testShapes<MCShape::Kind::Circle, MCShape::Kind::Capsule>
+    },
+    {
+        &testShapes<MCShape::Kind::Polygon, MCShape::Kind::Custom>,
+        &testShapes<MCShape::Kind::Polygon, MCShape::Kind::Rect>,
+        &testShapes<MCShape::Kind::Polygon, MCShape::Kind::Circle>,
+        &testShapes<MCShape::Kind::Polygon, MCShape::Kind::Polygon>,
+        &testShapes<MCShape::Kind::Polygon, MCShape::Kind::Capsule>
+    },
     {
-        // Static cast because we know the types now.
-        return testRectAgainstCircle(
-            *static_cast<MCRectShape *>(object1.shape().get()),
-            *static_cast<MCCircleShape *>(object2.shape().get()));
+        &testShapes<MCShape::Kind::Capsule, MCShape::Kind::Custom>,
+        &testShapes<MCShape::Kind::Capsule, MCShape::Kind::Rect>,
+        &testShapes<MCShape::Kind::Capsule, MCShape::Kind::Circle>,
+        &testShapes<MCShape::Kind::Capsule, MCShape::Kind::Polygon>,
+        &testShapes<MCShape::Kind::Capsule, MCShape::Kind::Capsule>
     }
-    // Circle against circle
-    else if (id1 == MCCircleShape::typeId() && id2 == MCCircleShape::typeId())
+};
+
+bool MCCollisionDetector::processPossibleCollision(MCObject & object1, MCObject & object2)
+{
+    MCShape & shape1 = *object1.shape();
+    MCShape & shape2 = *object2.shape();
+
+    return m_narrowphaseTests[static_cast<int>(shape1.kind())][static_cast<int>(shape2.kind())](*this, shape1, shape2);
+}
+
+bool MCCollisionDetector::testOverlap(MCShape & shape1, MCShape & shape2)
+{
+    if (shape1.kind() == MCShape::Kind::Custom || shape2.kind() == MCShape::Kind::Custom)
     {
-        // Static cast because we know the types now.
-        return testCircleAgainstCircle(
-            *static_cast<MCCircleShape *>(object1.shape().get()),
-            *static_cast<MCCircleShape *>(object2.shape().get()));
+        return false;
     }
 
-    return false;
+    ConvexCore core1;
+    buildConvexCore(shape1, core1);
+
+    ConvexCore core2;
+    buildConvexCore(shape2, core2);
+
+    ContactManifold manifold;
+    return collideCores(core1, core2, manifold);
 }
 
 unsigned int MCCollisionDetector::detectCollisions(MCObjectGrid & objectGrid)
+{
+    return detectCollisions(objectGrid.getPossibleCollisions());
+}
+
+unsigned int MCCollisionDetector::detectCollisions(const std::vector<std::pair<MCObject *, MCObject *> > & possibleCollisions)
 {
     unsigned int numCollisions = 0;
 
-    for (auto && iter : objectGrid.getPossibleCollisions())
+    for (auto && iter : possibleCollisions)
     {
         numCollisions += processPossibleCollision(*iter.first, *iter.second);
     }
@@ -21,12 +21,16 @@
 #define MCCOLLISIONDETECTOR_HH
 
 #include "mcmacros.hh"
+#include "mcshape.hh"
 
-
-
+#include <utility>
 #include <vector>
 
+template<typename EventType>
+class MCEventQueue;
+
 class MCCircleShape;
+class MCCollisionEvent;
 class MCObject;
 class MCObjectGrid;
 class MCRectShape;
@@ -44,13 +48,38 @@ public:
     //! Detect collisions and generate contacts. Contacts are stored to MCObject.
     unsigned int detectCollisions(MCObjectGrid & objectGrid);
 
+    /*! Detect collisions of the given possible collisions, e.g. the ones got from MCObjectGrid
+     *  or MCStaticBroadphase, and generate contacts. */
+    unsigned int detectCollisions(const std::vector<std::pair<MCObject *, MCObject *> > & possibleCollisions);
+
     /*! Turn primary collision events on/off. This is used by MCWorld when iterating
      *  the collision resolution. */
     void enablePrimaryCollisionEvents(bool enable);
 
+    /*! Run the narrowphase test for the given objects and generate contacts.
+     *  The test is selected by the shape kinds of the objects.
+     *  \return true if the objects collided. */
+    bool processPossibleCollision(MCObject & object1, MCObject & object2);
+
+    /*! Test if the given shapes overlap without generating contacts nor events.
+     *  Custom shapes never overlap.
+     *  \return true if the shapes overlap. */
+    static bool testOverlap(MCShape & shape1, MCShape & shape2);
+
 private:
 
-    bool processPossibleCollision(MCObject & object1, MCObject & object2);
+    typedef bool (*NarrowphaseTest)(MCCollisionDetector & detector, MCShape & shape1, MCShape & shape2);
+
+    static const int KIND_COUNT = static_cast<int>(MCShape::Kind::Count);
+
+    /*! Narrowphase test for the given shape kinds. The generic version runs the
+     *  manifold test for polygons and capsules and it's specialized for the
+     *  legacy rect and circle pairs. Custom shapes don't collide. */
+    template<MCShape::Kind Kind1, MCShape::Kind Kind2>
+    static bool testShapes(MCCollisionDetector & detector, MCShape & shape1, MCShape & shape2);
+
+    //! Dispatch table of the narrowphase tests indexed by the shape kinds.
+    static const NarrowphaseTest m_narrowphaseTests[KIND_COUNT][KIND_COUNT];
 
     bool testRectAgainstRect(MCRectShape & object1, MCRectShape & object2);
 
@@ -58,8 +87,14 @@ private:
 
     bool testCircleAgainstCircle(MCCircleShape & object1, MCCircleShape & object2);
 
+    /*! Test two shapes as rounded convex polygons with the separating axis test
+     *  and generate contacts for the clipped contact manifold. */
+    bool testConvexShapes(MCShape & shape1, MCShape & shape2);
+
     bool m_arePrimaryCollisionEventsEnabled;
 
+    MCEventQueue<MCCollisionEvent> & m_collisionEvents;
+
     DISABLE_COPY(MCCollisionDetector);
     DISABLE_ASSI(MCCollisionDetector);
 };
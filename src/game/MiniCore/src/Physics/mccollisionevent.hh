@@ -28,10 +28,11 @@ class MCObject;
 /*! \class MCCollisionEvent
  *  \brief Event sent when two objects collides.
  *
- *  The receiving object must accept the event in their
- *  event handlers (event() or collisionEvent()) in order to
- *  trigger collision physics. This way objects can filter
- *  with which objects they want to collide.
+ *  Collision events are queued in MCEventQueue during the world step
+ *  and delivered after it to the objects that have subscribed via
+ *  MCObject::subscribeCollisionEvent(). The events don't affect the
+ *  collision physics: use collision layers and trigger objects to
+ *  filter with which objects an object collides.
  */
 class MCCollisionEvent : public MCEvent
 {
@@ -62,7 +63,6 @@ public:
 
 private:
 
-    DISABLE_COPY(MCCollisionEvent);
     DISABLE_ASSI(MCCollisionEvent);
 
     MCObject & m_collidingObject;
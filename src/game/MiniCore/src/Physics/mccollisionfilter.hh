@@ -0,0 +1,92 @@
+// This file belongs to the "MiniCore" game engine.
+// Copyright (C) 2018 Jussi Lind <jussi.lind@iki.fi>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+// MA  02110-1301, USA.
+//
+
+#ifndef MCCOLLISIONFILTER_HH
+#define MCCOLLISIONFILTER_HH
+
+#include <cassert>
+
+/*! A compact collision filter stored with the broadphase entries so that most
+ *  of the pairs can be rejected without touching the objects.
+ *
+ *  The low half of the bits maps the collision layers and the high half the
+ *  collision tags of MCObject and MCPhysicsComponent. Two objects may collide
+ *  if both halves match both ways, unless they share a non-zero group:
+ *  objects sharing a positive group always collide and objects sharing a
+ *  negative group never collide. A default-constructed filter never collides. */
+struct MCCollisionFilter
+{
+    //! Number of collision layers that can be mapped.
+    static const int MAX_LAYERS = 16;
+
+    //! Number of collision tags that can be mapped.
+    static const int MAX_TAGS = 16;
+
+    static const unsigned int LAYER_BITS = 0x0000ffff;
+
+    static const unsigned int TAG_BITS = 0xffff0000;
+
+    //! Constructor. The filter doesn't collide with anything.
+    MCCollisionFilter()
+    {}
+
+    /*! Constructor.
+     *  \param layer Collision layer 0..15 or -1 for all layers.
+     *  \param tag Collision tag 0..15.
+     *  \param neverCollideWithTag Tag 0..15 of the objects never collided with or -1 for none.
+     *  \param group Collision group. */
+    MCCollisionFilter(int layer, int tag, int neverCollideWithTag, int group_)
+    : group(group_)
+    {
+        assert(layer >= -1 && layer < MAX_LAYERS);
+        assert(tag >= 0 && tag < MAX_TAGS);
+        assert(neverCollideWithTag >= -1 && neverCollideWithTag < MAX_TAGS);
+
+        categoryBits = (layer == -1 ? LAYER_BITS : 1u << layer) | (1u << (tag + MAX_LAYERS));
+        maskBits = (layer == -1 ? LAYER_BITS : 1u << layer) | TAG_BITS;
+
+        if (neverCollideWithTag != -1)
+        {
+            maskBits &= ~(1u << (neverCollideWithTag + MAX_LAYERS));
+        }
+    }
+
+    //! \return true if the objects of the filters may collide.
+    bool shouldCollide(const MCCollisionFilter & other) const
+    {
+        if (group != 0 && group == other.group)
+        {
+            return group > 0;
+        }
+
+        const unsigned int ab = categoryBits & other.maskBits;
+        const unsigned int ba = other.categoryBits & maskBits;
+        return (ab & LAYER_BITS) && (ab & TAG_BITS) && (ba & LAYER_BITS) && (ba & TAG_BITS);
+    }
+
+    //! Categories (layers and the tag) of the object.
+    unsigned int categoryBits = 0;
+
+    //! Categories the object collides with.
+    unsigned int maskBits = 0;
+
+    int group = 0;
+};
+
+#endif // MCCOLLISIONFILTER_HH
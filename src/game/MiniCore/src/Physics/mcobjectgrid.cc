@@ -78,13 +78,18 @@ void MCObjectGrid::insert(MCObject & object)
     setIndexRange(object.shape()->bbox());
     object.cacheIndexRange(m_i0, m_i1, m_j0, m_j1);
 
+    const GridEntry entry = {&object, object.collisionFilter()};
     for (unsigned int j = m_j0; j <= m_j1; j++)
     {
         for (unsigned int i = m_i0; i <= m_i1; i++)
         {
             const int index = j * m_horSize + i;
             GridCell * cell = m_matrix[index];
-            cell->m_objects.insert(&object);
+            auto && objects = cell->m_objects;
+            if (std::none_of(objects.begin(), objects.end(), [&object] (const GridEntry & e) { return e.m_object == &object; }))
+            {
+                objects.push_back(entry);
+            }
             m_dirtyCellCache.insert(cell);
         }
     }
@@ -106,10 +111,13 @@ bool MCObjectGrid::remove(MCObject & object)
         {
             const int index = j * m_horSize + i;
             GridCell * cell = m_matrix[index];
-            const auto iter = cell->m_objects.find(&object);
-            if (iter != cell->m_objects.end())
+            auto && objects = cell->m_objects;
+            const auto iter = std::find_if(objects.begin(), objects.end(), [&object] (const GridEntry & e) { return e.m_object == &object; });
+            if (iter != objects.end())
             {
-                cell->m_objects.erase(iter);
+                // The order of the entries doesn't matter (O(1))
+                *iter = objects.back();
+                objects.pop_back();
                 removed = true;
 
                 if (!cell->m_objects.size())
@@ -173,19 +181,21 @@ const MCObjectGrid::CollisionVector & MCObjectGrid::getPossibleCollisions()
         const auto end = objects.end();
         for (auto && objIter1 = objects.begin(); objIter1 != end; objIter1++)
         {
-            auto * obj1 = *objIter1;
+            auto * obj1 = objIter1->m_object;
             for (auto && objIter2 = std::next(objIter1); objIter2 != end; objIter2++)
             {
-                auto * obj2 = *objIter2; // Note that ob1 != obj2 always holds
+                // The filter covers the layers, the tags and the physics, trigger and
+                // bypass flags, so most of the pairs are rejected here.
+                if (!objIter1->m_filter.shouldCollide(objIter2->m_filter))
+                {
+                    continue;
+                }
+
+                auto * obj2 = objIter2->m_object; // Note that ob1 != obj2 always holds
                 if (&obj1->parent() != obj2 &&
                     &obj2->parent() != obj1 &&
                     (!obj1->physicsComponent().isSleeping() || !obj2->physicsComponent().isSleeping()) &&
-                    (obj1->isPhysicsObject() || obj1->isTriggerObject()) && !obj1->bypassCollisions() &&
-                    (obj2->isPhysicsObject() || obj2->isTriggerObject()) && !obj2->bypassCollisions() &&
-                    obj1->physicsComponent().neverCollideWithTag() != obj2->physicsComponent().collisionTag() &&
-                    obj2->physicsComponent().neverCollideWithTag() != obj1->physicsComponent().collisionTag() &&
-                    (obj1->collisionLayer() == obj2->collisionLayer() || obj1->collisionLayer() == -1 || obj2->collisionLayer() == -1) &&
-                    obj1->shape()->mayIntersect(*obj2->shape().get()))
+                    obj1->shape()->mayIntersect(*obj2->shape()))
                 {
                     collisions.push_back({obj1, obj2});
                     collisions.push_back({obj2, obj1});
@@ -229,8 +239,9 @@ const MCObjectGrid::ObjectSet & MCObjectGrid::getObjectsWithinBBox(const MCBBox<
         for (unsigned int i = m_i0; i <= m_i1; i++)
         {
             const int index = j * m_horSize + i;
-            for (auto && obj : m_matrix[index]->m_objects)
+            for (auto && entry : m_matrix[index]->m_objects)
             {
+                MCObject * obj = entry.m_object;
                 if (obj->shape()->view())
                 {
                     if (bbox.intersects(obj->shape()->view()->bbox().translated(MCVector2dF(obj->location()))))
@@ -21,6 +21,7 @@
 #define MCOBJECTGRID_HH
 
 #include "mcbbox.hh"
+#include "mccollisionfilter.hh"
 #include "mcmacros.hh"
 #include "mcobject.hh"
 
@@ -39,10 +40,18 @@ public:
     typedef std::set<MCObject *> ObjectSet;
     typedef std::vector<std::pair<MCObject *, MCObject *> > CollisionVector;
 
+    //! Object and a copy of its collision filter so that pairs can be rejected without touching the objects.
+    struct GridEntry
+    {
+        MCObject * m_object;
+
+        MCCollisionFilter m_filter;
+    };
+
     //! Container for objects.
     struct GridCell
     {
-        ObjectSet m_objects;
+        std::vector<GridEntry> m_objects;
     };
 
     /*! Constructor.
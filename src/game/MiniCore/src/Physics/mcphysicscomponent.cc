@@ -384,6 +384,7 @@ void MCPhysicsComponent::reset()
 void MCPhysicsComponent::setCollisionTag(int tag)
 {
     m_collisionTag = tag;
+    object().updateCollisionFilter();
 }
 
 int MCPhysicsComponent::collisionTag() const
@@ -394,6 +395,7 @@ int MCPhysicsComponent::collisionTag() const
 void MCPhysicsComponent::setNeverCollideWithTag(int tag)
 {
     m_neverCollideWithTag = tag;
+    object().updateCollisionFilter();
 }
 
 int MCPhysicsComponent::neverCollideWithTag() const
@@ -161,6 +161,7 @@ public:
 
     /*! Set an optional "tag" used in collision detection. This can be used to
      *  efficiently filter collisions before sending collision events to objects.
+     *  The tag must be in the range 0..MCCollisionFilter::MAX_TAGS - 1.
      *  \see setNeverCollideWithTag() */
     void setCollisionTag(int tag);
 
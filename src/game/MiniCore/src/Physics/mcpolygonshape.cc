@@ -0,0 +1,177 @@
+// This file belongs to the "MiniCore" game engine.
+// Copyright (C) 2018 Jussi Lind <jussi.lind@iki.fi>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+// MA  02110-1301, USA.
+//
+
+#include "mcpolygonshape.hh"
+#include "mcmathutil.hh"
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+
+unsigned int MCPolygonShape::m_typeId = MCShape::registerType();
+
+MCPolygonShape::MCPolygonShape(MCShapeViewPtr view, const VertexVector & vertices)
+    : MCShape(view, MCShape::Kind::Polygon)
+    , m_localVertices(vertices)
+    , m_vertices(vertices)
+    , m_normals(vertices.size())
+{
+    assert(vertices.size() >= 3 && vertices.size() <= MAX_VERTICES);
+
+    float radius = 0;
+    for (size_t i = 0; i < m_localVertices.size(); i++)
+    {
+        const MCVector2dF edge(m_localVertices[(i + 1) % m_localVertices.size()] - m_localVertices[i]);
+        m_localNormals.push_back(MCVector2dF(edge.j(), -edge.i()).normalized());
+        radius = std::max(radius, m_localVertices[i].length());
+    }
+
+    setRadius(radius);
+    updateVertices();
+}
+
+MCPolygonShape::VertexVector MCPolygonShape::chamferedRect(float width, float height, float chamfer)
+{
+    const float hx = width / 2;
+    const float hy = height / 2;
+    const float c = std::min(chamfer, std::min(hx, hy));
+
+    if (c <= 0)
+    {
+        return {MCVector2dF(-hx, -hy), MCVector2dF(hx, -hy), MCVector2dF(hx, hy), MCVector2dF(-hx, hy)};
+    }
+
+    return {
+        MCVector2dF(-hx + c, -hy), MCVector2dF(hx - c, -hy), MCVector2dF(hx, -hy + c), MCVector2dF(hx, hy - c),
+        MCVector2dF(hx - c, hy), MCVector2dF(-hx + c, hy), MCVector2dF(-hx, hy - c), MCVector2dF(-hx, -hy + c)};
+}
+
+void MCPolygonShape::updateVertices()
+{
+    const MCVector2dF l(location());
+
+    float x1 = std::numeric_limits<float>::max();
+    float y1 = x1;
+    float x2 = -x1;
+    float y2 = -x1;
+
+    for (size_t i = 0; i < m_localVertices.size(); i++)
+    {
+        MCMathUtil::rotateVector(m_localVertices[i], m_vertices[i], angle());
+        m_vertices[i] += l;
+
+        MCMathUtil::rotateVector(m_localNormals[i], m_normals[i], angle());
+
+        x1 = std::min(x1, m_vertices[i].i());
+        y1 = std::min(y1, m_vertices[i].j());
+        x2 = std::max(x2, m_vertices[i].i());
+        y2 = std::max(y2, m_vertices[i].j());
+    }
+
+    m_bbox = MCBBoxF(x1, y1, x2, y2);
+}
+
+void MCPolygonShape::translate(const MCVector3dF & p)
+{
+    MCShape::translate(p);
+    updateVertices();
+}
+
+void MCPolygonShape::rotate(float a)
+{
+    MCShape::rotate(a);
+    updateVertices();
+}
+
+MCBBoxF MCPolygonShape::bbox() const
+{
+    return m_bbox;
+}
+
+bool MCPolygonShape::contains(const MCVector2dF & p) const
+{
+    for (size_t i = 0; i < m_vertices.size(); i++)
+    {
+        if (m_normals[i].dot(p - m_vertices[i]) > 0)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+size_t MCPolygonShape::closestEdge(const MCVector2dF & p, float & distance) const
+{
+    size_t closest = 0;
+    distance = std::numeric_limits<float>::max();
+    for (size_t i = 0; i < m_vertices.size(); i++)
+    {
+        const float edgeDistance = -m_normals[i].dot(p - m_vertices[i]);
+        if (edgeDistance < distance)
+        {
+            distance = edgeDistance;
+            closest = i;
+        }
+    }
+
+    return closest;
+}
+
+float MCPolygonShape::interpenetrationDepth(const MCSegmentF & p, MCVector2dF & contactNormal) const
+{
+    float depth = 0;
+    contactNormal = m_normals[closestEdge(p.vertex0, depth)];
+    return depth;
+}
+
+MCVector2dF MCPolygonShape::contactNormal(const MCSegmentF & p) const
+{
+    float depth = 0;
+    return m_normals[closestEdge(p.vertex0, depth)];
+}
+
+size_t MCPolygonShape::vertexCount() const
+{
+    return m_vertices.size();
+}
+
+const MCVector2dF & MCPolygonShape::vertex(size_t index) const
+{
+    return m_vertices[index];
+}
+
+const MCVector2dF & MCPolygonShape::normal(size_t index) const
+{
+    return m_normals[index];
+}
+
+unsigned int MCPolygonShape::typeId()
+{
+    return m_typeId;
+}
+
+unsigned int MCPolygonShape::instanceTypeId() const
+{
+    return m_typeId;
+}
+
+MCPolygonShape::~MCPolygonShape()
+{
+}
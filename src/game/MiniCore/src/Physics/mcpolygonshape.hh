@@ -0,0 +1,114 @@
+// This file belongs to the "MiniCore" game engine.
+// Copyright (C) 2018 Jussi Lind <jussi.lind@iki.fi>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+// MA  02110-1301, USA.
+//
+
+#ifndef MCPOLYGONSHAPE_HH
+#define MCPOLYGONSHAPE_HH
+
+#include "mcshape.hh"
+#include "mcshapeview.hh"
+
+#include <vector>
+
+/*! \class MCPolygonShape
+ *  \brief Convex polygon shape model
+ *
+ * Convex polygon shape model for an MCObject. The polygon is tested against
+ * other polygons, rects and capsules with the separating axis test that
+ * generates a contact manifold of at most two points.
+ */
+class MCPolygonShape : public MCShape
+{
+public:
+
+    typedef std::vector<MCVector2dF> VertexVector;
+
+    //! Maximum number of vertices.
+    static const size_t MAX_VERTICES = 8;
+
+    /*! Constructor
+     * \param view View for the shape. May be nullptr.
+     * \param vertices Vertices of a convex polygon in counter-clockwise order
+     *        relative to the location of the shape. */
+    MCPolygonShape(MCShapeViewPtr view, const VertexVector & vertices);
+
+    //! Destructor
+    virtual ~MCPolygonShape();
+
+    /*! Return vertices of a width x height rectangle with cut corners. This gives
+     *  a box-like body that slides around corners instead of hooking into them.
+     * \param chamfer Length of the cut along both edges of a corner. */
+    static VertexVector chamferedRect(float width, float height, float chamfer);
+
+    //! \reimp
+    virtual void translate(const MCVector3dF & p) override;
+
+    //! \reimp
+    virtual void rotate(float a) override;
+
+    //! \reimp
+    virtual MCBBoxF bbox() const override;
+
+    //! \reimp
+    virtual bool contains(const MCVector2dF & p) const override;
+
+    //! \reimp
+    virtual float interpenetrationDepth(const MCSegmentF & p, MCVector2dF & contactNormal) const override;
+
+    //! \reimp
+    virtual MCVector2dF contactNormal(const MCSegmentF & p) const override;
+
+    //! Return the number of vertices.
+    size_t vertexCount() const;
+
+    //! Return the given vertex in world coordinates.
+    const MCVector2dF & vertex(size_t index) const;
+
+    //! Return the outward normal of the edge from the given vertex to the next one.
+    const MCVector2dF & normal(size_t index) const;
+
+    //! Return the typeId
+    static unsigned int typeId();
+
+    //! \reimp
+    virtual unsigned int instanceTypeId() const override;
+
+private:
+
+    DISABLE_COPY(MCPolygonShape);
+    DISABLE_ASSI(MCPolygonShape);
+
+    //! Return the index of the edge closest to the given inside point.
+    size_t closestEdge(const MCVector2dF & p, float & distance) const;
+
+    void updateVertices();
+
+    static unsigned int m_typeId;
+
+    VertexVector m_localVertices;
+
+    VertexVector m_localNormals;
+
+    VertexVector m_vertices;
+
+    VertexVector m_normals;
+
+    MCBBoxF m_bbox;
+};
+
+#endif // MCPOLYGONSHAPE_HH
@@ -27,7 +27,7 @@
 unsigned int MCRectShape::m_typeId = MCShape::registerType();
 
 MCRectShape::MCRectShape(MCShapeViewPtr view, float width, float height)
-: MCShape(view)
+: MCShape(view, MCShape::Kind::Rect)
 , m_width(width)
 , m_height(height)
 {
@@ -24,10 +24,11 @@ unsigned int MCShape::m_typeCount = 0;
 
 MCVector3dF MCShape::m_defaultShadowOffset = MCVector3dF(2, -2, 0.5f);
 
-MCShape::MCShape(MCShapeViewPtr view)
+MCShape::MCShape(MCShapeViewPtr view, Kind kind)
     : m_parent(nullptr)
     , m_angle(0)
     , m_radius(0)
+    , m_kind(kind)
 {
     if (view)
     {
@@ -52,6 +53,11 @@ unsigned int MCShape::registerType()
     return ++MCShape::m_typeCount;
 }
 
+MCShape::Kind MCShape::kind() const
+{
+    return m_kind;
+}
+
 MCShape::~MCShape()
 {
 }
@@ -61,7 +67,7 @@ void MCShape::setView(MCShapeViewPtr view)
     m_view = view;
 }
 
-MCShapeViewPtr MCShape::view() const
+const MCShapeViewPtr & MCShape::view() const
 {
     return m_view;
 }
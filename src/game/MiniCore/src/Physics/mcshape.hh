@@ -42,9 +42,22 @@ class MCShape
 {
 public:
 
+    /*! Compact shape kinds. The kind selects the narrowphase test in the
+     *  dispatch table of MCCollisionDetector. New kinds go before Count. */
+    enum class Kind
+    {
+        Custom,
+        Rect,
+        Circle,
+        Polygon,
+        Capsule,
+        Count
+    };
+
     /*! Constructor.
-     * \param pView View for the shape. */
-    explicit MCShape(MCShapeViewPtr view = nullptr);
+     * \param pView View for the shape.
+     * \param kind Kind of the shape. Custom shapes have no narrowphase test. */
+    explicit MCShape(MCShapeViewPtr view = nullptr, Kind kind = Kind::Custom);
 
     //! Destructor.
     virtual ~MCShape();
@@ -58,8 +71,8 @@ public:
     /*! Set view object. The same view can be shared between multiple objects; */
     void setView(MCShapeViewPtr view);
 
-    //! Get view object.
-    MCShapeViewPtr view() const;
+    //! Get view object. The returned reference doesn't share ownership.
+    const MCShapeViewPtr & view() const;
 
     /*! Render.
      * \param p Camera window to be used */
@@ -119,10 +132,12 @@ public:
     static unsigned int registerType();
 
     /*! Return class-wide static type id inited by calling
-     *  MCShape::registerType(). This is used to optimize collision detection
-     *  and to avoid dynamic_cast. */
+     *  MCShape::registerType(). This is used to avoid dynamic_cast. */
     virtual unsigned int instanceTypeId() const = 0;
 
+    //! Return the kind of the shape.
+    Kind kind() const;
+
     //! Return approximated radius.
     float radius() const;
 
@@ -153,6 +168,8 @@ private:
     float m_radius;
 
     MCShapeViewPtr m_view;
+
+    Kind m_kind;
 };
 
 typedef std::shared_ptr<MCShape> MCShapePtr;
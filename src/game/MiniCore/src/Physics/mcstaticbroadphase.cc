@@ -0,0 +1,266 @@
+// This file belongs to the "MiniCore" game engine.
+// Copyright (C) 2018 Jussi Lind <jussi.lind@iki.fi>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+// MA  02110-1301, USA.
+//
+#include "mcstaticbroadphase.hh"
+#include "mcobject.hh"
+#include "mcphysicscomponent.hh"
+#include "mcshape.hh"
+#include "mcshapeview.hh"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace {
+bool canCollide(MCObject & dynamicObject, MCObject & staticObject)
+{
+    return &dynamicObject.parent() != &staticObject &&
+           &staticObject.parent() != &dynamicObject &&
+           dynamicObject.shape()->mayIntersect(*staticObject.shape());
+}
+}
+
+MCStaticBroadphase::MCStaticBroadphase(float cellSize)
+: m_cellSize(cellSize)
+, m_horSize(0)
+, m_verSize(0)
+, m_i0(0)
+, m_i1(0)
+, m_j0(0)
+, m_j1(0)
+, m_query(0)
+{
+    assert(cellSize > 0);
+}
+
+void MCStaticBroadphase::add(MCObject & object)
+{
+    assert(object.shape());
+
+    if (!m_colliderIndices.count(&object))
+    {
+        m_colliderIndices[&object] = static_cast<unsigned int>(m_colliders.size());
+        m_colliders.push_back(&object);
+        m_filters.push_back(object.collisionFilter());
+    }
+}
+
+void MCStaticBroadphase::setIndexRange(const MCBBox<float> & bbox)
+{
+    auto clamp = [] (float value, unsigned int size) {
+        const int index = static_cast<int>(std::floor(value));
+        return static_cast<unsigned int>(std::min(std::max(index, 0), static_cast<int>(size) - 1));
+    };
+
+    m_i0 = clamp((bbox.x1() - m_bbox.x1()) / m_cellSize, m_horSize);
+    m_i1 = clamp((bbox.x2() - m_bbox.x1()) / m_cellSize, m_horSize);
+    m_j0 = clamp((bbox.y1() - m_bbox.y1()) / m_cellSize, m_verSize);
+    m_j1 = clamp((bbox.y2() - m_bbox.y1()) / m_cellSize, m_verSize);
+}
+
+void MCStaticBroadphase::build(const MCBBox<float> & bbox)
+{
+    m_bbox = bbox;
+    m_horSize = std::max(1u, static_cast<unsigned int>(std::ceil(bbox.width() / m_cellSize)));
+    m_verSize = std::max(1u, static_cast<unsigned int>(std::ceil(bbox.height() / m_cellSize)));
+
+    // Count the colliders of each cell, turn the counts into start indices and then
+    // fill the cells so that the colliders of a cell are contiguous in memory.
+    m_cellStarts.assign(m_horSize * m_verSize + 1, 0);
+    for (auto && collider : m_colliders)
+    {
+        if (collider)
+        {
+            setIndexRange(collider->shape()->bbox());
+            for (unsigned int j = m_j0; j <= m_j1; j++)
+            {
+                for (unsigned int i = m_i0; i <= m_i1; i++)
+                {
+                    m_cellStarts[j * m_horSize + i + 1]++;
+                }
+            }
+        }
+    }
+
+    for (size_t cell = 1; cell < m_cellStarts.size(); cell++)
+    {
+        m_cellStarts[cell] += m_cellStarts[cell - 1];
+    }
+
+    m_cellColliders.resize(m_cellStarts.back());
+    std::vector<unsigned int> fill(m_cellStarts.begin(), m_cellStarts.end() - 1);
+    for (unsigned int index = 0; index < m_colliders.size(); index++)
+    {
+        if (m_colliders[index])
+        {
+            setIndexRange(m_colliders[index]->shape()->bbox());
+            for (unsigned int j = m_j0; j <= m_j1; j++)
+            {
+                for (unsigned int i = m_i0; i <= m_i1; i++)
+                {
+                    m_cellColliders[fill[j * m_horSize + i]++] = index;
+                }
+            }
+        }
+    }
+
+    m_stamps.assign(m_colliders.size(), 0);
+    m_query = 0;
+}
+
+bool MCStaticBroadphase::remove(MCObject & object)
+{
+    const auto iter = m_colliderIndices.find(&object);
+    if (iter != m_colliderIndices.end())
+    {
+        m_colliders[iter->second] = nullptr;
+        m_colliderIndices.erase(iter);
+        return true;
+    }
+
+    return false;
+}
+
+void MCStaticBroadphase::clear()
+{
+    m_colliders.clear();
+    m_filters.clear();
+    m_colliderIndices.clear();
+    m_cellStarts.clear();
+    m_cellColliders.clear();
+    m_stamps.clear();
+    m_horSize = 0;
+    m_verSize = 0;
+    m_query = 0;
+}
+
+bool MCStaticBroadphase::contains(MCObject & object) const
+{
+    return m_colliderIndices.count(&object);
+}
+
+int MCStaticBroadphase::colliderCount() const
+{
+    return static_cast<int>(m_colliderIndices.size());
+}
+
+void MCStaticBroadphase::nextQuery()
+{
+    if (++m_query == 0)
+    {
+        // Wrapped around, forget the old stamps
+        std::fill(m_stamps.begin(), m_stamps.end(), 0);
+        m_query = 1;
+    }
+}
+
+bool MCStaticBroadphase::stamp(unsigned int collider)
+{
+    // A collider spanning several cells is visited only once per query
+    if (m_stamps[collider] == m_query)
+    {
+        return false;
+    }
+
+    m_stamps[collider] = m_query;
+    return m_colliders[collider] != nullptr;
+}
+
+int MCStaticBroadphase::getPossibleCollisions(const ObjectVector & objects, CollisionVector & collisions)
+{
+    int pairs = 0;
+    if (m_cellStarts.empty())
+    {
+        return pairs;
+    }
+
+    for (auto && object : objects)
+    {
+        // Optimization: ignore sleeping objects like MCObjectGrid does.
+        // Note that stationary objects are also sleeping objects.
+        if (object->physicsComponent().isSleeping() || object->physicsComponent().isStationary() || !object->shape())
+        {
+            continue;
+        }
+
+        // Particles and other non-physics objects would only be rejected by the filter
+        // after the cells have been scanned, so skip them before that.
+        if (!object->isPhysicsObject() || object->bypassCollisions())
+        {
+            continue;
+        }
+
+        const MCCollisionFilter & filter = object->collisionFilter();
+
+        nextQuery();
+        setIndexRange(object->shape()->bbox());
+        for (unsigned int j = m_j0; j <= m_j1; j++)
+        {
+            for (unsigned int i = m_i0; i <= m_i1; i++)
+            {
+                const unsigned int cell = j * m_horSize + i;
+                for (unsigned int k = m_cellStarts[cell]; k < m_cellStarts[cell + 1]; k++)
+                {
+                    const unsigned int index = m_cellColliders[k];
+                    if (stamp(index) && filter.shouldCollide(m_filters[index]) && canCollide(*object, *m_colliders[index]))
+                    {
+                        collisions.push_back({object, m_colliders[index]});
+                        collisions.push_back({m_colliders[index], object});
+                        pairs++;
+                    }
+                }
+            }
+        }
+    }
+
+    return pairs;
+}
+
+const MCStaticBroadphase::ObjectVector & MCStaticBroadphase::getObjectsWithinBBox(const MCBBox<float> & bbox)
+{
+    m_resultObjs.clear();
+    if (m_cellStarts.empty())
+    {
+        return m_resultObjs;
+    }
+
+    nextQuery();
+    setIndexRange(bbox);
+    for (unsigned int j = m_j0; j <= m_j1; j++)
+    {
+        for (unsigned int i = m_i0; i <= m_i1; i++)
+        {
+            const unsigned int cell = j * m_horSize + i;
+            for (unsigned int k = m_cellStarts[cell]; k < m_cellStarts[cell + 1]; k++)
+            {
+                const unsigned int index = m_cellColliders[k];
+                if (stamp(index))
+                {
+                    MCObject * obj = m_colliders[index];
+                    if (obj->shape()->view() &&
+                        bbox.intersects(obj->shape()->view()->bbox().translated(MCVector2dF(obj->location()))))
+                    {
+                        m_resultObjs.push_back(obj);
+                    }
+                }
+            }
+        }
+    }
+
+    return m_resultObjs;
+}
@@ -0,0 +1,122 @@
+// This file belongs to the "MiniCore" game engine.
+// Copyright (C) 2018 Jussi Lind <jussi.lind@iki.fi>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+// MA  02110-1301, USA.
+//
+
+#ifndef MCSTATICBROADPHASE_HH
+#define MCSTATICBROADPHASE_HH
+
+#include "mcbbox.hh"
+#include "mccollisionfilter.hh"
+#include "mcmacros.hh"
+#include "mcobjectgrid.hh"
+
+#include <unordered_map>
+#include <vector>
+
+class MCObject;
+
+/*! A broadphase for the stationary colliders, e.g. the walls of a race track.
+ *  The colliders are binned once into a uniform grid that is stored as flat arrays,
+ *  so the structure doesn't need to be updated while the world is running. It is
+ *  only queried by the moving objects, which means that the static colliders are
+ *  never tested against each other.
+ *
+ *  The colliders must not be moved nor their collision filters changed after add(). */
+class MCStaticBroadphase
+{
+public:
+
+    typedef MCObjectGrid::CollisionVector CollisionVector;
+
+    typedef std::vector<MCObject *> ObjectVector;
+
+    /*! Constructor.
+     *  \param cellSize Width and height of a grid cell in world units. */
+    explicit MCStaticBroadphase(float cellSize = 256);
+
+    //! Add a collider. build() must be called before the collider is found.
+    void add(MCObject & object);
+
+    /*! Bin the added colliders into the grid.
+     *  \param bbox The area covered by the grid. Colliders outside the area go to the border cells. */
+    void build(const MCBBox<float> & bbox);
+
+    /*! Remove a collider. The grid is not rebuilt, only the slot of the collider is cleared.
+     *  \return true if was removed. */
+    bool remove(MCObject & object);
+
+    //! Remove all colliders.
+    void clear();
+
+    //! \return true if the object is a collider of the broadphase.
+    bool contains(MCObject & object) const;
+
+    //! \return number of colliders.
+    int colliderCount() const;
+
+    /*! Get possible collisions between the given objects and the static colliders.
+     *  Stationary and sleeping objects in the given vector are skipped.
+     *  Both orderings of each pair are appended to the given vector like in MCObjectGrid.
+     *  \return number of pairs found. */
+    int getPossibleCollisions(const ObjectVector & objects, CollisionVector & collisions);
+
+    //! Get colliders whose view overlaps the given BBox.
+    const ObjectVector & getObjectsWithinBBox(const MCBBox<float> & bbox);
+
+private:
+
+    DISABLE_COPY(MCStaticBroadphase);
+    DISABLE_ASSI(MCStaticBroadphase);
+
+    void setIndexRange(const MCBBox<float> & bbox);
+
+    void nextQuery();
+
+    bool stamp(unsigned int collider);
+
+    float m_cellSize;
+
+    MCBBox<float> m_bbox;
+
+    unsigned int m_horSize;
+
+    unsigned int m_verSize;
+
+    unsigned int m_i0, m_i1, m_j0, m_j1;
+
+    ObjectVector m_colliders;
+
+    //! Collision filters of the colliders, copied when added.
+    std::vector<MCCollisionFilter> m_filters;
+
+    std::unordered_map<MCObject *, unsigned int> m_colliderIndices;
+
+    //! Index of the first collider of each cell in m_cellColliders. The last item is the end.
+    std::vector<unsigned int> m_cellStarts;
+
+    std::vector<unsigned int> m_cellColliders;
+
+    //! Query number of the latest query that has visited each collider.
+    std::vector<unsigned int> m_stamps;
+
+    unsigned int m_query;
+
+    ObjectVector m_resultObjs;
+};
+
+#endif // MCSTATICBROADPHASE_HH
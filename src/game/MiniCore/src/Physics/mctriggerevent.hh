@@ -0,0 +1,81 @@
+// This file belongs to the "MiniCore" game engine.
+// Copyright (C) 2018 Jussi Lind <jussi.lind@iki.fi>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+// MA  02110-1301, USA.
+//
+
+#ifndef MCTRIGGEREVENT_HH
+#define MCTRIGGEREVENT_HH
+
+#include "mcevent.hh"
+
+class MCObject;
+
+/*! \class MCTriggerEvent
+ *  \brief Event sent to a trigger object when an object enters, stays in or exits it.
+ *
+ *  The overlaps of the trigger objects are checked by MCTriggerSystem once per
+ *  world step and the events are delivered after the step to the triggers that
+ *  have subscribed via MCObject::subscribeTriggerEvent().
+ */
+class MCTriggerEvent : public MCEvent
+{
+public:
+
+    enum class Type
+    {
+        //! The object started to overlap the trigger on this step.
+        Enter,
+
+        //! The object overlapped the trigger also on the previous step.
+        Stay,
+
+        //! The object stopped overlapping the trigger on this step.
+        Exit
+    };
+
+    /*! Constructor.
+     * \param type Type of the event.
+     * \param object The object entering, staying in or exiting the trigger. */
+    MCTriggerEvent(Type type, MCObject & object);
+
+    //! Destructor.
+    ~MCTriggerEvent();
+
+    //! Get the type.
+    Type type() const;
+
+    //! Get the object entering, staying in or exiting the trigger.
+    MCObject & object() const;
+
+    //! Return the typeId.
+    static unsigned int typeId();
+
+    //! \reimp
+    virtual unsigned int instanceTypeId() const;
+
+private:
+
+    DISABLE_ASSI(MCTriggerEvent);
+
+    Type m_type;
+
+    MCObject & m_object;
+
+    static unsigned int m_typeId;
+};
+
+#endif // MCTRIGGEREVENT_HH
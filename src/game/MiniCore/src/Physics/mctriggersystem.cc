@@ -0,0 +1,171 @@
+// This file belongs to the "MiniCore" game engine.
+// Copyright (C) 2018 Jussi Lind <jussi.lind@iki.fi>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+// MA  02110-1301, USA.
+//
+#include "mctriggersystem.hh"
+#include "mccollisiondetector.hh"
+#include "mceventqueue.hh"
+#include "mcobject.hh"
+#include "mcphysicscomponent.hh"
+#include "mcshape.hh"
+#include "mcshapeview.hh"
+
+#include <algorithm>
+
+MCTriggerSystem::MCTriggerSystem()
+: m_triggerEvents(MCEventQueue<MCTriggerEvent>::instance())
+{
+}
+
+void MCTriggerSystem::addTrigger(MCObject & trigger)
+{
+    if (trigger.shape() && !isTrigger(trigger))
+    {
+        m_triggers.push_back(&trigger);
+    }
+}
+
+void MCTriggerSystem::removeObject(MCObject & object)
+{
+    m_triggers.erase(std::remove(m_triggers.begin(), m_triggers.end(), &object), m_triggers.end());
+
+    m_overlaps.erase(std::remove_if(m_overlaps.begin(), m_overlaps.end(), [&object] (const Overlap & overlap) {
+        return overlap.first == &object || overlap.second == &object;
+    }), m_overlaps.end());
+}
+
+void MCTriggerSystem::clear()
+{
+    m_triggers.clear();
+    m_candidates.clear();
+    m_overlaps.clear();
+    m_newOverlaps.clear();
+}
+
+bool MCTriggerSystem::isTrigger(MCObject & object) const
+{
+    return std::find(m_triggers.begin(), m_triggers.end(), &object) != m_triggers.end();
+}
+
+int MCTriggerSystem::triggerCount() const
+{
+    return static_cast<int>(m_triggers.size());
+}
+
+int MCTriggerSystem::overlapCount() const
+{
+    return static_cast<int>(m_overlaps.size());
+}
+
+bool MCTriggerSystem::canTrigger(MCObject & object) const
+{
+    return object.shape() &&
+           object.isPhysicsObject() &&
+           !object.isTriggerObject() &&
+           !object.bypassCollisions() &&
+           !object.physicsComponent().isStationary() &&
+           !object.physicsComponent().isSleeping();
+}
+
+void MCTriggerSystem::update(const ObjectVector & objects)
+{
+    if (m_triggers.empty())
+    {
+        return;
+    }
+
+    m_candidates.clear();
+    for (MCObject * object : objects)
+    {
+        if (canTrigger(*object))
+        {
+            m_candidates.push_back(object);
+        }
+    }
+
+    m_newOverlaps.clear();
+    for (MCObject * trigger : m_triggers)
+    {
+        const MCBBoxF bbox = trigger->shape()->bbox();
+        for (MCObject * object : m_candidates)
+        {
+            if (&object->parent() != trigger &&
+                &trigger->parent() != object &&
+                trigger->collisionFilter().shouldCollide(object->collisionFilter()) &&
+                bbox.intersects(object->shape()->bbox()) &&
+                MCCollisionDetector::testOverlap(*trigger->shape(), *object->shape()))
+            {
+                m_newOverlaps.push_back({trigger, object});
+            }
+        }
+    }
+
+    // Sleeping objects haven't moved, so they keep overlapping silently
+    for (auto && overlap : m_overlaps)
+    {
+        if (overlap.second->physicsComponent().isSleeping())
+        {
+            m_newOverlaps.push_back(overlap);
+        }
+    }
+
+    std::sort(m_newOverlaps.begin(), m_newOverlaps.end());
+
+    // Both vectors are sorted, so the changes are found in a single pass
+    auto oldIter = m_overlaps.begin();
+    auto newIter = m_newOverlaps.begin();
+    while (oldIter != m_overlaps.end() || newIter != m_newOverlaps.end())
+    {
+        if (newIter == m_newOverlaps.end() || (oldIter != m_overlaps.end() && *oldIter < *newIter))
+        {
+            m_triggerEvents.post(*oldIter->first, MCTriggerEvent::Type::Exit, *oldIter->second);
+            oldIter++;
+        }
+        else if (oldIter == m_overlaps.end() || *newIter < *oldIter)
+        {
+            m_triggerEvents.post(*newIter->first, MCTriggerEvent::Type::Enter, *newIter->second);
+            newIter++;
+        }
+        else
+        {
+            if (!newIter->second->physicsComponent().isSleeping())
+            {
+                m_triggerEvents.post(*newIter->first, MCTriggerEvent::Type::Stay, *newIter->second);
+            }
+
+            oldIter++;
+            newIter++;
+        }
+    }
+
+    m_overlaps.swap(m_newOverlaps);
+}
+
+const MCTriggerSystem::ObjectVector & MCTriggerSystem::getObjectsWithinBBox(const MCBBox<float> & bbox)
+{
+    m_resultObjs.clear();
+    for (MCObject * trigger : m_triggers)
+    {
+        if (trigger->shape()->view() &&
+            bbox.intersects(trigger->shape()->view()->bbox().translated(MCVector2dF(trigger->location()))))
+        {
+            m_resultObjs.push_back(trigger);
+        }
+    }
+
+    return m_resultObjs;
+}
@@ -0,0 +1,103 @@
+// This file belongs to the "MiniCore" game engine.
+// Copyright (C) 2018 Jussi Lind <jussi.lind@iki.fi>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+// MA  02110-1301, USA.
+//
+
+#ifndef MCTRIGGERSYSTEM_HH
+#define MCTRIGGERSYSTEM_HH
+
+#include "mcbbox.hh"
+#include "mcmacros.hh"
+#include "mctriggerevent.hh"
+
+#include <utility>
+#include <vector>
+
+class MCObject;
+
+template<typename EventType>
+class MCEventQueue;
+
+/*! Checks the moving objects against the trigger objects once per world step
+ *  and queues MCTriggerEvents for the triggers. The trigger objects are kept out
+ *  of MCObjectGrid, so they never produce possible collisions, contacts nor
+ *  impulses and they are not tested again on the collision resolver iterations.
+ *
+ *  Stationary objects, other triggers and objects without physics never trigger.
+ *  Sleeping objects keep their state until they wake up. */
+class MCTriggerSystem
+{
+public:
+
+    typedef std::vector<MCObject *> ObjectVector;
+
+    //! Constructor.
+    MCTriggerSystem();
+
+    //! Add a trigger object.
+    void addTrigger(MCObject & trigger);
+
+    /*! Forget the given object, both as a trigger and as an object overlapping triggers.
+     *  No exit events are sent, because the object might be deleted. */
+    void removeObject(MCObject & object);
+
+    //! Remove all triggers and overlaps.
+    void clear();
+
+    //! \return true if the object has been added as a trigger.
+    bool isTrigger(MCObject & object) const;
+
+    //! \return number of triggers.
+    int triggerCount() const;
+
+    //! \return number of objects currently overlapping triggers.
+    int overlapCount() const;
+
+    /*! Check the overlaps of the given objects with the triggers and queue
+     *  enter, stay and exit events for the triggers. */
+    void update(const ObjectVector & objects);
+
+    //! Get triggers whose view overlaps the given BBox.
+    const ObjectVector & getObjectsWithinBBox(const MCBBox<float> & bbox);
+
+private:
+
+    DISABLE_COPY(MCTriggerSystem);
+    DISABLE_ASSI(MCTriggerSystem);
+
+    //! Trigger and the overlapping object.
+    typedef std::pair<MCObject *, MCObject *> Overlap;
+
+    bool canTrigger(MCObject & object) const;
+
+    ObjectVector m_triggers;
+
+    //! Objects that may trigger on the current step.
+    ObjectVector m_candidates;
+
+    //! Sorted overlaps of the previous step.
+    std::vector<Overlap> m_overlaps;
+
+    //! Sorted overlaps of the current step.
+    std::vector<Overlap> m_newOverlaps;
+
+    ObjectVector m_resultObjs;
+
+    MCEventQueue<MCTriggerEvent> & m_triggerEvents;
+};
+
+#endif // MCTRIGGERSYSTEM_HH
@@ -0,0 +1,467 @@
+// This file belongs to the "MiniCore" game engine.
+// Copyright (C) 2018 Jussi Lind <jussi.lind@iki.fi>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+// MA  02110-1301, USA.
+//
+#include "MCCollisionDetectorTest.hpp"
+#include "../../Core/mcobject.hh"
+#include "../../Core/mcworld.hh"
+#include "../../Physics/mccapsuleshape.hh"
+#include "../../Physics/mccircleshape.hh"
+#include "../../Physics/mccollisiondetector.hh"
+#include "../../Physics/mccontact.hh"
+#include "../../Physics/mcphysicscomponent.hh"
+#include "../../Physics/mcpolygonshape.hh"
+#include "../../Physics/mcrectshape.hh"
+
+#include <QDebug>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+Q_DECLARE_METATYPE(MCShape::Kind)
+
+namespace {
+
+//! Shape without a narrowphase test.
+class CustomShape : public MCShape
+{
+public:
+
+    CustomShape()
+    : MCShape(nullptr)
+    {
+        setRadius(10);
+    }
+
+    virtual MCBBoxF bbox() const override
+    {
+        return MCBBoxF(location().i() - radius(), location().j() - radius(), location().i() + radius(), location().j() + radius());
+    }
+
+    virtual bool contains(const MCVector2dF &) const override
+    {
+        return true;
+    }
+
+    virtual float interpenetrationDepth(const MCSegmentF &, MCVector2dF &) const override
+    {
+        return 1;
+    }
+
+    virtual MCVector2dF contactNormal(const MCSegmentF &) const override
+    {
+        return MCVector2dF(1, 0);
+    }
+
+    virtual unsigned int instanceTypeId() const override
+    {
+        return m_typeId;
+    }
+
+    static unsigned int m_typeId;
+};
+
+unsigned int CustomShape::m_typeId = MCShape::registerType();
+
+MCShapePtr createShape(MCShape::Kind kind)
+{
+    switch (kind)
+    {
+    case MCShape::Kind::Rect:
+        return MCShapePtr(new MCRectShape(nullptr, 10, 10));
+    case MCShape::Kind::Circle:
+        return MCShapePtr(new MCCircleShape(nullptr, 5));
+    case MCShape::Kind::Polygon:
+        return MCShapePtr(new MCPolygonShape(nullptr, MCPolygonShape::chamferedRect(10, 10, 2)));
+    case MCShape::Kind::Capsule:
+        return MCShapePtr(new MCCapsuleShape(nullptr, 10, 3));
+    default:
+        return MCShapePtr(new CustomShape);
+    }
+}
+
+//! Test the pair in both orderings like the broadphases list it.
+bool collide(MCCollisionDetector & detector, MCObject & object1, MCObject & object2)
+{
+    return detector.detectCollisions({{&object1, &object2}, {&object2, &object1}}) > 0;
+}
+
+//! \return true if two of the contacts have the same point, normal and depth.
+bool hasDuplicates(const std::vector<MCContact *> & contacts)
+{
+    for (size_t i = 0; i < contacts.size(); i++)
+    {
+        for (size_t j = i + 1; j < contacts.size(); j++)
+        {
+            auto && a = *contacts[i];
+            auto && b = *contacts[j];
+            if (a.contactPoint().i() == b.contactPoint().i() && a.contactPoint().j() == b.contactPoint().j() &&
+                a.contactNormal().i() == b.contactNormal().i() && a.contactNormal().j() == b.contactNormal().j() &&
+                a.interpenetrationDepth() == b.interpenetrationDepth())
+            {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+} // namespace
+
+MCCollisionDetectorTest::MCCollisionDetectorTest()
+{
+}
+
+void MCCollisionDetectorTest::testAllOrderings_data()
+{
+    QTest::addColumn<MCShape::Kind>("kind1");
+    QTest::addColumn<MCShape::Kind>("kind2");
+
+    const std::vector<std::pair<MCShape::Kind, QString>> kinds = {
+        {MCShape::Kind::Rect, "rect"},
+        {MCShape::Kind::Circle, "circle"},
+        {MCShape::Kind::Polygon, "polygon"},
+        {MCShape::Kind::Capsule, "capsule"}};
+
+    for (auto && kind1 : kinds)
+    {
+        for (auto && kind2 : kinds)
+        {
+            const QString name = kind1.second + "-" + kind2.second;
+            QTest::newRow(name.toLatin1().constData()) << kind1.first << kind2.first;
+        }
+    }
+}
+
+void MCCollisionDetectorTest::testAllOrderings()
+{
+    QFETCH(MCShape::Kind, kind1);
+    QFETCH(MCShape::Kind, kind2);
+
+    MCWorld world;
+    world.setDimensions(-100, 100, -100, 100, -100, 100);
+
+    MCObject object1("object1");
+    object1.setShape(createShape(kind1));
+    QVERIFY(object1.shape()->kind() == kind1);
+
+    MCObject object2("object2");
+    object2.setShape(createShape(kind2));
+    QVERIFY(object2.shape()->kind() == kind2);
+
+    world.addObject(object1);
+    world.addObject(object2);
+
+    object1.translate(MCVector3dF(-2, 0));
+    object2.translate(MCVector3dF( 2, 0));
+
+    MCCollisionDetector detector;
+    QVERIFY(collide(detector, object1, object2));
+    QCOMPARE(object1.contacts().size(), size_t(1));
+    QCOMPARE(object2.contacts().size(), size_t(1));
+    QVERIFY(object1.contacts().count(&object2));
+    QVERIFY(object2.contacts().count(&object1));
+
+    // Tests that create the contacts of both shapes must not run for both orderings
+    QCOMPARE(object1.contacts().at(&object2).size(), object2.contacts().at(&object1).size());
+    QVERIFY(!hasDuplicates(object1.contacts().at(&object2)));
+    QVERIFY(!hasDuplicates(object2.contacts().at(&object1)));
+
+    object1.deleteContacts();
+    object2.deleteContacts();
+}
+
+void MCCollisionDetectorTest::testSeparatedShapes_data()
+{
+    testAllOrderings_data();
+}
+
+void MCCollisionDetectorTest::testSeparatedShapes()
+{
+    QFETCH(MCShape::Kind, kind1);
+    QFETCH(MCShape::Kind, kind2);
+
+    MCWorld world;
+    world.setDimensions(-100, 100, -100, 100, -100, 100);
+
+    MCObject object1("object1");
+    object1.setShape(createShape(kind1));
+
+    MCObject object2("object2");
+    object2.setShape(createShape(kind2));
+
+    world.addObject(object1);
+    world.addObject(object2);
+
+    object1.translate(MCVector3dF(-20, 0));
+    object2.translate(MCVector3dF( 20, 0));
+
+    MCCollisionDetector detector;
+    QVERIFY(!collide(detector, object1, object2));
+    QVERIFY(object1.contacts().empty());
+    QVERIFY(object2.contacts().empty());
+}
+
+void MCCollisionDetectorTest::testCustomShape()
+{
+    MCWorld world;
+    world.setDimensions(-100, 100, -100, 100, -100, 100);
+
+    MCObject custom("custom");
+    custom.setShape(createShape(MCShape::Kind::Custom));
+    QVERIFY(custom.shape()->kind() == MCShape::Kind::Custom);
+
+    MCObject rect("rect");
+    rect.setShape(createShape(MCShape::Kind::Rect));
+
+    world.addObject(custom);
+    world.addObject(rect);
+
+    MCCollisionDetector detector;
+    QVERIFY(!detector.processPossibleCollision(custom, rect));
+    QVERIFY(!detector.processPossibleCollision(rect, custom));
+    QVERIFY(custom.contacts().empty());
+    QVERIFY(rect.contacts().empty());
+}
+
+void MCCollisionDetectorTest::testManifoldOfParallelEdges_data()
+{
+    QTest::addColumn<MCShape::Kind>("kind1");
+    QTest::addColumn<MCShape::Kind>("kind2");
+
+    QTest::newRow("polygon-polygon") << MCShape::Kind::Polygon << MCShape::Kind::Polygon;
+    QTest::newRow("polygon-rect") << MCShape::Kind::Polygon << MCShape::Kind::Rect;
+    QTest::newRow("rect-polygon") << MCShape::Kind::Rect << MCShape::Kind::Polygon;
+    QTest::newRow("polygon-capsule") << MCShape::Kind::Polygon << MCShape::Kind::Capsule;
+    QTest::newRow("capsule-capsule") << MCShape::Kind::Capsule << MCShape::Kind::Capsule;
+}
+
+void MCCollisionDetectorTest::testManifoldOfParallelEdges()
+{
+    QFETCH(MCShape::Kind, kind1);
+    QFETCH(MCShape::Kind, kind2);
+
+    MCWorld world;
+    world.setDimensions(-100, 100, -100, 100, -100, 100);
+
+    MCObject object1("object1");
+    object1.setShape(createShape(kind1));
+
+    MCObject object2("object2");
+    object2.setShape(createShape(kind2));
+
+    world.addObject(object1);
+    world.addObject(object2);
+
+    // Resting edge to edge with one unit of overlap: two contact points with equal depths
+    const float extent1 = kind1 == MCShape::Kind::Capsule ? 3 : 5;
+    const float extent2 = kind2 == MCShape::Kind::Capsule ? 3 : 5;
+    object1.translate(MCVector3dF(0, 0));
+    object2.translate(MCVector3dF(1, extent1 + extent2 - 1));
+
+    MCCollisionDetector detector;
+    QVERIFY(collide(detector, object1, object2));
+    QVERIFY(object1.contacts().count(&object2));
+
+    auto && contacts = object1.contacts().at(&object2);
+    QCOMPARE(contacts.size(), size_t(2));
+    for (auto && contact : contacts)
+    {
+        QVERIFY(qFuzzyCompare(contact->interpenetrationDepth(), 1.0f));
+        QVERIFY(qFuzzyCompare(contact->contactNormal().j(), -1.0f));
+    }
+
+    object1.deleteContacts();
+    object2.deleteContacts();
+}
+
+void MCCollisionDetectorTest::testCapsuleEnds()
+{
+    MCWorld world;
+    world.setDimensions(-100, 100, -100, 100, -100, 100);
+
+    MCObject capsule1("capsule1");
+    capsule1.setShape(MCShapePtr(new MCCapsuleShape(nullptr, 20, 2)));
+
+    MCObject capsule2("capsule2");
+    capsule2.setShape(MCShapePtr(new MCCapsuleShape(nullptr, 20, 2)));
+
+    world.addObject(capsule1);
+    world.addObject(capsule2);
+
+    // Collinear and apart although the sides are aligned
+    capsule2.translate(MCVector3dF(21, 0));
+
+    MCCollisionDetector detector;
+    QVERIFY(!collide(detector, capsule1, capsule2));
+
+    // Overlapping ends give a single contact along the axis
+    capsule2.translate(MCVector3dF(19, 0));
+
+    QVERIFY(collide(detector, capsule1, capsule2));
+    QCOMPARE(capsule1.contacts().at(&capsule2).size(), size_t(1));
+
+    auto && contact = *capsule1.contacts().at(&capsule2).front();
+    QVERIFY(qFuzzyCompare(contact.interpenetrationDepth(), 1.0f));
+    QVERIFY(qFuzzyCompare(contact.contactNormal().i(), -1.0f));
+
+    capsule1.deleteContacts();
+    capsule2.deleteContacts();
+
+    // Segments that touch end to end still push along the axis
+    capsule2.translate(MCVector3dF(16, 0));
+
+    QVERIFY(collide(detector, capsule1, capsule2));
+    QCOMPARE(capsule1.contacts().at(&capsule2).size(), size_t(1));
+
+    auto && touchingContact = *capsule1.contacts().at(&capsule2).front();
+    QVERIFY(qFuzzyCompare(touchingContact.interpenetrationDepth(), 4.0f));
+    QVERIFY(qFuzzyCompare(touchingContact.contactNormal().i(), -1.0f));
+
+    capsule1.deleteContacts();
+    capsule2.deleteContacts();
+}
+
+void MCCollisionDetectorTest::benchmarkProcessPossibleCollision()
+{
+    MCWorld world;
+    world.setDimensions(-1000, 1000, -1000, 1000, -100, 100);
+
+    // Mixed pairs of all supported kinds, half of them overlapping
+    const MCShape::Kind kinds[] = {MCShape::Kind::Rect, MCShape::Kind::Circle, MCShape::Kind::Polygon, MCShape::Kind::Capsule};
+    std::vector<std::unique_ptr<MCObject>> objects;
+    for (int i = 0; i < 200; i++)
+    {
+        objects.push_back(std::unique_ptr<MCObject>(new MCObject("object")));
+        objects.back()->setShape(createShape(kinds[i % 4]));
+        world.addObject(*objects.back());
+        objects.back()->translate(MCVector3dF((i / 2) * 20 - 990 + (i % 4 < 2 ? 0 : 8), (i % 2) * 4));
+    }
+
+    MCCollisionDetector detector;
+    QBENCHMARK {
+        for (size_t i = 0; i + 1 < objects.size(); i++)
+        {
+            detector.processPossibleCollision(*objects[i], *objects[i + 1]);
+            detector.processPossibleCollision(*objects[i + 1], *objects[i]);
+        }
+
+        for (auto && object : objects)
+        {
+            object->deleteContacts();
+        }
+    }
+}
+
+void MCCollisionDetectorTest::benchmarkPileUp_data()
+{
+    QTest::addColumn<MCShape::Kind>("kind");
+
+    QTest::newRow("rect") << MCShape::Kind::Rect;
+    QTest::newRow("polygon") << MCShape::Kind::Polygon;
+}
+
+void MCCollisionDetectorTest::benchmarkPileUp()
+{
+    QFETCH(MCShape::Kind, kind);
+
+    MCWorld world;
+    world.setDimensions(-1000, 1000, -1000, 1000, -100, 100);
+
+    // A pile-up of car-sized bodies driving into each other
+    const int columns = 6;
+    const int rows = 5;
+    std::vector<std::unique_ptr<MCObject>> cars;
+    for (int i = 0; i < columns * rows; i++)
+    {
+        cars.push_back(std::unique_ptr<MCObject>(new MCObject("car")));
+        if (kind == MCShape::Kind::Rect)
+        {
+            cars.back()->setShape(MCShapePtr(new MCRectShape(nullptr, 48, 24)));
+        }
+        else
+        {
+            cars.back()->setShape(MCShapePtr(new MCPolygonShape(nullptr, MCPolygonShape::chamferedRect(48, 24, 4))));
+        }
+
+        cars.back()->physicsComponent().setMass(1000);
+        world.addObject(*cars.back());
+    }
+
+    const int steps = 10;
+    int resolverIterations = 0;
+    QBENCHMARK {
+        for (int i = 0; i < columns * rows; i++)
+        {
+            auto && car = *cars[i];
+            car.physicsComponent().reset();
+            car.translate(MCVector3dF((i % columns) * 44 - 100, (i / columns) * 20 - 50));
+            car.rotate((i * 7) % 30);
+            car.physicsComponent().setVelocity(MCVector3dF(i % 2 ? -5 : 5, i % 3 ? -2 : 2));
+        }
+
+        resolverIterations = 0;
+        for (int step = 0; step < steps; step++)
+        {
+            world.stepTime(10);
+            resolverIterations += world.resolverIterationCount();
+        }
+    }
+
+    // Measure how deep the cars are still inside each other after the last run
+    for (auto && car : cars)
+    {
+        car->deleteContacts();
+    }
+
+    MCCollisionDetector detector;
+    for (size_t i = 0; i < cars.size(); i++)
+    {
+        for (size_t j = i + 1; j < cars.size(); j++)
+        {
+            collide(detector, *cars[i], *cars[j]);
+        }
+    }
+
+    int contactCount = 0;
+    float maxDepth = 0;
+    float totalDepth = 0;
+    for (auto && car : cars)
+    {
+        for (auto && iter : car->contacts())
+        {
+            for (auto && contact : iter.second)
+            {
+                contactCount++;
+                maxDepth = std::max(maxDepth, contact->interpenetrationDepth());
+                totalDepth += contact->interpenetrationDepth();
+            }
+        }
+
+        car->deleteContacts();
+    }
+
+    qDebug() << QTest::currentDataTag() << "resolver iterations:" << resolverIterations << "/" << steps
+             << "steps, remaining contacts:" << contactCount << ", max depth:" << maxDepth << ", total depth:" << totalDepth;
+
+    // The world runs at most 5 resolver iterations per step by default
+    QVERIFY(resolverIterations <= steps * 5);
+}
+
+QTEST_GUILESS_MAIN(MCCollisionDetectorTest)
@@ -0,0 +1,181 @@
+// This file belongs to the "MiniCore" game engine.
+// Copyright (C) 2018 Jussi Lind <jussi.lind@iki.fi>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+// MA  02110-1301, USA.
+//
+#include <QTest>
+
+#include "MCCollisionFilterTest.hpp"
+#include "../../Core/mcworld.hh"
+#include "../../Core/mcobject.hh"
+#include "../../Physics/mccollisionfilter.hh"
+#include "../../Physics/mcobjectgrid.hh"
+#include "../../Physics/mcphysicscomponent.hh"
+#include "../../Physics/mcrectshape.hh"
+
+#include <memory>
+#include <vector>
+
+namespace {
+std::unique_ptr<MCObject> createObject(float x, float y)
+{
+    std::unique_ptr<MCObject> object(new MCObject("TEST_OBJECT"));
+    object->setShape(MCShapePtr(new MCRectShape(MCShapeViewPtr(), 10, 10)));
+    object->physicsComponent().preventSleeping(true);
+    object->translate(MCVector3dF(x, y));
+    return object;
+}
+}
+
+MCCollisionFilterTest::MCCollisionFilterTest()
+{
+}
+
+void MCCollisionFilterTest::testDefaultFilterNeverCollides()
+{
+    const MCCollisionFilter disabled;
+    const MCCollisionFilter allLayers(-1, 0, -1, 0);
+    QVERIFY(!disabled.shouldCollide(allLayers));
+    QVERIFY(!allLayers.shouldCollide(disabled));
+    QVERIFY(!disabled.shouldCollide(disabled));
+}
+
+void MCCollisionFilterTest::testLayers()
+{
+    const MCCollisionFilter layer0(0, 0, -1, 0);
+    const MCCollisionFilter layer1(1, 0, -1, 0);
+    const MCCollisionFilter allLayers(-1, 0, -1, 0);
+
+    QVERIFY(layer0.shouldCollide(layer0));
+    QVERIFY(!layer0.shouldCollide(layer1));
+    QVERIFY(!layer1.shouldCollide(layer0));
+    QVERIFY(layer0.shouldCollide(allLayers));
+    QVERIFY(allLayers.shouldCollide(layer1));
+    QVERIFY(allLayers.shouldCollide(allLayers));
+}
+
+void MCCollisionFilterTest::testTags()
+{
+    const MCCollisionFilter tag1(0, 1, -1, 0);
+    const MCCollisionFilter tag2(0, 2, -1, 0);
+    const MCCollisionFilter tag2NeverTag1(0, 2, 1, 0);
+    const MCCollisionFilter tag1NeverTag1(0, 1, 1, 0);
+
+    QVERIFY(tag1.shouldCollide(tag2));
+    QVERIFY(!tag1.shouldCollide(tag2NeverTag1));
+    QVERIFY(!tag2NeverTag1.shouldCollide(tag1));
+    QVERIFY(tag2.shouldCollide(tag2NeverTag1));
+    QVERIFY(!tag1NeverTag1.shouldCollide(tag1NeverTag1));
+
+    // The tags don't override the layers
+    const MCCollisionFilter otherLayer(1, 2, -1, 0);
+    QVERIFY(!tag1.shouldCollide(otherLayer));
+}
+
+void MCCollisionFilterTest::testGroups()
+{
+    const MCCollisionFilter layer0Group1(0, 0, -1, 1);
+    const MCCollisionFilter layer1Group1(1, 0, -1, 1);
+    QVERIFY(layer0Group1.shouldCollide(layer1Group1));
+
+    const MCCollisionFilter layer0GroupMinus1(0, 0, -1, -1);
+    QVERIFY(!layer0GroupMinus1.shouldCollide(layer0GroupMinus1));
+
+    const MCCollisionFilter layer0Group2(0, 0, -1, 2);
+    QVERIFY(layer0Group1.shouldCollide(layer0Group2));
+    QVERIFY(!layer0Group2.shouldCollide(layer1Group1));
+}
+
+void MCCollisionFilterTest::testObjectFlags()
+{
+    MCObject object("TEST_OBJECT");
+    const MCCollisionFilter other(0, 0, -1, 0);
+    QVERIFY(object.collisionFilter().shouldCollide(other));
+
+    object.setBypassCollisions(true);
+    QVERIFY(!object.collisionFilter().shouldCollide(other));
+    object.setBypassCollisions(false);
+
+    object.setIsPhysicsObject(false);
+    QVERIFY(!object.collisionFilter().shouldCollide(other));
+
+    object.setIsTriggerObject(true);
+    QVERIFY(object.collisionFilter().shouldCollide(other));
+
+    object.setCollisionLayer(2);
+    QVERIFY(!object.collisionFilter().shouldCollide(other));
+
+    object.setCollisionGroup(1);
+    QVERIFY(!object.collisionFilter().shouldCollide(other));
+    QVERIFY(object.collisionFilter().shouldCollide(MCCollisionFilter(0, 0, -1, 1)));
+
+    object.physicsComponent().setNeverCollideWithTag(3);
+    QVERIFY(!object.collisionFilter().shouldCollide(MCCollisionFilter(2, 3, -1, 0)));
+}
+
+void MCCollisionFilterTest::testGridUsesUpdatedFilter()
+{
+    MCWorld world;
+    world.setDimensions(0, 1000, 0, 1000, 0, 1000);
+
+    auto object1 = createObject(500, 500);
+    auto object2 = createObject(505, 500);
+    world.addObject(*object1);
+    world.addObject(*object2);
+
+    QVERIFY(!world.objectGrid().getPossibleCollisions().empty());
+
+    // The grid must see the new layer without the objects being moved
+    object2->setCollisionLayer(1);
+    QVERIFY(world.objectGrid().getPossibleCollisions().empty());
+
+    object2->setCollisionLayer(-1);
+    QVERIFY(!world.objectGrid().getPossibleCollisions().empty());
+}
+
+void MCCollisionFilterTest::benchmarkPossibleCollisions_data()
+{
+    QTest::addColumn<int>("layers");
+
+    QTest::newRow("one layer") << 1;
+    QTest::newRow("four layers") << 4;
+}
+
+void MCCollisionFilterTest::benchmarkPossibleCollisions()
+{
+    QFETCH(int, layers);
+
+    MCWorld world;
+    world.setDimensions(0, 1000, 0, 1000, 0, 1000);
+
+    // Crowd the objects into a few cells so that most of the time goes to the pair tests
+    std::vector<std::unique_ptr<MCObject>> objects;
+    for (int i = 0; i < 200; i++)
+    {
+        objects.push_back(createObject(500 + i % 20, 500 + i / 20));
+        objects.back()->setCollisionLayer(i % layers);
+        world.addObject(*objects.back());
+    }
+
+    size_t pairs = 0;
+    QBENCHMARK {
+        pairs = world.objectGrid().getPossibleCollisions().size();
+    }
+
+    QVERIFY(pairs > 0);
+}
+
+QTEST_GUILESS_MAIN(MCCollisionFilterTest)
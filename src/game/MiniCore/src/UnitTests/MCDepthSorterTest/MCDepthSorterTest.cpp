@@ -0,0 +1,105 @@
+// This file belongs to the "MiniCore" game engine.
+// Copyright (C) 2018 Jussi Lind <jussi.lind@iki.fi>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+// MA  02110-1301, USA.
+//
+#include <QTest>
+#include "MCDepthSorterTest.hpp"
+#include "../../Core/mcobject.hh"
+#include "../../Graphics/mcdepthsorter.hh"
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+namespace {
+void createObjects(std::vector<std::unique_ptr<MCObject>> & objects, std::vector<MCObject *> & pointers, const std::vector<float> & zs)
+{
+    for (float z : zs)
+    {
+        objects.push_back(std::unique_ptr<MCObject>(new MCObject("TestObject")));
+        objects.back()->translate(MCVector3dF(0, 0, z));
+        pointers.push_back(objects.back().get());
+    }
+}
+}
+
+MCDepthSorterTest::MCDepthSorterTest()
+{
+}
+
+void MCDepthSorterTest::testKeyOrder()
+{
+    const std::vector<float> zs = {-1000.5f, -2.0f, -1.0f, -0.25f, 0.0f, 0.25f, 1.0f, 2.0f, 1000.5f};
+    for (size_t i = 1; i < zs.size(); i++)
+    {
+        QVERIFY(MCDepthSorter::key(zs[i - 1]) < MCDepthSorter::key(zs[i]));
+    }
+}
+
+void MCDepthSorterTest::testSort()
+{
+    std::vector<std::unique_ptr<MCObject>> objects;
+    std::vector<MCObject *> pointers;
+    createObjects(objects, pointers, {5, -3, 12.5f, 0, 7, -3.5f, 100, 1});
+
+    MCDepthSorter sorter;
+    sorter.sort(pointers);
+
+    QCOMPARE(pointers.size(), objects.size());
+    for (size_t i = 1; i < pointers.size(); i++)
+    {
+        QVERIFY(pointers[i - 1]->location().k() <= pointers[i]->location().k());
+    }
+}
+
+void MCDepthSorterTest::testSortIsStable()
+{
+    std::vector<std::unique_ptr<MCObject>> objects;
+    std::vector<MCObject *> pointers;
+    createObjects(objects, pointers, {2, 1, 2, 1, 3, 2, 1});
+
+    std::vector<MCObject *> expected = pointers;
+    std::stable_sort(expected.begin(), expected.end(), [] (const MCObject * l, const MCObject * r) {
+        return l->location().k() < r->location().k();
+    });
+
+    MCDepthSorter sorter;
+    sorter.sort(pointers);
+
+    QVERIFY(pointers == expected);
+}
+
+void MCDepthSorterTest::benchmarkSort()
+{
+    std::vector<float> zs;
+    for (int i = 0; i < 10000; i++)
+    {
+        zs.push_back(static_cast<float>((i * 7919) % 64) / 8);
+    }
+
+    std::vector<std::unique_ptr<MCObject>> objects;
+    std::vector<MCObject *> pointers;
+    createObjects(objects, pointers, zs);
+
+    MCDepthSorter sorter;
+    QBENCHMARK {
+        std::vector<MCObject *> batch = pointers;
+        sorter.sort(batch);
+    }
+}
+
+QTEST_GUILESS_MAIN(MCDepthSorterTest)
@@ -0,0 +1,138 @@
+// This file belongs to the "MiniCore" game engine.
+// Copyright (C) 2018 Jussi Lind <jussi.lind@iki.fi>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+// MA  02110-1301, USA.
+//
+#include "MCEventQueueTest.hpp"
+#include "../../Core/mceventqueue.hh"
+#include "../../Core/mcobject.hh"
+#include "../../Physics/mccollisionevent.hh"
+
+#include <vector>
+
+typedef MCEventQueue<MCCollisionEvent> CollisionEventQueue;
+
+MCEventQueueTest::MCEventQueueTest()
+{
+}
+
+void MCEventQueueTest::init()
+{
+    CollisionEventQueue::instance().dispatch();
+    CollisionEventQueue::instance().resetCounters();
+}
+
+void MCEventQueueTest::testPostWithoutHandler()
+{
+    MCObject receiver("TestObject");
+    MCObject collider("TestObject");
+
+    auto && queue = CollisionEventQueue::instance();
+    QVERIFY(!queue.hasHandler(receiver));
+
+    queue.post(receiver, collider, MCVector3dF(1, 2, 3), true);
+
+    QCOMPARE(queue.generatedCount(), size_t(1));
+    QCOMPARE(queue.queuedCount(), size_t(0));
+
+    queue.dispatch();
+
+    QCOMPARE(queue.handledCount(), size_t(0));
+}
+
+void MCEventQueueTest::testDispatch()
+{
+    MCObject receiver("TestObject");
+    MCObject collider("TestObject");
+
+    std::vector<float> contactPointZ;
+    MCObject * collidingObject = nullptr;
+
+    auto && queue = CollisionEventQueue::instance();
+    queue.subscribe(receiver, [&] (MCCollisionEvent & event) {
+        contactPointZ.push_back(event.contactPoint().k());
+        collidingObject = &event.collidingObject();
+    });
+
+    QVERIFY(queue.hasHandler(receiver));
+    QVERIFY(receiver.hasEventHandler(MCCollisionEvent::typeId()));
+
+    queue.post(receiver, collider, MCVector3dF(1, 2, 3), true);
+    queue.post(receiver, collider, MCVector3dF(4, 5, 6), false);
+
+    // Nothing is delivered before dispatch
+    QCOMPARE(queue.queuedCount(), size_t(2));
+    QVERIFY(contactPointZ.empty());
+
+    queue.dispatch();
+
+    QCOMPARE(queue.queuedCount(), size_t(0));
+    QCOMPARE(contactPointZ.size(), size_t(2));
+    QCOMPARE(contactPointZ[0], 3.0f);
+    QCOMPARE(contactPointZ[1], 6.0f);
+    QCOMPARE(collidingObject, &collider);
+    QCOMPARE(queue.generatedCount(), size_t(2));
+    QCOMPARE(queue.handledCount(), size_t(2));
+
+    queue.unsubscribe(receiver);
+}
+
+void MCEventQueueTest::testUnsubscribe()
+{
+    MCObject receiver("TestObject");
+    MCObject collider("TestObject");
+
+    int received = 0;
+    auto && queue = CollisionEventQueue::instance();
+    queue.subscribe(receiver, [&] (MCCollisionEvent &) {
+        received++;
+    });
+
+    queue.post(receiver, collider, MCVector3dF(), true);
+    queue.unsubscribe(receiver);
+
+    QVERIFY(!queue.hasHandler(receiver));
+
+    queue.post(receiver, collider, MCVector3dF(), true);
+    queue.dispatch();
+
+    QCOMPARE(received, 0);
+    QCOMPARE(queue.generatedCount(), size_t(2));
+    QCOMPARE(queue.handledCount(), size_t(0));
+}
+
+void MCEventQueueTest::testDeletedReceiver()
+{
+    MCObject collider("TestObject");
+
+    int received = 0;
+    auto && queue = CollisionEventQueue::instance();
+
+    MCObject * receiver = new MCObject("TestObject");
+    queue.subscribe(*receiver, [&] (MCCollisionEvent &) {
+        received++;
+    });
+
+    queue.post(*receiver, collider, MCVector3dF(), true);
+    delete receiver;
+
+    queue.dispatch();
+
+    QCOMPARE(received, 0);
+    QCOMPARE(queue.handledCount(), size_t(0));
+}
+
+QTEST_GUILESS_MAIN(MCEventQueueTest)
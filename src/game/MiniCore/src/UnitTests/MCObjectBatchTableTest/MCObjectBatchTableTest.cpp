@@ -0,0 +1,181 @@
+// This file belongs to the "MiniCore" game engine.
+// Copyright (C) 2018 Jussi Lind <jussi.lind@iki.fi>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+// MA  02110-1301, USA.
+//
+#include "MCObjectBatchTableTest.hpp"
+#include "../../Core/mcobject.hh"
+#include "../../Graphics/mcobjectbatchtable.hh"
+
+#include <memory>
+#include <vector>
+
+MCObjectBatchTableTest::MCObjectBatchTableTest()
+{
+}
+
+void MCObjectBatchTableTest::testAdd()
+{
+    MCObject object1("TestObject");
+    MCObject object2("TestObject");
+    MCObject object3("TestObject");
+
+    MCObjectBatchTable table;
+    QVERIFY(!table.batch(1));
+
+    table.add(1, object1, 0);
+    table.add(2, object2, 0);
+    table.add(1, object3, 0);
+
+    QCOMPARE(table.size(), size_t(2));
+    QVERIFY(table.batch(1));
+    QCOMPARE(table.batch(1)->objectViewId, 1);
+    QCOMPARE(table.batch(1)->objects.size(), size_t(2));
+    QCOMPARE(table.batch(1)->objects[0], &object1);
+    QCOMPARE(table.batch(1)->objects[1], &object3);
+    QCOMPARE(table.batch(2)->objects.size(), size_t(1));
+    QCOMPARE(table.batch(2)->objects[0], &object2);
+}
+
+void MCObjectBatchTableTest::testClearKeepsBatches()
+{
+    MCObject object("TestObject");
+
+    MCObjectBatchTable table;
+    for (int i = 0; i < 100; i++)
+    {
+        table.add(1, object, 0);
+    }
+
+    const size_t capacity = table.batch(1)->objects.capacity();
+
+    table.clear();
+
+    QCOMPARE(table.size(), size_t(1));
+    QVERIFY(table.batch(1)->objects.empty());
+    QCOMPARE(table.batch(1)->objects.capacity(), capacity);
+
+    table.reset();
+
+    QCOMPARE(table.size(), size_t(0));
+    QVERIFY(!table.batch(1));
+}
+
+void MCObjectBatchTableTest::testPriority()
+{
+    MCObject object("TestObject");
+
+    MCObjectBatchTable table;
+    table.add(1, object, 2);
+    table.add(1, object, 5);
+    table.add(1, object, 3);
+
+    QCOMPARE(table.batch(1)->priority, 5.0f);
+
+    // The priority of the previous frame must not affect the new frame.
+    table.clear();
+    table.add(1, object, 1);
+
+    QCOMPARE(table.batch(1)->priority, 1.0f);
+}
+
+void MCObjectBatchTableTest::testSort()
+{
+    MCObject object("TestObject");
+
+    MCObjectBatchTable table;
+    table.add(1, object, 3);
+    table.add(2, object, 1);
+    table.add(3, object, 2);
+    table.add(4, object, 1);
+
+    QVERIFY(table.sort());
+
+    std::vector<int> order;
+    for (auto && batch : table)
+    {
+        order.push_back(batch.objectViewId);
+    }
+
+    // Sorting is stable.
+    QCOMPARE(order, std::vector<int>({2, 4, 3, 1}));
+
+    // Lookup must still work after the batches have been moved.
+    QCOMPARE(table.batch(1)->priority, 3.0f);
+    QCOMPARE(table.batch(2)->priority, 1.0f);
+    QCOMPARE(table.batch(3)->priority, 2.0f);
+    QCOMPARE(table.batch(4)->priority, 1.0f);
+}
+
+void MCObjectBatchTableTest::testSortOnlyWhenOrderChanges()
+{
+    MCObject object("TestObject");
+
+    MCObjectBatchTable table;
+    table.add(1, object, 2);
+    table.add(2, object, 1);
+
+    QVERIFY(table.sort());
+
+    // Same priorities as in the previous frame
+    table.clear();
+    table.add(1, object, 2);
+    table.add(2, object, 1);
+
+    QVERIFY(!table.sort());
+
+    // Batch that is not used in this frame keeps its priority
+    table.clear();
+    table.add(1, object, 2);
+
+    QVERIFY(!table.sort());
+
+    // Priorities change order
+    table.clear();
+    table.add(1, object, 0);
+    table.add(2, object, 1);
+
+    QVERIFY(table.sort());
+    QCOMPARE(table.begin()->objectViewId, 1);
+}
+
+void MCObjectBatchTableTest::benchmarkManyTypes()
+{
+    // Scene with hundreds of distinct object types, a few objects per type.
+    const int numTypes = 500;
+    const int objectsPerType = 4;
+
+    std::vector<std::unique_ptr<MCObject>> objects;
+    for (int i = 0; i < numTypes * objectsPerType; i++)
+    {
+        objects.push_back(std::unique_ptr<MCObject>(new MCObject("TestObject")));
+    }
+
+    MCObjectBatchTable table;
+    QBENCHMARK {
+        table.clear();
+        for (int i = 0; i < numTypes * objectsPerType; i++)
+        {
+            const int type = i % numTypes;
+            table.add(type * 1024, *objects[i], static_cast<float>(type % 10));
+        }
+        table.sort();
+    }
+
+    QCOMPARE(table.size(), size_t(numTypes));
+}
+
+QTEST_GUILESS_MAIN(MCObjectBatchTableTest)
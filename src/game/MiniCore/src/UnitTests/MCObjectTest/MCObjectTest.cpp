@@ -30,6 +30,9 @@
 #include "../../Core/mcvector3d.hh"
 
 #include <cmath>
+#include <functional>
+#include <memory>
+#include <vector>
 
 // Damping factor defined in MCObject
 static const float DAMPING = 0.999f;
@@ -274,6 +277,7 @@ void MCObjectTest::testChildRotate()
 
     const float rootAngle = 69;
     root.rotate(rootAngle); // Rotate children only when root rotates
+    MCObject::resolveChildTransforms();
 
     QVERIFY(root.angle() == rootAngle);
     QVERIFY(child1->angle() == child1Angle + rootAngle);
@@ -289,6 +293,7 @@ void MCObjectTest::testChildRotate()
 
     const MCVector3dF rootLocation(3, 4, 5);
     root.translate(rootLocation);
+    MCObject::resolveChildTransforms();
 
     QVERIFY(root.angle() == rootAngle);
     QVERIFY(child1->angle() == child1Angle + rootAngle);
@@ -305,6 +310,7 @@ void MCObjectTest::testChildRotate()
     child1Angle = 47;
     child1->rotateRelative(child1Angle);
     root.translate(rootLocation);
+    MCObject::resolveChildTransforms();
 
     vector3dCompare(child1->location(),
         rootLocation + MCVector3dF(MCMathUtil::rotatedVector(MCVector2dF(1.0, 1.0), rootAngle), 1.0f));
@@ -336,11 +342,45 @@ void MCObjectTest::testChildTranslate()
 
     root.translate(MCVector3dF(1, 2, 3)); // Translate children only when root translates
 
+    // Children are moved when the transforms are resolved
+    vector3dCompare(child1->location(), MCVector3dF(0, 0, 0));
+
+    MCObject::resolveChildTransforms();
+
     vector3dCompare(root.location(), MCVector3dF(1, 2, 3));
     vector3dCompare(child1->location(), MCVector3dF(2, 3, 4));
     vector3dCompare(child2->location(), MCVector3dF(3, 4, 5));
 }
 
+void MCObjectTest::testDeepHierarchyTransforms()
+{
+    MCObject root("root");
+
+    // Chain of children, each displaced by (1, 0, 0) from its parent
+    const int depth = 10;
+    std::vector<MCObjectPtr> chain;
+    MCObject * parent = &root;
+    for (int i = 0; i < depth; i++)
+    {
+        chain.push_back(MCObjectPtr(new MCObject("child")));
+        parent->addChildObject(chain.back(), MCVector3dF(1, 0, 0));
+        parent = chain.back().get();
+    }
+
+    // Multiple changes in a step are resolved in a single pass
+    root.translate(MCVector3dF(5, 5, 0));
+    root.rotate(90);
+    root.translate(MCVector3dF(10, 0, 0));
+    MCObject::resolveChildTransforms();
+
+    for (int i = 0; i < depth; i++)
+    {
+        QVERIFY(qFuzzyCompare(chain[i]->angle(), 90.0f));
+        vector3dCompare(chain[i]->location(),
+            MCVector3dF(10, 0, 0) + MCVector3dF(MCMathUtil::rotatedVector(MCVector2dF(i + 1, 0), 90), 0.0f));
+    }
+}
+
 void MCObjectTest::testCollisionLayer()
 {
     MCWorld world;
@@ -433,6 +473,20 @@ void MCObjectTest::testRotate()
     QVERIFY(qFuzzyCompare(shape->angle(), float(22)));
 }
 
+void MCObjectTest::testShapeAccessDoesNotShareOwnership()
+{
+    MCObject object("TestObject");
+    MCShapePtr shape(new MCRectShape(nullptr, 10, 10));
+    object.setShape(shape);
+
+    // Accessing the shape and the view must not touch the reference counts.
+    const long useCount = shape.use_count();
+    const MCShapePtr & shapeRef = object.shape();
+    QCOMPARE(shapeRef.get(), shape.get());
+    QVERIFY(!object.shape()->view());
+    QCOMPARE(shape.use_count(), useCount);
+}
+
 void MCObjectTest::testTimerEvent()
 {
     TestObject testObject1, testObject2;
@@ -560,4 +614,63 @@ void MCObjectTest::testVelocityIntegration()
     vector3dCompare(object.location(), location + velocity * DAMPING);
 }
 
+void MCObjectTest::benchmarkDeepHierarchy()
+{
+    // Trees of depth 4 with a branching factor of 4, moved several times per step
+    std::vector<std::unique_ptr<MCObject>> roots;
+    std::function<void (MCObject &, int)> addChildren = [&] (MCObject & parent, int depth) {
+        if (depth > 0)
+        {
+            for (int i = 0; i < 4; i++)
+            {
+                MCObjectPtr child(new MCObject("child"));
+                parent.addChildObject(child, MCVector3dF(1, 1, 0), 10);
+                addChildren(*child, depth - 1);
+            }
+        }
+    };
+
+    for (int i = 0; i < 10; i++)
+    {
+        roots.push_back(std::unique_ptr<MCObject>(new MCObject("root")));
+        addChildren(*roots.back(), 4);
+    }
+
+    int step = 0;
+    QBENCHMARK {
+        step++;
+        for (auto && root : roots)
+        {
+            root->rotate(step % 360);
+            root->translate(MCVector3dF(step % 100, 0, 0));
+            root->displace(MCVector3dF(0, 1, 0));
+        }
+        MCObject::resolveChildTransforms();
+    }
+}
+
+void MCObjectTest::benchmarkShapeAccess()
+{
+    // Typical per-frame access pattern of the collision detection and batching.
+    std::vector<std::unique_ptr<MCObject>> objects;
+    for (int i = 0; i < 1000; i++)
+    {
+        objects.push_back(std::unique_ptr<MCObject>(new MCObject("TestObject")));
+        objects.back()->setShape(MCShapePtr(new MCRectShape(nullptr, 10, 10)));
+    }
+
+    float sum = 0;
+    QBENCHMARK {
+        for (auto && object : objects)
+        {
+            if (object->shape() && !object->shape()->view())
+            {
+                sum += object->shape()->radius();
+            }
+        }
+    }
+
+    QVERIFY(sum > 0);
+}
+
 QTEST_GUILESS_MAIN(MCObjectTest)
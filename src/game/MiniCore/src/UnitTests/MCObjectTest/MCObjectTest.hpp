@@ -45,6 +45,8 @@ private slots:
 
     void testCollisionLayer();
 
+    void testDeepHierarchyTransforms();
+
     void testDefaultFlags();
 
     void testDelete();
@@ -59,6 +61,8 @@ private slots:
 
     void testRotate();
 
+    void testShapeAccessDoesNotShareOwnership();
+
     void testTimerEvent();
 
     void testTranslate();
@@ -68,4 +72,8 @@ private slots:
     void testVelocityAndPreventSleeping();
 
     void testVelocityIntegration();
+
+    void benchmarkDeepHierarchy();
+
+    void benchmarkShapeAccess();
 };
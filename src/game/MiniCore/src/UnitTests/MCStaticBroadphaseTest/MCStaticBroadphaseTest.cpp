@@ -0,0 +1,201 @@
+// This file belongs to the "MiniCore" game engine.
+// Copyright (C) 2018 Jussi Lind <jussi.lind@iki.fi>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+// MA  02110-1301, USA.
+//
+#include <QTest>
+
+#include "MCStaticBroadphaseTest.hpp"
+#include "../../Core/mcworld.hh"
+#include "../../Core/mcobject.hh"
+#include "../../Physics/mcobjectgrid.hh"
+#include "../../Physics/mcphysicscomponent.hh"
+#include "../../Physics/mcrectshape.hh"
+#include "../../Physics/mcstaticbroadphase.hh"
+
+#include <memory>
+
+namespace {
+std::unique_ptr<MCObject> createObject(float x, float y, float w, float h, bool stationary)
+{
+    std::unique_ptr<MCObject> object(new MCObject("TEST_OBJECT"));
+    object->setShape(MCShapePtr(new MCRectShape(MCShapeViewPtr(), w, h)));
+    object->physicsComponent().setMass(stationary ? 0 : 1, stationary);
+    object->translate(MCVector3dF(x, y));
+    return object;
+}
+
+const MCBBox<float> BBOX(0, 0, 1000, 1000);
+}
+
+MCStaticBroadphaseTest::MCStaticBroadphaseTest()
+{
+}
+
+void MCStaticBroadphaseTest::testPossibleCollisions()
+{
+    MCWorld world;
+    world.setDimensions(0, 1000, 0, 1000, 0, 1000);
+
+    auto wall = createObject(500, 500, 100, 10, true);
+    auto hit = createObject(500, 505, 10, 10, false);
+    auto miss = createObject(100, 100, 10, 10, false);
+
+    MCStaticBroadphase broadphase(64);
+    broadphase.add(*wall);
+    broadphase.build(BBOX);
+    QCOMPARE(broadphase.colliderCount(), 1);
+    QVERIFY(broadphase.contains(*wall));
+
+    MCObjectGrid::CollisionVector collisions;
+    QCOMPARE(broadphase.getPossibleCollisions({hit.get(), miss.get()}, collisions), 1);
+    QCOMPARE(collisions.size(), size_t(2));
+    QVERIFY(collisions[0].first == hit.get() && collisions[0].second == wall.get());
+    QVERIFY(collisions[1].first == wall.get() && collisions[1].second == hit.get());
+}
+
+void MCStaticBroadphaseTest::testSpanningColliderIsReportedOnce()
+{
+    MCWorld world;
+    world.setDimensions(0, 1000, 0, 1000, 0, 1000);
+
+    // Both the wall and the object span several cells
+    auto wall = createObject(500, 500, 800, 10, true);
+    auto object = createObject(500, 500, 100, 100, false);
+
+    MCStaticBroadphase broadphase(16);
+    broadphase.add(*wall);
+    broadphase.build(BBOX);
+
+    MCObjectGrid::CollisionVector collisions;
+    QCOMPARE(broadphase.getPossibleCollisions({object.get()}, collisions), 1);
+    QCOMPARE(collisions.size(), size_t(2));
+
+    // The next query must find it again
+    collisions.clear();
+    QCOMPARE(broadphase.getPossibleCollisions({object.get()}, collisions), 1);
+}
+
+void MCStaticBroadphaseTest::testStationaryAndSleepingObjectsAreSkipped()
+{
+    MCWorld world;
+    world.setDimensions(0, 1000, 0, 1000, 0, 1000);
+
+    auto wall = createObject(500, 500, 100, 10, true);
+    auto stationary = createObject(500, 505, 10, 10, true);
+    auto sleeping = createObject(500, 505, 10, 10, false);
+    sleeping->physicsComponent().toggleSleep(true);
+
+    MCStaticBroadphase broadphase;
+    broadphase.add(*wall);
+    broadphase.build(BBOX);
+
+    MCObjectGrid::CollisionVector collisions;
+    QCOMPARE(broadphase.getPossibleCollisions({stationary.get(), sleeping.get()}, collisions), 0);
+    QVERIFY(collisions.empty());
+}
+
+void MCStaticBroadphaseTest::testNonPhysicsAndBypassingObjectsAreSkipped()
+{
+    MCWorld world;
+    world.setDimensions(0, 1000, 0, 1000, 0, 1000);
+
+    auto wall = createObject(500, 500, 100, 10, true);
+    auto particle = createObject(500, 505, 10, 10, false);
+    particle->setIsPhysicsObject(false);
+    auto bypassing = createObject(500, 505, 10, 10, false);
+    bypassing->setBypassCollisions(true);
+
+    MCStaticBroadphase broadphase;
+    broadphase.add(*wall);
+    broadphase.build(BBOX);
+
+    MCObjectGrid::CollisionVector collisions;
+    QCOMPARE(broadphase.getPossibleCollisions({particle.get(), bypassing.get()}, collisions), 0);
+    QVERIFY(collisions.empty());
+}
+
+void MCStaticBroadphaseTest::testCollisionLayers()
+{
+    MCWorld world;
+    world.setDimensions(0, 1000, 0, 1000, 0, 1000);
+
+    auto wall = createObject(500, 500, 100, 10, true);
+    wall->setCollisionLayer(1);
+    auto object = createObject(500, 505, 10, 10, false);
+
+    MCStaticBroadphase broadphase;
+    broadphase.add(*wall);
+    broadphase.build(BBOX);
+
+    MCObjectGrid::CollisionVector collisions;
+    QCOMPARE(broadphase.getPossibleCollisions({object.get()}, collisions), 0);
+
+    object->setCollisionLayer(1);
+    QCOMPARE(broadphase.getPossibleCollisions({object.get()}, collisions), 1);
+}
+
+void MCStaticBroadphaseTest::testRemove()
+{
+    MCWorld world;
+    world.setDimensions(0, 1000, 0, 1000, 0, 1000);
+
+    auto wall = createObject(500, 500, 100, 10, true);
+    auto object = createObject(500, 505, 10, 10, false);
+
+    MCStaticBroadphase broadphase;
+    broadphase.add(*wall);
+    broadphase.build(BBOX);
+
+    QVERIFY(broadphase.remove(*wall));
+    QVERIFY(!broadphase.remove(*wall));
+    QCOMPARE(broadphase.colliderCount(), 0);
+
+    MCObjectGrid::CollisionVector collisions;
+    QCOMPARE(broadphase.getPossibleCollisions({object.get()}, collisions), 0);
+}
+
+void MCStaticBroadphaseTest::testWorldMovesStationaryColliders()
+{
+    MCWorld world;
+    world.setDimensions(0, 1000, 0, 1000, 0, 1000);
+
+    auto wall = createObject(500, 500, 100, 10, true);
+    auto object = createObject(500, 508, 10, 10, false);
+    object->physicsComponent().preventSleeping(true);
+
+    world.addObject(*wall);
+    world.addObject(*object);
+    world.buildStaticBroadphase();
+
+    // The built-in walls are stationary, too
+    QCOMPARE(world.staticBroadphase().colliderCount(), 5);
+    QVERIFY(world.staticBroadphase().contains(*wall));
+    QVERIFY(!world.staticBroadphase().contains(*object));
+    QCOMPARE(world.objectCount(), 6);
+
+    world.stepTime(1);
+    QCOMPARE(world.staticPairCount(), 1);
+    QCOMPARE(world.dynamicPairCount(), 0);
+
+    world.removeObjectNow(*wall);
+    QVERIFY(!world.staticBroadphase().contains(*wall));
+
+    world.clear();
+    QCOMPARE(world.staticBroadphase().colliderCount(), 0);
+}
+
+QTEST_GUILESS_MAIN(MCStaticBroadphaseTest)
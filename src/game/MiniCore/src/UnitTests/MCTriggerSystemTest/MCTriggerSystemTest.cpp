@@ -0,0 +1,192 @@
+// This file belongs to the "MiniCore" game engine.
+// Copyright (C) 2018 Jussi Lind <jussi.lind@iki.fi>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+// MA  02110-1301, USA.
+//
+#include <QTest>
+
+#include "MCTriggerSystemTest.hpp"
+#include "../../Core/mcworld.hh"
+#include "../../Core/mcobject.hh"
+#include "../../Physics/mcobjectgrid.hh"
+#include "../../Physics/mcphysicscomponent.hh"
+#include "../../Physics/mcrectshape.hh"
+#include "../../Physics/mctriggerevent.hh"
+#include "../../Physics/mctriggersystem.hh"
+
+#include <vector>
+
+class TestTrigger : public MCObject
+{
+public:
+
+    TestTrigger()
+    : MCObject("TEST_TRIGGER")
+    {
+        setShape(MCShapePtr(new MCRectShape(MCShapeViewPtr(), 100, 100)));
+        setIsPhysicsObject(false);
+        setIsTriggerObject(true);
+        physicsComponent().setMass(0, true);
+
+        MCObject::subscribeTriggerEvent(*this);
+    }
+
+    virtual void triggerEvent(MCTriggerEvent & event) override
+    {
+        m_events.push_back(event.type());
+        event.accept();
+    }
+
+    std::vector<MCTriggerEvent::Type> m_events;
+};
+
+namespace {
+void createObject(MCObject & object)
+{
+    object.setShape(MCShapePtr(new MCRectShape(MCShapeViewPtr(), 10, 10)));
+    object.physicsComponent().preventSleeping(true); // Need to prevent sleeping, because we are testing with zero velocity
+}
+}
+
+MCTriggerSystemTest::MCTriggerSystemTest()
+{
+}
+
+void MCTriggerSystemTest::testEnterStayExit()
+{
+    MCWorld world;
+    world.setDimensions(0, 1000, 0, 1000, 0, 1000);
+
+    TestTrigger trigger;
+    world.addObject(trigger);
+    trigger.translate(MCVector3dF(500, 500));
+
+    MCObject object("TEST_OBJECT");
+    createObject(object);
+    world.addObject(object);
+    object.translate(MCVector3dF(500, 500));
+
+    world.stepTime(1);
+    QCOMPARE(trigger.m_events.size(), size_t(1));
+    QVERIFY(trigger.m_events.back() == MCTriggerEvent::Type::Enter);
+
+    world.stepTime(1);
+    QCOMPARE(trigger.m_events.size(), size_t(2));
+    QVERIFY(trigger.m_events.back() == MCTriggerEvent::Type::Stay);
+
+    object.translate(MCVector3dF(100, 100));
+    world.stepTime(1);
+    QCOMPARE(trigger.m_events.size(), size_t(3));
+    QVERIFY(trigger.m_events.back() == MCTriggerEvent::Type::Exit);
+
+    world.stepTime(1);
+    QCOMPARE(trigger.m_events.size(), size_t(3));
+}
+
+void MCTriggerSystemTest::testTriggerIsNotInObjectGrid()
+{
+    MCWorld world;
+    world.setDimensions(0, 1000, 0, 1000, 0, 1000);
+
+    TestTrigger trigger;
+    world.addObject(trigger);
+    trigger.translate(MCVector3dF(500, 500));
+    QVERIFY(world.triggerSystem().isTrigger(trigger));
+
+    MCObject object("TEST_OBJECT");
+    createObject(object);
+    world.addObject(object);
+    object.translate(MCVector3dF(500, 500));
+
+    QVERIFY(world.objectGrid().getPossibleCollisions().empty());
+
+    world.stepTime(1);
+    QCOMPARE(world.dynamicPairCount(), 0);
+    QVERIFY(object.contacts().empty());
+    QCOMPARE(world.triggerSystem().overlapCount(), 1);
+}
+
+void MCTriggerSystemTest::testStationaryObjectsDontTrigger()
+{
+    MCWorld world;
+    world.setDimensions(0, 1000, 0, 1000, 0, 1000);
+
+    TestTrigger trigger;
+    world.addObject(trigger);
+    trigger.translate(MCVector3dF(500, 500));
+
+    MCObject object("TEST_OBJECT");
+    createObject(object);
+    object.physicsComponent().setMass(0, true);
+    world.addObject(object);
+    object.translate(MCVector3dF(500, 500));
+
+    world.stepTime(1);
+    QVERIFY(trigger.m_events.empty());
+}
+
+void MCTriggerSystemTest::testCollisionLayers()
+{
+    MCWorld world;
+    world.setDimensions(0, 1000, 0, 1000, 0, 1000);
+
+    TestTrigger trigger;
+    trigger.setCollisionLayer(1);
+    world.addObject(trigger);
+    trigger.translate(MCVector3dF(500, 500));
+
+    MCObject object("TEST_OBJECT");
+    createObject(object);
+    world.addObject(object);
+    object.translate(MCVector3dF(500, 500));
+
+    world.stepTime(1);
+    QVERIFY(trigger.m_events.empty());
+
+    trigger.setCollisionLayer(-1);
+    world.stepTime(1);
+    QCOMPARE(trigger.m_events.size(), size_t(1));
+    QVERIFY(trigger.m_events.back() == MCTriggerEvent::Type::Enter);
+}
+
+void MCTriggerSystemTest::testRemovedObjectIsForgotten()
+{
+    MCWorld world;
+    world.setDimensions(0, 1000, 0, 1000, 0, 1000);
+
+    TestTrigger trigger;
+    world.addObject(trigger);
+    trigger.translate(MCVector3dF(500, 500));
+
+    MCObject object("TEST_OBJECT");
+    createObject(object);
+    world.addObject(object);
+    object.translate(MCVector3dF(500, 500));
+
+    world.stepTime(1);
+    QCOMPARE(world.triggerSystem().overlapCount(), 1);
+
+    // No exit event, because the object might be deleted
+    world.removeObjectNow(object);
+    QCOMPARE(world.triggerSystem().overlapCount(), 0);
+    world.stepTime(1);
+    QCOMPARE(trigger.m_events.size(), size_t(1));
+
+    world.removeObjectNow(trigger);
+    QVERIFY(!world.triggerSystem().isTrigger(trigger));
+}
+
+QTEST_GUILESS_MAIN(MCTriggerSystemTest)
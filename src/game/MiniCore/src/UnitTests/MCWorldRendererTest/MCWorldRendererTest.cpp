@@ -0,0 +1,227 @@
+// This file belongs to the "MiniCore" game engine.
+// Copyright (C) 2018 Jussi Lind <jussi.lind@iki.fi>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+// MA  02110-1301, USA.
+//
+#include <QTest>
+#include "MCWorldRendererTest.hpp"
+#include "../../Core/mcobject.hh"
+#include "../../Graphics/mcobjectbatchtable.hh"
+#include "../../Graphics/mcobjectrendererbase.hh"
+#include "../../Graphics/mcworldrenderer.hh"
+
+#include <memory>
+#include <vector>
+
+namespace {
+MCObjectBatchTable::Batch & addBatch(MCObjectBatchTable & table, std::vector<std::unique_ptr<MCObject>> & objects, int count, bool isCpuBatchable, int viewId = 1)
+{
+    for (int i = 0; i < count; i++)
+    {
+        objects.push_back(std::unique_ptr<MCObject>(new MCObject("TestObject")));
+        table.add(viewId, *objects.back(), 0);
+    }
+
+    MCObjectBatchTable::Batch & batch = *table.batch(viewId);
+    batch.isCpuBatchable = isCpuBatchable;
+    return batch;
+}
+
+//! Counts the draws instead of drawing.
+class CountingBatchRenderer : public MCWorldRenderer::ObjectBatchRenderer
+{
+public:
+
+    void renderCpuBatch(MCRenderLayer::ObjectBatch & batch) override
+    {
+        QVERIFY(!m_bound);
+        cpuBatchDraws++;
+        cpuBatchedObjects += static_cast<int>(batch.objects.size());
+    }
+
+    void bindBatch(MCRenderLayer::ObjectBatch &) override
+    {
+        QVERIFY(!m_bound);
+        m_bound = true;
+        binds++;
+    }
+
+    void renderObject(MCObject &) override
+    {
+        QVERIFY(m_bound);
+        objectDraws++;
+    }
+
+    void releaseBatch(MCRenderLayer::ObjectBatch &) override
+    {
+        QVERIFY(m_bound);
+        m_bound = false;
+    }
+
+    int draws() const
+    {
+        return cpuBatchDraws + objectDraws;
+    }
+
+    int cpuBatchDraws = 0;
+
+    int cpuBatchedObjects = 0;
+
+    int objectDraws = 0;
+
+    int binds = 0;
+
+private:
+
+    bool m_bound = false;
+};
+}
+
+MCWorldRendererTest::MCWorldRendererTest()
+{
+}
+
+void MCWorldRendererTest::testLargeSurfaceBatchIsOneDrawCall()
+{
+    MCObjectBatchTable table;
+    std::vector<std::unique_ptr<MCObject>> objects;
+    auto && batch = addBatch(table, objects, 100, true);
+
+    QVERIFY(MCWorldRenderer::isCpuBatched(batch, 16));
+    QCOMPARE(MCWorldRenderer::drawCallCount(batch, 16), 1);
+    QCOMPARE(MCWorldRenderer::drawCallCount(batch, 100), 1);
+}
+
+void MCWorldRendererTest::testSmallBatchIsDrawnPerObject()
+{
+    MCObjectBatchTable table;
+    std::vector<std::unique_ptr<MCObject>> objects;
+    auto && batch = addBatch(table, objects, 15, true);
+
+    QVERIFY(!MCWorldRenderer::isCpuBatched(batch, 16));
+    QCOMPARE(MCWorldRenderer::drawCallCount(batch, 16), 15);
+}
+
+void MCWorldRendererTest::testNonSurfaceBatchIsDrawnPerObject()
+{
+    MCObjectBatchTable table;
+    std::vector<std::unique_ptr<MCObject>> objects;
+    auto && batch = addBatch(table, objects, 100, false);
+
+    QVERIFY(!MCWorldRenderer::isCpuBatched(batch, 16));
+    QCOMPARE(MCWorldRenderer::drawCallCount(batch, 16), 100);
+}
+
+void MCWorldRendererTest::testZeroThresholdDisablesCpuBatching()
+{
+    MCObjectBatchTable table;
+    std::vector<std::unique_ptr<MCObject>> objects;
+    auto && batch = addBatch(table, objects, 100, true);
+
+    QVERIFY(!MCWorldRenderer::isCpuBatched(batch, 0));
+    QCOMPARE(MCWorldRenderer::drawCallCount(batch, 0), 100);
+}
+
+void MCWorldRendererTest::testTooLargeBatchIsDrawnPerObject()
+{
+    MCObjectBatchTable table;
+    std::vector<std::unique_ptr<MCObject>> objects;
+    auto && batch = addBatch(table, objects, MCWorldRenderer::MAX_CPU_BATCH_SIZE + 1, true);
+
+    QVERIFY(!MCWorldRenderer::isCpuBatched(batch, 16));
+    QCOMPARE(MCWorldRenderer::drawCallCount(batch, 16), MCWorldRenderer::MAX_CPU_BATCH_SIZE + 1);
+}
+
+void MCWorldRendererTest::testFillInParallelCoversAllObjects()
+{
+    for (int count : {0, 1, MCObjectRendererBase::MIN_OBJECTS_PER_THREAD * 2 + 1, 10000})
+    {
+        std::vector<int> hits(count, 0);
+        MCObjectRendererBase::fillInParallel(count, [&] (int first, int last) {
+            for (int i = first; i < last; i++)
+            {
+                hits[i]++;
+            }
+        });
+
+        for (int i = 0; i < count; i++)
+        {
+            QCOMPARE(hits[i], 1);
+        }
+    }
+}
+
+void MCWorldRendererTest::testRenderObjectBatchesDrawsCpuBatchOnce()
+{
+    MCObjectBatchTable table;
+    std::vector<std::unique_ptr<MCObject>> objects;
+    addBatch(table, objects, 100, true);
+
+    CountingBatchRenderer renderer;
+    MCWorldRenderer::renderObjectBatches(table, 16, renderer);
+
+    QCOMPARE(renderer.cpuBatchDraws, 1);
+    QCOMPARE(renderer.cpuBatchedObjects, 100);
+    QCOMPARE(renderer.objectDraws, 0);
+    QCOMPARE(renderer.binds, 0);
+}
+
+void MCWorldRendererTest::testRenderObjectBatchesDrawsOtherObjectsOneByOne()
+{
+    MCObjectBatchTable table;
+    std::vector<std::unique_ptr<MCObject>> objects;
+    addBatch(table, objects, 15, true, 1);
+    addBatch(table, objects, 100, false, 2);
+
+    CountingBatchRenderer renderer;
+    MCWorldRenderer::renderObjectBatches(table, 16, renderer);
+
+    QCOMPARE(renderer.cpuBatchDraws, 0);
+    QCOMPARE(renderer.objectDraws, 115);
+    QCOMPARE(renderer.binds, 2);
+}
+
+void MCWorldRendererTest::testRenderObjectBatchesMatchesDrawCallCount()
+{
+    MCObjectBatchTable table;
+    std::vector<std::unique_ptr<MCObject>> objects;
+    addBatch(table, objects, 100, true, 1);
+    addBatch(table, objects, 15, true, 2);
+    addBatch(table, objects, 50, false, 3);
+    addBatch(table, objects, 16, true, 4);
+    addBatch(table, objects, MCWorldRenderer::MAX_CPU_BATCH_SIZE + 1, true, 5);
+
+    // Emptied batches are kept in the table from frame to frame
+    table.add(6, *objects.back(), 0);
+    table.batch(6)->objects.clear();
+
+    for (int threshold : {0, 16, 101})
+    {
+        int expected = 0;
+        for (auto && batch : table)
+        {
+            expected += MCWorldRenderer::drawCallCount(batch, threshold);
+        }
+
+        CountingBatchRenderer renderer;
+        MCWorldRenderer::renderObjectBatches(table, threshold, renderer);
+
+        QCOMPARE(renderer.draws(), expected);
+        QCOMPARE(renderer.cpuBatchedObjects + renderer.objectDraws, static_cast<int>(objects.size()));
+    }
+}
+
+QTEST_GUILESS_MAIN(MCWorldRendererTest)
@@ -19,6 +19,7 @@
 
 #include "MCWorldTest.hpp"
 #include "../../Core/mcworld.hh"
+#include "../../Core/mceventqueue.hh"
 #include "../../Core/mcobject.hh"
 #include "../../Physics/mcrectshape.hh"
 #include "../../Physics/mccollisionevent.hh"
@@ -32,6 +33,7 @@ public:
     : MCObject("TEST_OBJECT")
     , m_collisionEventReceived(false)
     {
+        MCObject::subscribeCollisionEvent(*this);
     }
 
     virtual void collisionEvent(MCCollisionEvent & event)
@@ -132,6 +134,38 @@ void MCWorldTest::testSimpleCollision()
     QVERIFY(object2.m_collisionEventReceived);
 }
 
+void MCWorldTest::testCollisionEventsOnlyToSubscribers()
+{
+    MCWorld world;
+    world.setDimensions(-10, 10, -10, 10, -10, 10);
+
+    TestObject object1;
+    object1.setShape(MCShapePtr(new MCRectShape(MCShapeViewPtr(), 2.0, 2.0)));
+    object1.physicsComponent().preventSleeping(true);
+
+    TestObject object2;
+    MCObject::unsubscribeCollisionEvent(object2);
+    object2.setShape(MCShapePtr(new MCRectShape(MCShapeViewPtr(), 2.0, 2.0)));
+    object2.physicsComponent().preventSleeping(true);
+
+    world.addObject(object1);
+    world.addObject(object2);
+
+    object1.translate(MCVector3dF(-0.5, 0.0));
+    object2.translate(MCVector3dF( 0.5, 0.0));
+
+    auto && queue = MCEventQueue<MCCollisionEvent>::instance();
+    queue.resetCounters();
+
+    world.stepTime(1.0);
+
+    QVERIFY(object1.m_collisionEventReceived);
+    QVERIFY(!object2.m_collisionEventReceived);
+    QVERIFY(queue.handledCount() > 0);
+    QVERIFY(queue.generatedCount() > queue.handledCount());
+    QCOMPARE(queue.queuedCount(), size_t(0));
+}
+
 void MCWorldTest::testSleepingObjectRemovalFromIntegration()
 {
     MCWorld world;
@@ -37,5 +37,7 @@ private slots:
 
     void testSimpleCollision();
 
+    void testCollisionEventsOnlyToSubscribers();
+
     void testSleepingObjectRemovalFromIntegration();
 };
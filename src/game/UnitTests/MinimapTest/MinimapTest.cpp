@@ -0,0 +1,233 @@
+// This file is part of Dust Racing 2D.
+// Copyright (C) 2018 Jussi Lind <jussi.lind@iki.fi>
+//
+// Dust Racing 2D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// Dust Racing 2D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Dust Racing 2D. If not, see <http://www.gnu.org/licenses/>.
+
+#include <QTest>
+#include "MinimapTest.hpp"
+#include "../../map.hpp"
+#include "../../minimap.hpp"
+#include "../../tracktile.hpp"
+
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace {
+
+const unsigned int MAP_COLS = 20;
+
+const unsigned int MAP_ROWS = 10;
+
+const int MAX_MARKERS = 12;
+
+//! Counts the quads and the draws instead of drawing.
+class CountingBatch : public QuadBatch
+{
+public:
+
+    CountingBatch(MCSurface & surface, int maxQuads, bool dynamic)
+        : surface(&surface)
+        , maxQuads(maxQuads)
+        , dynamic(dynamic)
+    {
+    }
+
+    void clear() override
+    {
+        quads = 0;
+    }
+
+    bool add(const MCVector3dF &, float, float, float, const MCGLColor &) override
+    {
+        if (quads >= maxQuads)
+        {
+            return false;
+        }
+
+        quads++;
+        return true;
+    }
+
+    void update() override
+    {
+        updates++;
+    }
+
+    void draw() override
+    {
+        draws++;
+    }
+
+    MCSurface * surface;
+
+    int maxQuads;
+
+    bool dynamic;
+
+    int quads = 0;
+
+    int updates = 0;
+
+    int draws = 0;
+};
+
+using CountingBatchPtr = std::shared_ptr<CountingBatch>;
+
+//! Keeps the batches that the minimap creates.
+struct Batches
+{
+    Minimap::BatchFactory factory()
+    {
+        return [this] (MCSurface & surface, int maxQuads, bool dynamic) {
+            all.push_back(CountingBatchPtr(new CountingBatch(surface, maxQuads, dynamic)));
+            return all.back();
+        };
+    }
+
+    int draws() const
+    {
+        int draws = 0;
+        for (auto && batch : all)
+        {
+            draws += batch->draws;
+        }
+
+        return draws;
+    }
+
+    std::vector<CountingBatchPtr> all;
+};
+
+/*! The minimap only hands the surfaces to the batch factory, so stand-ins
+ *  without textures and vertex buffers are enough. Only their addresses matter. */
+MCSurface & surface(int index)
+{
+    static char surfaces[8];
+    return *reinterpret_cast<MCSurface *>(&surfaces[index]);
+}
+
+TrackTile & tileAt(Map & map, unsigned int x, unsigned int y)
+{
+    return *std::static_pointer_cast<TrackTile>(map.getTile(x, y));
+}
+
+/*! Give the tiles one of three preview surfaces by row, like straights, corners
+ *  and grass would have. Every fifth tile is excluded and every seventh row has
+ *  no preview at all. \return number of tiles of each surface on the minimap. */
+std::map<MCSurface *, int> setPreviews(Map & map)
+{
+    std::map<MCSurface *, int> counts;
+    for (unsigned int j = 0; j < MAP_ROWS; j++)
+    {
+        for (unsigned int i = 0; i < MAP_COLS; i++)
+        {
+            if (j % 7 == 6)
+            {
+                continue;
+            }
+
+            auto && tile = tileAt(map, i, j);
+            tile.setPreviewSurface(&surface(j % 3));
+
+            if ((j * MAP_COLS + i) % 5 == 4)
+            {
+                tile.setExcludeFromMinimap(true);
+            }
+            else
+            {
+                counts[&surface(j % 3)]++;
+            }
+        }
+    }
+
+    return counts;
+}
+
+} // namespace
+
+MinimapTest::MinimapTest()
+{
+}
+
+void MinimapTest::testTilesAreDrawnOncePerSurface()
+{
+    Map map(MAP_COLS, MAP_ROWS);
+    const auto counts = setPreviews(map);
+
+    Batches batches;
+    Minimap minimap(batches.factory(), surface(7), MAX_MARKERS);
+    QCOMPARE(batches.all.size(), size_t(1));
+    const auto markerBatch = batches.all.front();
+    QVERIFY(markerBatch->dynamic);
+    QCOMPARE(markerBatch->surface, &surface(7));
+    QCOMPARE(markerBatch->maxQuads, MAX_MARKERS);
+
+    minimap.initialize(nullptr, map, 100, 100, 200);
+
+    // One static batch per preview surface that holds all of its tiles
+    QCOMPARE(batches.all.size(), size_t(1 + counts.size()));
+    for (size_t i = 1; i < batches.all.size(); i++)
+    {
+        auto && batch = batches.all[i];
+        QVERIFY(!batch->dynamic);
+        QCOMPARE(batch->updates, 1);
+        QVERIFY(counts.count(batch->surface));
+        QCOMPARE(batch->quads, counts.at(batch->surface));
+        QCOMPARE(batch->maxQuads, counts.at(batch->surface));
+    }
+
+    // Every frame draws the tile batches and the marker batch once
+    const int frames = 3;
+    for (int frame = 0; frame < frames; frame++)
+    {
+        minimap.render(Minimap::CarVector(), nullptr, nullptr);
+        QCOMPARE(batches.draws(), (frame + 1) * static_cast<int>(counts.size() + 1));
+    }
+
+    for (auto && batch : batches.all)
+    {
+        QCOMPARE(batch->draws, frames);
+    }
+
+    // Only the markers are uploaded again
+    QCOMPARE(markerBatch->updates, frames);
+    QCOMPARE(markerBatch->quads, 0);
+    for (size_t i = 1; i < batches.all.size(); i++)
+    {
+        QCOMPARE(batches.all[i]->updates, 1);
+    }
+}
+
+void MinimapTest::testInitializeReplacesTileBatches()
+{
+    Map map(MAP_COLS, MAP_ROWS);
+    const auto counts = setPreviews(map);
+
+    Batches batches;
+    Minimap minimap(batches.factory(), surface(7), MAX_MARKERS);
+    minimap.initialize(nullptr, map, 100, 100, 200);
+    minimap.initialize(nullptr, map, 100, 100, 200);
+    QCOMPARE(batches.all.size(), size_t(1 + 2 * counts.size()));
+
+    minimap.render(Minimap::CarVector(), nullptr, nullptr);
+
+    // The batches of the previous track are not drawn anymore
+    QCOMPARE(batches.draws(), static_cast<int>(counts.size() + 1));
+    for (size_t i = 1; i <= counts.size(); i++)
+    {
+        QCOMPARE(batches.all[i]->draws, 0);
+    }
+}
+
+QTEST_GUILESS_MAIN(MinimapTest)
@@ -0,0 +1,151 @@
+// This file is part of Dust Racing 2D.
+// Copyright (C) 2018 Jussi Lind <jussi.lind@iki.fi>
+//
+// Dust Racing 2D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// Dust Racing 2D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Dust Racing 2D. If not, see <http://www.gnu.org/licenses/>.
+
+
+#include <QSettings>
+#include <QTest>
+#include "SettingsTest.hpp"
+#include "../../settings.hpp"
+#include "../../trackdata.hpp"
+
+#include <memory>
+#include <vector>
+
+namespace {
+
+//! Large enough for the lookups to dominate like with many user tracks.
+const int NUM_TRACKS = 300;
+
+const int LAP_COUNT = 5;
+
+const auto DIFFICULTY = DifficultyProfile::Difficulty::Medium;
+
+using TrackDataPtr = std::unique_ptr<TrackData>;
+
+std::vector<TrackDataPtr> createTracks(int count)
+{
+    std::vector<TrackDataPtr> tracks;
+    for (int i = 0; i < count; i++)
+    {
+        tracks.push_back(TrackDataPtr(new TrackData(QString("Track %1").arg(i), false, 1, 1)));
+    }
+
+    return tracks;
+}
+
+} // namespace
+
+SettingsTest::SettingsTest()
+{
+}
+
+void SettingsTest::initTestCase()
+{
+    // Keep the settings of the test away from the settings of the game.
+    QVERIFY(m_dir.isValid());
+    QSettings::setDefaultFormat(QSettings::IniFormat);
+    QSettings::setPath(QSettings::IniFormat, QSettings::UserScope, m_dir.path());
+}
+
+void SettingsTest::init()
+{
+    QSettings().clear();
+}
+
+void SettingsTest::testChangesArePersisted()
+{
+    const auto tracks = createTracks(3);
+
+    {
+        Settings settings;
+        settings.saveLapRecord(*tracks[0], 12345);
+        settings.saveRaceRecord(*tracks[1], 54321, LAP_COUNT, DIFFICULTY);
+        settings.saveBestPos(*tracks[2], 2, LAP_COUNT, DIFFICULTY);
+        settings.saveTrackUnlockStatus(*tracks[2], LAP_COUNT, DIFFICULTY);
+        settings.saveValue(Settings::lapCountKey(), 10);
+
+        // Served from memory before the changes are written
+        QCOMPARE(settings.loadLapRecord(*tracks[0]), 12345);
+        QCOMPARE(settings.loadBestPos(*tracks[2], LAP_COUNT, DIFFICULTY), 2);
+    }
+
+    // The destructor writes the pending changes
+    Settings settings;
+    QCOMPARE(settings.loadLapRecord(*tracks[0]), 12345);
+    QCOMPARE(settings.loadLapRecord(*tracks[1]), -1);
+    QCOMPARE(settings.loadRaceRecord(*tracks[1], LAP_COUNT, DIFFICULTY), 54321);
+    QCOMPARE(settings.loadRaceRecord(*tracks[1], LAP_COUNT + 1, DIFFICULTY), -1);
+    QCOMPARE(settings.loadBestPos(*tracks[2], LAP_COUNT, DIFFICULTY), 2);
+    QVERIFY(settings.loadTrackUnlockStatus(*tracks[2], LAP_COUNT, DIFFICULTY));
+    QVERIFY(!settings.loadTrackUnlockStatus(*tracks[0], LAP_COUNT, DIFFICULTY));
+    QCOMPARE(settings.loadValue(Settings::lapCountKey()), 10);
+}
+
+void SettingsTest::testResetRemovesGroup()
+{
+    const auto tracks = createTracks(2);
+
+    {
+        Settings settings;
+        settings.saveBestPos(*tracks[0], 1, LAP_COUNT, DIFFICULTY);
+        settings.saveLapRecord(*tracks[1], 1000);
+        settings.resetBestPos();
+
+        QCOMPARE(settings.loadBestPos(*tracks[0], LAP_COUNT, DIFFICULTY), -1);
+        QCOMPARE(settings.loadLapRecord(*tracks[1]), 1000);
+
+        // Saved again after the reset so the writes must stay in order
+        settings.saveBestPos(*tracks[1], 3, LAP_COUNT, DIFFICULTY);
+    }
+
+    Settings settings;
+    QCOMPARE(settings.loadBestPos(*tracks[0], LAP_COUNT, DIFFICULTY), -1);
+    QCOMPARE(settings.loadBestPos(*tracks[1], LAP_COUNT, DIFFICULTY), 3);
+    QCOMPARE(settings.loadLapRecord(*tracks[1]), 1000);
+}
+
+void SettingsTest::benchmarkUpdateLockedTracks()
+{
+    const auto tracks = createTracks(NUM_TRACKS);
+
+    {
+        Settings settings;
+        for (int i = 0; i < NUM_TRACKS; i += 2)
+        {
+            settings.saveTrackUnlockStatus(*tracks[i], LAP_COUNT, DIFFICULTY);
+            settings.saveBestPos(*tracks[i], i % 6 + 1, LAP_COUNT, DIFFICULTY);
+        }
+    }
+
+    Settings settings;
+    int unlocked = 0;
+
+    // The lookups of TrackLoader::updateLockedTracks() when the lap count or the difficulty changes
+    QBENCHMARK {
+        unlocked = 0;
+        for (auto && track : tracks)
+        {
+            if (settings.loadTrackUnlockStatus(*track, LAP_COUNT, DIFFICULTY))
+            {
+                unlocked++;
+                settings.loadBestPos(*track, LAP_COUNT, DIFFICULTY);
+            }
+        }
+    }
+
+    QCOMPARE(unlocked, NUM_TRACKS / 2);
+}
+
+QTEST_GUILESS_MAIN(SettingsTest)
@@ -51,9 +51,9 @@ void AI::update(bool isRaceCompleted)
         m_car.clearStatuses();
 
         const Route & route = m_track->trackData().route();
-        steerControl(route.get(m_car.currentTargetNodeIndex()));
+        steerControl(*route.get(m_car.currentTargetNodeIndex()));
 
-        TrackTile & currentTile = *m_track->trackTileAtLocation(m_car.location().i(), m_car.location().j());
+        TrackTile & currentTile = m_track->trackTileAtLocation(m_car.location().i(), m_car.location().j());
         speedControl(currentTile, isRaceCompleted);
 
         m_lastTargetNodeIndex = m_car.currentTargetNodeIndex();
@@ -65,10 +65,10 @@ void AI::setRandomTolerance()
     m_randomTolerance = MCRandom::randomVector2d() * TrackTileBase::TILE_W / 8;
 }
 
-void AI::steerControl(TargetNodeBasePtr tnode)
+void AI::steerControl(const TargetNodeBase & tnode)
 {
     // Initial target coordinates
-    MCVector3dF target(tnode->location().x(), tnode->location().y());
+    MCVector3dF target(tnode.location().x(), tnode.location().y());
     target -= MCVector3dF(m_car.location() + MCVector3dF(m_randomTolerance));
 
     float angle = MCTrigonom::radToDeg(std::atan2(target.j(), target.i()));
@@ -45,7 +45,7 @@ public:
 private:
 
     //! Steering logic.
-    void steerControl(TargetNodeBasePtr tnode);
+    void steerControl(const TargetNodeBase & tnode);
 
     //! Brake/accelerate logic.
     void speedControl(TrackTile & currentTile, bool isRaceCompleted);
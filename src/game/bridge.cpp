@@ -20,11 +20,11 @@
 #include "renderer.hpp"
 
 #include <MCAssetManager>
-#include <MCCollisionEvent>
 #include <MCObjectFactory>
 #include <MCPhysicsComponent>
 #include <MCRectShape>
 #include <MCSurface>
+#include <MCTriggerEvent>
 #include <MCVector2d>
 
 namespace {
@@ -50,6 +50,8 @@ Bridge::Bridge()
 
     physicsComponent().setMass(0, true);
 
+    MCObject::subscribeTriggerEvent(*this);
+
     const int railYDisplacement = 110;
 
     auto && railSurface = MCAssetManager::instance().surfaceManager().surface("wallLong");
@@ -113,12 +115,27 @@ void Bridge::enterObject(MCObject & object)
     }
 }
 
-void Bridge::collisionEvent(MCCollisionEvent & event)
+void Bridge::leaveObject(MCObject & object)
+{
+    object.setCollisionLayer(0); // MCObject default collision layer
+    object.physicsComponent().preventSleeping(false);
+
+    raiseObject(object, false);
+
+    m_objectsEntered.erase(&object);
+}
+
+void Bridge::triggerEvent(MCTriggerEvent & event)
 {
-    MCObject & object = event.collidingObject();
-    if (!object.physicsComponent().isStationary())
+    MCObject & object = event.object();
+    if (m_objectsEntered.count(&object))
     {
-        if (m_objectsEntered.count(&object))
+        if (event.type() == MCTriggerEvent::Type::Exit)
+        {
+            leaveObject(object);
+            m_objectsOnBridge.erase(&object);
+        }
+        else
         {
             object.setCollisionLayer(static_cast<int>(Layers::Collision::BridgeRails));
             object.physicsComponent().preventSleeping(true);
@@ -130,7 +147,8 @@ void Bridge::collisionEvent(MCCollisionEvent & event)
     }
 }
 
-// Check if object has left the bridge
+// Check if object has left the bridge without an exit event, e.g. it was
+// removed from the world or it entered a trigger but never the bridge.
 void Bridge::onStepTime(int)
 {
     const int frameTolerance = 2;
@@ -139,13 +157,7 @@ void Bridge::onStepTime(int)
     {
         if (m_tag > iter->second + frameTolerance)
         {
-            MCObject & object = *iter->first;
-            object.setCollisionLayer(0); // MCObject default collision layer
-            object.physicsComponent().preventSleeping(false);
-
-            raiseObject(object, false);
-
-            m_objectsEntered.erase(&object);
+            leaveObject(*iter->first);
             iter = m_objectsOnBridge.erase(iter);
         }
         else
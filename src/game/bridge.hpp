@@ -20,7 +20,7 @@
 
 #include <map>
 
-class MCCollisionEvent;
+class MCTriggerEvent;
 class MCSurface;
 class Car;
 
@@ -31,7 +31,7 @@ public:
     Bridge();
 
     //! \reimp
-    virtual void collisionEvent(MCCollisionEvent & event) override;
+    virtual void triggerEvent(MCTriggerEvent & event) override;
 
     //! \reimp
     virtual void onStepTime(int step) override;
@@ -42,6 +42,8 @@ private:
 
     void raiseObject(MCObject & object, bool raise);
 
+    void leaveObject(MCObject & object);
+
     std::map<MCObject *, int> m_objectsOnBridge;
 
     std::map<MCObject *, bool> m_objectsEntered;
@@ -17,9 +17,9 @@
 #include "bridge.hpp"
 #include "layers.hpp"
 
-#include <MCCollisionEvent>
-#include <MCRectShape>
 #include <MCPhysicsComponent>
+#include <MCRectShape>
+#include <MCTriggerEvent>
 
 static const char * BRIDGE_TRIGGER_ID = "bridgeTrigger";
 
@@ -36,12 +36,16 @@ BridgeTrigger::BridgeTrigger(Bridge & bridge)
     setIsTriggerObject(true);
 
     physicsComponent().setMass(0, true);
+
+    MCObject::subscribeTriggerEvent(*this);
 }
 
-void BridgeTrigger::collisionEvent(MCCollisionEvent & event)
+void BridgeTrigger::triggerEvent(MCTriggerEvent & event)
 {
-    if (!event.collidingObject().physicsComponent().isStationary())
+    // Only entering raises the object, so that an object leaving the bridge
+    // over the other end is not raised again.
+    if (event.type() == MCTriggerEvent::Type::Enter)
     {
-        m_bridge.enterObject(event.collidingObject());
+        m_bridge.enterObject(event.object());
     }
 }
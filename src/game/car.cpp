@@ -28,7 +28,7 @@
 #include <MCFrictionGenerator>
 #include <MCMathUtil>
 #include <MCPhysicsComponent>
-#include <MCRectShape>
+#include <MCPolygonShape>
 #include <MCShape>
 #include <MCSurface>
 #include <MCTrigonom>
@@ -41,7 +41,6 @@
 #include <memory>
 #include <string>
 
-using std::dynamic_pointer_cast;
 using std::static_pointer_cast;
 
 Car::Car(Description & desc, MCSurface & surface, unsigned int index, bool isHuman)
@@ -85,9 +84,17 @@ Car::Car(Description & desc, MCSurface & surface, unsigned int index, bool isHum
     // Override the default physics component to handle damage from impulses
     setPhysicsComponent(*(new CarPhysicsComponent(*this)));
 
+    // Cut the corners of the body so that the car slides along walls and other
+    // cars instead of hooking into them.
+    const float chamfer = 4;
+    setShape(MCShapePtr(new MCPolygonShape(
+        shape()->view(), MCPolygonShape::chamferedRect(surface.width(), surface.height(), chamfer))));
+
     setProperties(desc);
     initForceGenerators(desc);
 
+    MCObject::subscribeCollisionEvent(*this);
+
     // Note that the z-coordinate of the actual car body is 0. The small lift is done in the
     // surface vertex level and configured in surfaces.conf.
 
@@ -135,9 +142,8 @@ void Car::setProperties(Description & desc)
     physicsComponent().setRestitution(desc.restitution);
     setShadowOffset(MCVector3dF(5, -5, 1));
 
-    const float width = dynamic_pointer_cast<MCRectShape>(shape())->width();
-    const float height = dynamic_pointer_cast<MCRectShape>(shape())->height();
-    m_length = std::max(width, height);
+    const MCBBoxF bbox = shape()->bbox();
+    m_length = std::max(bbox.width(), bbox.height());
 }
 
 void Car::initForceGenerators(Description & desc)
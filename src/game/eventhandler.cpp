@@ -87,6 +87,12 @@ void EventHandler::disableCaptureMode()
 
 bool EventHandler::handleKeyPressEvent(QKeyEvent * event)
 {
+    if (event->key() == Qt::Key_F12 && !m_captureMode)
+    {
+        emit frameStatisticsToggled();
+        return true;
+    }
+
     if (StateMachine::instance().state() != StateMachine::State::Menu)
     {
         return handleGameKeyPressEvent(event);
@@ -276,7 +282,8 @@ bool EventHandler::mapKeyToAction(int player, InputHandler::Action action, int k
     if (key &&
         key != Qt::Key_Escape &&
         key != Qt::Key_Q &&
-        key != Qt::Key_P)
+        key != Qt::Key_P &&
+        key != Qt::Key_F12)
     {
         // Find the matching action and change the key
         auto iter = m_keyToActionMap.begin();
@@ -52,6 +52,8 @@ signals:
 
     void gameExited();
 
+    void frameStatisticsToggled();
+
     void soundRequested(QString handle);
 
     void cursorRevealed();
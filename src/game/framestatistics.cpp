@@ -0,0 +1,210 @@
+// This file is part of Dust Racing 2D.
+// Copyright (C) 2018 Jussi Lind <jussi.lind@iki.fi>
+//
+// Dust Racing 2D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// Dust Racing 2D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Dust Racing 2D. If not, see <http://www.gnu.org/licenses/>.
+
+#include "framestatistics.hpp"
+
+#include <QString>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+FrameStatistics::FrameStatistics(int maxSamples)
+: m_maxSamples(maxSamples)
+, m_samples(static_cast<int>(Stage::EndOfEnum))
+, m_counters(static_cast<int>(Counter::EndOfEnum))
+{
+    assert(maxSamples > 0);
+
+    for (Samples & samples : m_samples)
+    {
+        samples.values.reserve(m_maxSamples);
+    }
+
+    for (Samples & samples : m_counters)
+    {
+        samples.values.reserve(m_maxSamples);
+    }
+
+    m_sortBuffer.reserve(m_maxSamples);
+}
+
+void FrameStatistics::addValue(Samples & samples, qint64 value)
+{
+    if (static_cast<int>(samples.values.size()) < m_maxSamples)
+    {
+        samples.values.push_back(value);
+    }
+    else
+    {
+        samples.values[samples.next] = value;
+        samples.next = (samples.next + 1) % samples.values.size();
+    }
+}
+
+void FrameStatistics::addSample(Stage stage, qint64 nsecs)
+{
+    addValue(m_samples.at(static_cast<int>(stage)), nsecs);
+}
+
+void FrameStatistics::addCount(Counter counter, int count)
+{
+    addValue(m_counters.at(static_cast<int>(counter)), count);
+}
+
+qint64 FrameStatistics::percentile(const Samples & samples, double percent) const
+{
+    const std::vector<qint64> & values = samples.values;
+    if (values.empty())
+    {
+        return 0;
+    }
+
+    // Nearest-rank percentile
+    const double rank = std::ceil(percent / 100.0 * values.size());
+    const size_t index = static_cast<size_t>(std::min(std::max(rank, 1.0), static_cast<double>(values.size()))) - 1;
+
+    m_sortBuffer.assign(values.begin(), values.end());
+    std::nth_element(m_sortBuffer.begin(), m_sortBuffer.begin() + index, m_sortBuffer.end());
+
+    return m_sortBuffer[index];
+}
+
+qint64 FrameStatistics::max(const Samples & samples)
+{
+    const std::vector<qint64> & values = samples.values;
+    return values.empty() ? 0 : *std::max_element(values.begin(), values.end());
+}
+
+double FrameStatistics::percentile(Stage stage, double percent) const
+{
+    return percentile(samples(stage), percent) / 1000000.0;
+}
+
+double FrameStatistics::max(Stage stage) const
+{
+    return max(samples(stage)) / 1000000.0;
+}
+
+double FrameStatistics::percentile(Counter counter, double percent) const
+{
+    return percentile(m_counters.at(static_cast<int>(counter)), percent);
+}
+
+int FrameStatistics::max(Counter counter) const
+{
+    return static_cast<int>(max(m_counters.at(static_cast<int>(counter))));
+}
+
+int FrameStatistics::sampleCount(Stage stage) const
+{
+    return static_cast<int>(samples(stage).values.size());
+}
+
+void FrameStatistics::clear()
+{
+    for (Samples & samples : m_samples)
+    {
+        samples.values.clear();
+        samples.next = 0;
+    }
+
+    for (Samples & samples : m_counters)
+    {
+        samples.values.clear();
+        samples.next = 0;
+    }
+}
+
+std::vector<std::string> FrameStatistics::report() const
+{
+    std::vector<std::string> lines;
+    for (int i = 0; i < static_cast<int>(Stage::EndOfEnum); i++)
+    {
+        const Stage stage = static_cast<Stage>(i);
+        lines.push_back(QString().sprintf("%-8s p50 %5.2f  p99 %5.2f  max %5.2f ms (%d)",
+            stageName(stage), percentile(stage, 50), percentile(stage, 99), max(stage), sampleCount(stage)).toStdString());
+    }
+
+    for (int i = 0; i < static_cast<int>(Counter::EndOfEnum); i++)
+    {
+        const Counter counter = static_cast<Counter>(i);
+        lines.push_back(QString().sprintf("%-8s p50 %5.0f  p99 %5.0f  max %5d %s",
+            counterName(counter), percentile(counter, 50), percentile(counter, 99), max(counter), counterUnit(counter)).toStdString());
+    }
+
+    return lines;
+}
+
+const char * FrameStatistics::stageName(Stage stage)
+{
+    switch (stage)
+    {
+    case Stage::Interval:
+        return "Interval";
+    case Stage::Update:
+        return "Update";
+    case Stage::Render:
+        return "Render";
+    case Stage::Swap:
+        return "Swap";
+    case Stage::BatchBuild:
+        return "Batches";
+    case Stage::BatchWait:
+        return "Wait";
+    case Stage::Menu:
+        return "Menu";
+    default:
+        return "";
+    }
+}
+
+const char * FrameStatistics::counterName(Counter counter)
+{
+    switch (counter)
+    {
+    case Counter::DynamicPairs:
+        return "Dynamic";
+    case Counter::StaticPairs:
+        return "Static";
+    case Counter::DrawCalls:
+        return "Draws";
+    case Counter::HudAllocations:
+        return "HUD";
+    default:
+        return "";
+    }
+}
+
+const char * FrameStatistics::counterUnit(Counter counter)
+{
+    switch (counter)
+    {
+    case Counter::DynamicPairs:
+    case Counter::StaticPairs:
+        return "pairs";
+    case Counter::DrawCalls:
+        return "calls";
+    case Counter::HudAllocations:
+        return "allocs";
+    default:
+        return "";
+    }
+}
+
+const FrameStatistics::Samples & FrameStatistics::samples(Stage stage) const
+{
+    return m_samples.at(static_cast<int>(stage));
+}
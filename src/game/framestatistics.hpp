@@ -0,0 +1,136 @@
+// This file is part of Dust Racing 2D.
+// Copyright (C) 2018 Jussi Lind <jussi.lind@iki.fi>
+//
+// Dust Racing 2D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// Dust Racing 2D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Dust Racing 2D. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef FRAMESTATISTICS_HPP
+#define FRAMESTATISTICS_HPP
+
+#include <QtGlobal>
+
+#include <string>
+#include <vector>
+
+/*! Collects the durations of the recent frames per frame stage so that the
+ *  frame pacing can be inspected as percentiles instead of averages, which
+ *  hide the occasional long frames that are seen as stutter. Per-step counters,
+ *  e.g. the broadphase pair counts, are collected the same way. */
+class FrameStatistics
+{
+public:
+
+    enum class Stage : int
+    {
+        //! Time between two consecutive frames.
+        Interval = 0,
+
+        //! CPU time used to update the simulation and the overlays.
+        Update,
+
+        //! CPU time used to issue the rendering commands.
+        Render,
+
+        //! Time spent in the buffer swap, i.e. waiting for the GPU and vsync.
+        Swap,
+
+        //! Worker thread time used to build the render batches of the world.
+        BatchBuild,
+
+        //! Time the GL thread waited for the render batches. The rest of
+        //! BatchBuild overlapped with the rendering of the track and the menu.
+        BatchWait,
+
+        //! CPU time used to issue the rendering commands of the menus.
+        Menu,
+
+        EndOfEnum
+    };
+
+    enum class Counter : int
+    {
+        //! Possible collisions between moving objects.
+        DynamicPairs = 0,
+
+        //! Possible collisions between moving objects and static colliders.
+        StaticPairs,
+
+        //! All draw calls per frame, including the batched world and particle renderers.
+        DrawCalls,
+
+        //! Heap allocations of the HUD texts per frame. Zero in steady state.
+        HudAllocations,
+
+        EndOfEnum
+    };
+
+    //! Constructor.
+    //! \param maxSamples Number of recent samples kept per stage.
+    explicit FrameStatistics(int maxSamples = 600);
+
+    void addSample(Stage stage, qint64 nsecs);
+
+    void addCount(Counter counter, int count);
+
+    //! \return the given percentile (0..100) of the stage in msecs or 0 if no samples.
+    double percentile(Stage stage, double percent) const;
+
+    //! \return the longest recent duration of the stage in msecs.
+    double max(Stage stage) const;
+
+    //! \return number of recent samples of the stage.
+    int sampleCount(Stage stage) const;
+
+    //! \return the given percentile (0..100) of the counter or 0 if no samples.
+    double percentile(Counter counter, double percent) const;
+
+    //! \return the largest recent value of the counter.
+    int max(Counter counter) const;
+
+    void clear();
+
+    //! \return one line per stage with the sample count, p50, p99 and max and one line per counter.
+    std::vector<std::string> report() const;
+
+    static const char * stageName(Stage stage);
+
+    static const char * counterName(Counter counter);
+
+    static const char * counterUnit(Counter counter);
+
+private:
+
+    struct Samples
+    {
+        std::vector<qint64> values;
+
+        size_t next = 0;
+    };
+
+    const Samples & samples(Stage stage) const;
+
+    void addValue(Samples & samples, qint64 value);
+
+    qint64 percentile(const Samples & samples, double percent) const;
+
+    static qint64 max(const Samples & samples);
+
+    int m_maxSamples;
+
+    std::vector<Samples> m_samples;
+
+    std::vector<Samples> m_counters;
+
+    mutable std::vector<qint64> m_sortBuffer;
+};
+
+#endif // FRAMESTATISTICS_HPP
@@ -0,0 +1,68 @@
+// This file is part of Dust Racing 2D.
+// Copyright (C) 2018 Jussi Lind <jussi.lind@iki.fi>
+//
+// Dust Racing 2D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// Dust Racing 2D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Dust Racing 2D. If not, see <http://www.gnu.org/licenses/>.
+
+#include "framestatisticsoverlay.hpp"
+#include "framestatistics.hpp"
+#include "game.hpp"
+
+#include <MCAssetManager>
+
+static const int GLYPH_WIDTH  = 10;
+static const int GLYPH_HEIGHT = 10;
+
+// The percentiles are sorted from the sample buffers, so
+// refresh the texts only a couple of times per second.
+static const int UPDATES_PER_REFRESH = 30;
+
+FrameStatisticsOverlay::FrameStatisticsOverlay(const FrameStatistics & frameStatistics)
+: m_frameStatistics(frameStatistics)
+, m_font(MCAssetManager::textureFontManager().font(Game::instance().fontName()))
+, m_updateCounter(0)
+{
+}
+
+void FrameStatisticsOverlay::render()
+{
+    int y = height();
+    for (MCTextureText & line : m_lines)
+    {
+        y -= GLYPH_HEIGHT;
+        line.render(0, y, nullptr, m_font);
+    }
+}
+
+bool FrameStatisticsOverlay::update()
+{
+    if (m_updateCounter++ % UPDATES_PER_REFRESH)
+    {
+        return false;
+    }
+
+    const std::vector<std::string> report = m_frameStatistics.report();
+    while (m_lines.size() < report.size())
+    {
+        MCTextureText text(L"");
+        text.setGlyphSize(GLYPH_WIDTH, GLYPH_HEIGHT);
+        text.setShadowOffset(1, -1);
+        m_lines.push_back(text);
+    }
+
+    for (size_t i = 0; i < report.size(); i++)
+    {
+        m_lines[i].setText(std::wstring(report[i].begin(), report[i].end()));
+    }
+
+    return false;
+}
@@ -0,0 +1,53 @@
+// This file is part of Dust Racing 2D.
+// Copyright (C) 2018 Jussi Lind <jussi.lind@iki.fi>
+//
+// Dust Racing 2D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// Dust Racing 2D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Dust Racing 2D. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef FRAMESTATISTICSOVERLAY_HPP
+#define FRAMESTATISTICSOVERLAY_HPP
+
+#include "overlaybase.hpp"
+
+#include <MCTextureText>
+
+#include <vector>
+
+class FrameStatistics;
+class MCTextureFont;
+
+//! Debug overlay that shows the frame pacing statistics on top of the screen.
+class FrameStatisticsOverlay : public OverlayBase
+{
+public:
+
+    //! Constructor.
+    explicit FrameStatisticsOverlay(const FrameStatistics & frameStatistics);
+
+    //! \reimp
+    virtual void render() override;
+
+    //! \reimp
+    virtual bool update() override;
+
+private:
+
+    const FrameStatistics & m_frameStatistics;
+
+    MCTextureFont & m_font;
+
+    std::vector<MCTextureText> m_lines;
+
+    int m_updateCounter;
+};
+
+#endif // FRAMESTATISTICSOVERLAY_HPP
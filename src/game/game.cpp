@@ -40,19 +40,24 @@
 #include <QDesktopWidget>
 #include <QDir>
 #include <QThread>
-#include <QTime>
 #include <QScreen>
 #include <QSurfaceFormat>
 
+#include <algorithm>
 #include <cassert>
 
 static const unsigned int MAX_PLAYERS = 2;
 
+//! Number of tracks in the track selection menu with --track-menu-benchmark.
+static const unsigned int TRACK_MENU_BENCHMARK_ITEMS = 100;
+
 Game * Game::m_instance = nullptr;
 
 Game::Game(int & argc, char ** argv)
 : m_app(argc, argv)
 , m_forceNoVSync(false)
+, m_vsyncTimer(false)
+, m_trackMenuBenchmark(false)
 , m_settings()
 , m_difficultyProfile(m_settings.loadDifficulty())
 , m_inputHandler(new InputHandler(MAX_PLAYERS))
@@ -66,7 +71,10 @@ Game::Game(int & argc, char ** argv)
 , m_timeStep(1000 / m_updateFps)
 , m_lapCount(m_settings.loadValue(Settings::lapCountKey(), 5))
 , m_paused(false)
-, m_renderElapsed(0)
+, m_lastUpdateTime(0)
+, m_stepAccumulator(0)
+, m_droppedSteps(0)
+, m_frameStatisticsEnabled(false)
 , m_fps(m_settings.loadValue(Settings::fpsKey()) == 30 ? Fps::Fps30 : Fps::Fps60)
 , m_mode(Mode::OnePlayerRace)
 , m_splitType(SplitType::Vertical)
@@ -88,6 +96,7 @@ Game::Game(int & argc, char ** argv)
 
     connect(m_eventHandler, &EventHandler::pauseToggled, this, &Game::togglePause);
     connect(m_eventHandler, &EventHandler::gameExited, this, &Game::exitGame);
+    connect(m_eventHandler, &EventHandler::frameStatisticsToggled, this, &Game::toggleFrameStatistics);
 
     connect(m_eventHandler, &EventHandler::cursorRevealed, [this] () {
         m_renderer->setCursor(Qt::ArrowCursor);
@@ -99,15 +108,28 @@ Game::Game(int & argc, char ** argv)
 
     connect(m_eventHandler, SIGNAL(soundRequested(QString)), m_audioWorker, SLOT(playSound(QString)));
 
-    connect(&m_updateTimer, &QTimer::timeout, [this] () {
-        m_stateMachine->update();
-        m_scene->updateFrame(*m_inputHandler, m_timeStep);
-        m_scene->updateOverlays();
-        m_renderer->renderNow();
-    });
+    connect(&m_updateTimer, &QTimer::timeout, this, &Game::update);
 
+    // The default coarse timer may fire up to 5 % off the interval.
+    m_updateTimer.setTimerType(Qt::PreciseTimer);
     m_updateTimer.setInterval(m_updateDelay);
 
+    // With vsync the buffer swap blocks until the next refresh, so a zero-interval
+    // timer lets the display pace the updates. The fixed simulation steps keep
+    // the game speed independent of the refresh rate.
+    if (m_vsyncTimer)
+    {
+        if (!m_forceNoVSync && Settings::instance().loadVSync())
+        {
+            m_updateTimer.setInterval(0);
+            MCLogger().info() << "Using vsync-driven updates.";
+        }
+        else
+        {
+            MCLogger().warning() << "Vsync is disabled, ignoring --vsync-timer.";
+        }
+    }
+
     connect(m_stateMachine, &StateMachine::exitGameRequested, this, &Game::exitGame);
 
     // Add race track search paths
@@ -116,7 +138,7 @@ Game::Game(int & argc, char ** argv)
     m_trackLoader->addTrackSearchPath(QDir::homePath() + QDir::separator() +
         Config::Common::TRACK_SEARCH_PATH);
 
-    m_elapsed.start();
+    m_updateClock.start();
 }
 
 Game & Game::instance()
@@ -133,6 +155,10 @@ static void printHelp()
     std::cout << "--help        Show this help." << std::endl;
     std::cout << "--lang [lang] Force language: fi, fr, it, cs." << std::endl;
     std::cout << "--no-vsync    Force vsync off." << std::endl;
+    std::cout << "--vsync-timer Update on every vsync instead of a timer." << std::endl;
+    std::cout << "--track-menu-benchmark" << std::endl;
+    std::cout << "              Fill the track menu with " << TRACK_MENU_BENCHMARK_ITEMS
+              << " tracks. Frame statistics are logged on exit." << std::endl;
     std::cout << std::endl;
 }
 
@@ -174,6 +200,14 @@ void Game::parseArgs(int argc, char ** argv)
         {
             m_forceNoVSync = true;
         }
+        else if (args[i] == "--vsync-timer")
+        {
+            m_vsyncTimer = true;
+        }
+        else if (args[i] == "--track-menu-benchmark")
+        {
+            m_trackMenuBenchmark = true;
+        }
     }
 
     initTranslations(m_appTranslator, m_app, lang);
@@ -352,10 +386,13 @@ void Game::initScene()
     auto trackSelectionMenu = std::dynamic_pointer_cast<TrackSelectionMenu>(m_scene->trackSelectionMenu());
     assert(trackSelectionMenu);
 
-    // Add tracks to the menu.
-    for (unsigned int i = 0; i < m_trackLoader->tracks(); i++)
+    // Add tracks to the menu. The benchmark repeats the tracks to measure the menu
+    // with a large track collection: the Menu line of the frame statistics.
+    const unsigned int menuItems = m_trackMenuBenchmark ?
+        std::max(TRACK_MENU_BENCHMARK_ITEMS, m_trackLoader->tracks()) : m_trackLoader->tracks();
+    for (unsigned int i = 0; i < menuItems; i++)
     {
-        trackSelectionMenu->addTrack(*m_trackLoader->track(i));
+        trackSelectionMenu->addTrack(*m_trackLoader->track(i % m_trackLoader->tracks()));
     }
 
     // Set the current game scene. Renderer calls render()
@@ -387,6 +424,13 @@ void Game::init()
 void Game::start()
 {
     m_paused = false;
+
+    m_lastUpdateTime = m_updateClock.nsecsElapsed();
+    m_stepAccumulator = 0;
+
+    m_droppedSteps = 0;
+    m_frameStatistics.clear();
+
     m_updateTimer.start();
 }
 
@@ -394,6 +438,88 @@ void Game::stop()
 {
     m_paused = true;
     m_updateTimer.stop();
+
+    logFrameStatistics();
+}
+
+void Game::update()
+{
+    const qint64 now = m_updateClock.nsecsElapsed();
+    const qint64 interval = now - m_lastUpdateTime;
+    m_lastUpdateTime = now;
+
+    m_frameStatistics.addSample(FrameStatistics::Stage::Interval, interval);
+
+    // Run the simulation in fixed steps against the monotonic clock instead of
+    // one step per timer tick. Late ticks are caught up and early ones are
+    // compensated later, so the simulated time (and the race timing) follows
+    // the wall clock regardless of the timer and render rates. A quarter of a
+    // step is tolerated so that normal timer jitter doesn't alternate between
+    // zero and two steps per frame.
+    const qint64 stepNsecs = static_cast<qint64>(m_timeStep) * 1000000;
+    const int maxStepsPerUpdate = 4;
+
+    m_stepAccumulator += interval;
+
+    int steps = 0;
+    while (m_stepAccumulator >= stepNsecs - stepNsecs / 4)
+    {
+        if (steps == maxStepsPerUpdate)
+        {
+            // Too far behind, e.g. the window was being dragged: drop the rest.
+            m_droppedSteps += static_cast<int>(m_stepAccumulator / stepNsecs) + 1;
+            m_stepAccumulator = 0;
+            break;
+        }
+
+        m_stateMachine->update();
+        m_scene->updateFrame(*m_inputHandler, m_timeStep);
+
+        m_stepAccumulator -= stepNsecs;
+        steps++;
+    }
+
+    m_scene->updateOverlays();
+
+    m_frameStatistics.addSample(FrameStatistics::Stage::Update, m_updateClock.nsecsElapsed() - now);
+
+    m_renderer->renderNow();
+}
+
+void Game::logFrameStatistics()
+{
+    if (!m_frameStatistics.sampleCount(FrameStatistics::Stage::Interval))
+    {
+        return;
+    }
+
+    MCLogger().info() << "Frame statistics (target interval " << m_updateTimer.interval() << " ms, "
+                      << m_droppedSteps << " simulation steps dropped):";
+
+    for (const std::string & line : m_frameStatistics.report())
+    {
+        MCLogger().info() << "  " << line;
+    }
+}
+
+FrameStatistics & Game::frameStatistics()
+{
+    return m_frameStatistics;
+}
+
+bool Game::frameStatisticsEnabled() const
+{
+    return m_frameStatisticsEnabled;
+}
+
+void Game::toggleFrameStatistics()
+{
+    m_frameStatisticsEnabled = !m_frameStatisticsEnabled;
+
+    if (!m_frameStatisticsEnabled)
+    {
+        logFrameStatistics();
+    }
 }
 
 Game::Fps Game::fps() const
@@ -16,14 +16,15 @@
 #ifndef GAME_HPP
 #define GAME_HPP
 
+#include <QElapsedTimer>
 #include <QObject>
 #include <QTimer>
-#include <QTime>
 #include <QTranslator>
 
 #include <MCWorld>
 
 #include "application.hpp"
+#include "framestatistics.hpp"
 #include "settings.hpp"
 
 class AudioWorker;
@@ -116,10 +117,18 @@ public:
 
     const std::string & fontName() const;
 
+    FrameStatistics & frameStatistics();
+
+    //! \return true if the frame statistics overlay is shown.
+    bool frameStatisticsEnabled() const;
+
 public slots:
 
     void exitGame();
 
+    //! Show/hide the frame statistics overlay.
+    void toggleFrameStatistics();
+
 private slots:
 
     void init();
@@ -142,12 +151,21 @@ private:
 
     void stop();
 
+    //! Run the simulation steps that are due and render a frame.
+    void update();
+
+    void logFrameStatistics();
+
     Application m_app;
 
     QTranslator m_appTranslator;
 
     bool m_forceNoVSync;
 
+    bool m_vsyncTimer;
+
+    bool m_trackMenuBenchmark;
+
     Settings m_settings;
 
     DifficultyProfile m_difficultyProfile;
@@ -176,9 +194,19 @@ private:
 
     QTimer m_updateTimer;
 
-    QTime m_elapsed;
+    //! Monotonic clock that drives the simulation steps.
+    QElapsedTimer m_updateClock;
+
+    qint64 m_lastUpdateTime;
+
+    //! Wall clock time in nsecs not yet consumed by simulation steps.
+    qint64 m_stepAccumulator;
+
+    int m_droppedSteps;
+
+    FrameStatistics m_frameStatistics;
 
-    int m_renderElapsed;
+    bool m_frameStatisticsEnabled;
 
     Fps m_fps;
 
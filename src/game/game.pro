@@ -81,6 +81,8 @@ HEADERS += \
     eventhandler.hpp \
     fadeanimation.hpp \
     fontfactory.hpp \
+    framestatistics.hpp \
+    framestatisticsoverlay.hpp \
     game.hpp \
     graphicsfactory.hpp \
     inputhandler.hpp \
@@ -94,8 +96,10 @@ HEADERS += \
     overlaybase.hpp \
     particlefactory.hpp \
     pit.hpp \
+    quadbatch.hpp \
     race.hpp \
     renderable.hpp \
+    rendercache.hpp \
     renderer.hpp \
     scene.hpp \
     settings.hpp \
@@ -104,6 +108,7 @@ HEADERS += \
     startlights.hpp \
     startlightsoverlay.hpp \
     statemachine.hpp \
+    surfacebatch.hpp \
     timing.hpp \
     timingoverlay.hpp \
     tire.hpp \
@@ -135,6 +140,8 @@ HEADERS += \
     MiniCore/src/Core/mcbbox.hh \
     MiniCore/src/Core/mccast.hh \
     MiniCore/src/Core/mcevent.hh \
+    MiniCore/src/Core/mceventqueue.hh \
+    MiniCore/src/Core/mceventqueuebase.hh \
     MiniCore/src/Core/mclogger.hh \
     MiniCore/src/Core/mcmacros.hh \
     MiniCore/src/Core/mcmathutil.hh \
@@ -154,11 +161,13 @@ HEADERS += \
     MiniCore/src/Core/mcvectoranimation.hh \
     MiniCore/src/Core/mcworld.hh \
     MiniCore/src/Graphics/mccamera.hh \
+    MiniCore/src/Graphics/mcdepthsorter.hh \
     MiniCore/src/Graphics/mcglambientlight.hh \
     MiniCore/src/Graphics/mcglcolor.hh \
     MiniCore/src/Graphics/mcgldiffuselight.hh \
     MiniCore/src/Graphics/mcglmaterial.hh \
     MiniCore/src/Graphics/mcglobjectbase.hh \
+    MiniCore/src/Graphics/mcglparticlevertex.hh \
     MiniCore/src/Graphics/mcglscene.hh \
     MiniCore/src/Graphics/mcglshaderprogram.hh \
     MiniCore/src/Graphics/mcgltexcoord.hh \
@@ -170,18 +179,23 @@ HEADERS += \
     MiniCore/src/Graphics/mcshadersGLES.hh \
     MiniCore/src/Graphics/mcrenderlayer.hh \
     MiniCore/src/Graphics/mcshapeview.hh \
+    MiniCore/src/Graphics/mcstaticscenery.hh \
+    MiniCore/src/Graphics/mcstaticscenerychunk.hh \
     MiniCore/src/Graphics/mcsurface.hh \
     MiniCore/src/Graphics/mcsurfaceobjectrenderer.hh \
     MiniCore/src/Graphics/mcsurfaceview.hh \
+    MiniCore/src/Graphics/mcobjectbatchtable.hh \
     MiniCore/src/Graphics/mcobjectrendererbase.hh \
     MiniCore/src/Graphics/mcparticle.hh \
     MiniCore/src/Graphics/mcparticlerendererbase.hh \
     MiniCore/src/Graphics/mcsurfaceparticle.hh \
     MiniCore/src/Graphics/mcsurfaceparticlerenderer.hh \
     MiniCore/src/Graphics/mcworldrenderer.hh \
+    MiniCore/src/Physics/mccapsuleshape.hh \
     MiniCore/src/Physics/mccircleshape.hh \
     MiniCore/src/Physics/mccollisiondetector.hh \
     MiniCore/src/Physics/mccollisionevent.hh \
+    MiniCore/src/Physics/mccollisionfilter.hh \
     MiniCore/src/Physics/mccontact.hh \
     MiniCore/src/Physics/mcdragforcegenerator.hh \
     MiniCore/src/Physics/mcedge.hh \
@@ -193,11 +207,15 @@ HEADERS += \
     MiniCore/src/Physics/mcobjectgrid.hh \
     MiniCore/src/Physics/mcoutofboundariesevent.hh \
     MiniCore/src/Physics/mcphysicscomponent.hh \
+    MiniCore/src/Physics/mcpolygonshape.hh \
     MiniCore/src/Physics/mcrectshape.hh \
     MiniCore/src/Physics/mcsegment.hh \
     MiniCore/src/Physics/mcshape.hh \
     MiniCore/src/Physics/mcspringforcegenerator.hh \
     MiniCore/src/Physics/mcspringforcegenerator2dfast.hh \
+    MiniCore/src/Physics/mcstaticbroadphase.hh \
+    MiniCore/src/Physics/mctriggerevent.hh \
+    MiniCore/src/Physics/mctriggersystem.hh \
     MiniCore/src/Text/mctexturefont.hh \
     MiniCore/src/Text/mctexturefontconfigloader.hh \
     MiniCore/src/Text/mctexturefontdata.hh \
@@ -254,6 +272,8 @@ SOURCES += \
     eventhandler.cpp \
     fadeanimation.cpp \
     fontfactory.cpp \
+    framestatistics.cpp \
+    framestatisticsoverlay.cpp \
     game.cpp \
     graphicsfactory.cpp \
     inputhandler.cpp \
@@ -267,12 +287,14 @@ SOURCES += \
     particlefactory.cpp \
     pit.cpp \
     race.cpp \
+    rendercache.cpp \
     renderer.cpp \
     scene.cpp \
     settings.cpp \
     startlights.cpp \
     startlightsoverlay.cpp \
     statemachine.cpp \
+    surfacebatch.cpp \
     timing.cpp \
     timingoverlay.cpp \
     tire.cpp \
@@ -299,6 +321,7 @@ SOURCES += \
     MiniCore/src/Asset/mcsurfaceobjectdata.cc \
     MiniCore/src/Core/mcmathutil.cc \
     MiniCore/src/Core/mcevent.cc \
+    MiniCore/src/Core/mceventqueuebase.cc \
     MiniCore/src/Core/mclogger.cc \
     MiniCore/src/Core/mcobject.cc \
     MiniCore/src/Core/mcobjectcomponent.cc \
@@ -311,6 +334,7 @@ SOURCES += \
     MiniCore/src/Core/mcvectoranimation.cc \
     MiniCore/src/Core/mcworld.cc \
     MiniCore/src/Graphics/mccamera.cc \
+    MiniCore/src/Graphics/mcdepthsorter.cc \
     MiniCore/src/Graphics/mcglambientlight.cc \
     MiniCore/src/Graphics/mcgldiffuselight.cc \
     MiniCore/src/Graphics/mcglmaterial.cc \
@@ -321,15 +345,19 @@ SOURCES += \
     MiniCore/src/Graphics/mcmeshview.cc \
     MiniCore/src/Graphics/mcrenderlayer.cc \
     MiniCore/src/Graphics/mcshapeview.cc \
+    MiniCore/src/Graphics/mcstaticscenery.cc \
+    MiniCore/src/Graphics/mcstaticscenerychunk.cc \
     MiniCore/src/Graphics/mcsurface.cc \
     MiniCore/src/Graphics/mcsurfaceobjectrenderer.cc \
     MiniCore/src/Graphics/mcsurfaceview.cc \
+    MiniCore/src/Graphics/mcobjectbatchtable.cc \
     MiniCore/src/Graphics/mcobjectrendererbase.cc \
     MiniCore/src/Graphics/mcparticle.cc \
     MiniCore/src/Graphics/mcparticlerendererbase.cc \
     MiniCore/src/Graphics/mcsurfaceparticle.cc \
     MiniCore/src/Graphics/mcsurfaceparticlerenderer.cc \
     MiniCore/src/Graphics/mcworldrenderer.cc \
+    MiniCore/src/Physics/mccapsuleshape.cc \
     MiniCore/src/Physics/mccircleshape.cc \
     MiniCore/src/Physics/mccollisiondetector.cc \
     MiniCore/src/Physics/mccollisionevent.cc \
@@ -343,10 +371,14 @@ SOURCES += \
     MiniCore/src/Physics/mcobjectgrid.cc \
     MiniCore/src/Physics/mcoutofboundariesevent.cc \
     MiniCore/src/Physics/mcphysicscomponent.cc \
+    MiniCore/src/Physics/mcpolygonshape.cc \
     MiniCore/src/Physics/mcrectshape.cc \
     MiniCore/src/Physics/mcshape.cc \
     MiniCore/src/Physics/mcspringforcegenerator.cc \
     MiniCore/src/Physics/mcspringforcegenerator2dfast.cc \
+    MiniCore/src/Physics/mcstaticbroadphase.cc \
+    MiniCore/src/Physics/mctriggerevent.cc \
+    MiniCore/src/Physics/mctriggersystem.cc \
     MiniCore/src/Text/mctexturefont.cc \
     MiniCore/src/Text/mctexturefontconfigloader.cc \
     MiniCore/src/Text/mctexturefontdata.cc \
@@ -24,16 +24,32 @@
 
 #include <cmath>
 
+static const float SIZE_AMPLITUDE = 0.05f;
+
+static const float FOCUSED_SCALE = 1.25f;
+
 TextMenuItemView::TextMenuItemView(float textSize, MTFH::MenuItem & owner)
 : MenuItemView(owner)
 , m_textSize(textSize)
 , m_angle(MCRandom::getValue() * 2.0f * 3.1415f)
+, m_cachedTextSize(0)
+, m_cachedWidth(0)
+, m_cachedHeight(0)
 {
 }
 
 void TextMenuItemView::setTextSize(float size)
 {
     m_textSize = size;
+
+    invalidate();
+}
+
+void TextMenuItemView::invalidate()
+{
+    m_renderCache.invalidate();
+
+    m_cachedWidth = 0;
 }
 
 void TextMenuItemView::stepTime(int)
@@ -43,15 +59,46 @@ void TextMenuItemView::stepTime(int)
 
 void TextMenuItemView::render(float x, float y)
 {
-    MCTextureText text(owner().text());
-
-    const float amp = 0.05f;
-    float animatedSize = m_textSize + std::sin(m_angle) * m_textSize * amp;
+    float animatedSize = m_textSize + std::sin(m_angle) * m_textSize * SIZE_AMPLITUDE;
     if (owner().focused())
     {
-        animatedSize *= 1.25f;
+        animatedSize *= FOCUSED_SCALE;
+    }
+
+    if (!RenderCache::isAvailable())
+    {
+        renderText(x, y, animatedSize);
+        return;
     }
-    text.setGlyphSize(animatedSize, animatedSize);
+
+    // Cache the text at the largest animated size and animate the size by scaling the quad
+    if (!m_cachedWidth)
+    {
+        m_cachedTextSize = m_textSize * (1.0f + SIZE_AMPLITUDE) * (owner().focused() ? FOCUSED_SCALE : 1.0f);
+
+        MCTextureText text(owner().text());
+        text.setGlyphSize(m_cachedTextSize, m_cachedTextSize);
+
+        // Leave room for the half glyphs at the ends and the shadow
+        auto && font = MCAssetManager::textureFontManager().font(Game::instance().fontName());
+        m_cachedWidth = text.width(font) + 2 * m_cachedTextSize;
+        m_cachedHeight = 2 * m_cachedTextSize;
+    }
+
+    if (!m_renderCache.isValid(x, y, m_cachedWidth, m_cachedHeight))
+    {
+        m_renderCache.update(x, y, m_cachedWidth, m_cachedHeight, [&] () {
+            renderText(x, y, m_cachedTextSize);
+        });
+    }
+
+    m_renderCache.render(x, y, MCGLColor(1.0f, 1.0f, 1.0f, 1.0f), animatedSize / m_cachedTextSize);
+}
+
+void TextMenuItemView::renderText(float x, float y, float size)
+{
+    MCTextureText text(owner().text());
+    text.setGlyphSize(size, size);
 
     if (owner().focused())
     {
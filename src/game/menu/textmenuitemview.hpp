@@ -18,6 +18,8 @@
 
 #include <MenuItemView>
 
+#include "rendercache.hpp"
+
 namespace MTFH {
 class MenuItem;
 }
@@ -42,11 +44,24 @@ public:
     //! Set the text size.
     virtual void setTextSize(float size);
 
+    //! \reimp
+    virtual void invalidate() override;
+
 private:
 
+    void renderText(float x, float y, float size);
+
     float m_textSize;
 
     float m_angle;
+
+    RenderCache m_renderCache;
+
+    float m_cachedTextSize;
+
+    float m_cachedWidth;
+
+    float m_cachedHeight;
 };
 
 #endif // TEXTMENUITEMVIEW_HPP
@@ -17,6 +17,7 @@
 
 #include "game.hpp"
 #include "mainmenu.hpp"
+#include "rendercache.hpp"
 #include "scene.hpp"
 #include "settings.hpp"
 #include "renderer.hpp"
@@ -38,6 +39,7 @@
 #include "../common/mapbase.hpp"
 
 #include <cassert>
+#include <cstdlib>
 #include <memory>
 #include <sstream>
 
@@ -49,6 +51,10 @@ const int ANIMATION_STEPS = 15;
 
 const int ANIMATION_EXP = 3;
 
+//! The previews of the tracks next to the current one are kept cached, so that
+//! browsing back and forth doesn't re-render them. The others are released.
+const int PREVIEW_CACHE_RANGE = 1;
+
 std::string TrackSelectionMenu::MenuId = "trackSelection";
 
 class TrackItem : public MTFH::MenuItem
@@ -63,11 +69,11 @@ public:
     , m_star(MCAssetManager::surfaceManager().surface("star"))
     , m_glow(MCAssetManager::surfaceManager().surface("starGlow"))
     , m_lock(MCAssetManager::surfaceManager().surface("lock"))
-    , m_lapRecord(Settings::instance().loadLapRecord(m_track))
+    , m_lapRecord(Settings::instance().loadLapRecord(m_track.trackData()))
     , m_raceRecord(Settings::instance().loadRaceRecord(
-        m_track, m_game.lapCount(), m_game.difficultyProfile().difficulty()))
+        m_track.trackData(), m_game.lapCount(), m_game.difficultyProfile().difficulty()))
     , m_bestPos(Settings::instance().loadBestPos(
-        m_track, m_game.lapCount(), m_game.difficultyProfile().difficulty()))
+        m_track.trackData(), m_game.lapCount(), m_game.difficultyProfile().difficulty()))
     {
         auto && program = Renderer::instance().program("menu");
         m_star.setShaderProgram(program);
@@ -84,19 +90,25 @@ public:
     {
         MenuItem::setFocused(focused);
 
-        m_lapRecord  = Settings::instance().loadLapRecord(m_track);
+        m_lapRecord  = Settings::instance().loadLapRecord(m_track.trackData());
         m_raceRecord = Settings::instance().loadRaceRecord(
-            m_track, m_game.lapCount(), m_game.difficultyProfile().difficulty());
+            m_track.trackData(), m_game.lapCount(), m_game.difficultyProfile().difficulty());
         m_bestPos = Settings::instance().loadBestPos(
-            m_track, m_game.lapCount(), m_game.difficultyProfile().difficulty());
+            m_track.trackData(), m_game.lapCount(), m_game.difficultyProfile().difficulty());
     }
 
+    //! Free the cached preview. It's re-rendered when the item is shown next time.
+    void releasePreview();
+
     //! \reimp
     virtual void render() override;
 
 private:
 
-    void renderTiles();
+    //! Render the cached preview as a single quad. The preview is updated first if needed.
+    void renderPreview();
+
+    void renderTiles(const MCGLColor & color);
 
     void renderTitle();
 
@@ -123,9 +135,39 @@ private:
     int m_raceRecord;
 
     int m_bestPos;
+
+    RenderCache m_preview;
 };
 
-void TrackItem::renderTiles()
+void TrackItem::releasePreview()
+{
+    m_preview.release();
+}
+
+void TrackItem::renderPreview()
+{
+    const float previewX = menu()->x() + x();
+    const float previewY = menu()->y() + y();
+
+    const MCGLColor color = m_track.trackData().isLocked() ? MCGLColor(0.5, 0.5, 0.5) : MCGLColor(1.0, 1.0, 1.0);
+
+    if (!RenderCache::isAvailable())
+    {
+        renderTiles(color);
+        return;
+    }
+
+    if (!m_preview.isValid(previewX, previewY, width(), height()))
+    {
+        m_preview.update(previewX, previewY, width(), height(), [this] () {
+            renderTiles(MCGLColor(1.0, 1.0, 1.0));
+        });
+    }
+
+    m_preview.render(previewX, previewY, color);
+}
+
+void TrackItem::renderTiles(const MCGLColor & color)
 {
     const MapBase & rMap = m_track.trackData().map();
 
@@ -174,16 +216,7 @@ void TrackItem::renderTiles()
             {
                 surface->setShaderProgram(Renderer::instance().program("menu"));
                 surface->bind();
-
-                if (m_track.trackData().isLocked())
-                {
-                    surface->setColor(MCGLColor(0.5, 0.5, 0.5));
-                }
-                else
-                {
-                    surface->setColor(MCGLColor(1.0, 1.0, 1.0));
-                }
-
+                surface->setColor(color);
                 surface->setSize(tileH, tileW);
                 surface->render(
                     nullptr,
@@ -310,7 +343,7 @@ void TrackItem::renderTrackProperties()
 
 void TrackItem::render()
 {
-    renderTiles();
+    renderPreview();
 
     renderTitle();
 
@@ -338,6 +371,17 @@ void TrackSelectionMenu::addTrack(Track & track)
     setItemsToShow({0});
 }
 
+void TrackSelectionMenu::releaseHiddenPreviews()
+{
+    for (int i = 0; i < static_cast<int>(itemCount()); i++)
+    {
+        if (std::abs(i - currentIndex()) > PREVIEW_CACHE_RANGE)
+        {
+            std::static_pointer_cast<TrackItem>(item(i))->releasePreview();
+        }
+    }
+}
+
 void TrackSelectionMenu::left()
 {
     const int prevIndex = currentIndex();
@@ -353,6 +397,8 @@ void TrackSelectionMenu::left()
         currentItem()->resetAnimationCurve(ANIMATION_STEPS, ANIMATION_EXP);
 
         setItemsToShow({prevIndex, currentIndex()});
+
+        releaseHiddenPreviews();
     }
 }
 
@@ -371,6 +417,8 @@ void TrackSelectionMenu::right()
         currentItem()->resetAnimationCurve(ANIMATION_STEPS, ANIMATION_EXP);
 
         setItemsToShow({prevIndex, currentIndex()});
+
+        releaseHiddenPreviews();
     }
 }
 
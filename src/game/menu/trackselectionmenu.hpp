@@ -59,6 +59,9 @@ public:
 
 private:
 
+    //! Free the cached previews of the tracks that are not next to the current one.
+    void releaseHiddenPreviews();
+
     Track * m_selectedTrack;
 
     Scene & m_scene;
@@ -15,33 +15,23 @@
 
 #include "minimap.hpp"
 
-#include "game.hpp"
-#include "graphicsfactory.hpp"
-#include "renderer.hpp"
-#include "scene.hpp"
+#include "car.hpp"
 #include "tracktile.hpp"
 
-#include <MCSurface>
-
 #include "../common/mapbase.hpp"
 
+#include <map>
 #include <memory>
 
-Minimap::Minimap()
-    : m_markerSurface(&GraphicsFactory::generateMinimapMarker())
-{
-    m_markerSurface->setShaderProgram(Renderer::instance().program("menu"));
-    m_markerSurface->material()->setAlphaBlend(true);
-}
-
-Minimap::Minimap(Car & carToFollow, const MapBase & trackMap, int x, int y, int size)
+Minimap::Minimap(BatchFactory createBatch, MCSurface & markerSurface, int maxMarkers)
+    : m_createBatch(createBatch)
+    , m_markerBatch(createBatch(markerSurface, maxMarkers, true))
 {
-    initialize(carToFollow, trackMap, x, y, size);
 }
 
-void Minimap::initialize(Car & carToFollow, const MapBase & trackMap, int x, int y, int size)
+void Minimap::initialize(const Car * carToFollow, const MapBase & trackMap, int x, int y, int size)
 {
-    m_carToFollow = &carToFollow;
+    m_carToFollow = carToFollow;
 
     m_center = MCVector3dF(x, y);
 
@@ -72,7 +62,15 @@ void Minimap::initialize(Car & carToFollow, const MapBase & trackMap, int x, int
 
     initY = y - trackMap.rows() * m_tileH / 2;
 
-    m_map.clear();
+    // Collect the relevant tiles per surface
+    struct MinimapTile
+    {
+        MCVector3dF pos;
+
+        int rotation;
+    };
+
+    std::map<MCSurface *, std::vector<MinimapTile>> tilesBySurface;
 
     // Loop through the visible tile matrix and store relevant tiles
     float tileX, tileY;
@@ -86,15 +84,11 @@ void Minimap::initialize(Car & carToFollow, const MapBase & trackMap, int x, int
             auto surface = tile->previewSurface();
             if (surface && !tile->excludeFromMinimap())
             {
-                surface->setShaderProgram(Renderer::instance().program("menu"));
-                surface->setColor(MCGLColor(1.0, 1.0, 1.0));
-                surface->setSize(m_tileH, m_tileW);
-
                 MinimapTile minimapTile;
                 minimapTile.pos = MCVector3dF(tileX + m_tileW / 2, tileY + m_tileH / 2);
                 minimapTile.rotation = tile->rotation();
 
-                m_map[surface].push_back(minimapTile);
+                tilesBySurface[surface].push_back(minimapTile);
             }
 
             tileX += m_tileW;
@@ -103,6 +97,21 @@ void Minimap::initialize(Car & carToFollow, const MapBase & trackMap, int x, int
         tileY += m_tileH;
     }
 
+    // Bake the tiles so that each surface is drawn with a single call
+    m_tileBatches.clear();
+    for (auto && iter : tilesBySurface)
+    {
+        auto batch = m_createBatch(*iter.first, static_cast<int>(iter.second.size()), false);
+        for (auto && minimapTile : iter.second)
+        {
+            batch->add(minimapTile.pos, m_tileH, m_tileW, minimapTile.rotation, MCGLColor(1.0, 1.0, 1.0));
+        }
+
+        batch->update();
+
+        m_tileBatches.push_back(batch);
+    }
+
     m_sceneW = trackMap.cols() * TrackTile::TILE_W;
     m_sceneH = trackMap.rows() * TrackTile::TILE_H;
 
@@ -111,59 +120,49 @@ void Minimap::initialize(Car & carToFollow, const MapBase & trackMap, int x, int
 
 void Minimap::renderMap()
 {
-    for (auto && i : m_map)
+    for (auto && batch : m_tileBatches)
     {
-        auto surface = i.first;
-        surface->bind();
-        surface->setColor(MCGLColor(1.0, 1.0, 1.0));
-        surface->setSize(m_tileH, m_tileW);
-
-        for (auto && j : i.second)
-        {
-            const MinimapTile minimapTile = j;
-            surface->render(nullptr, minimapTile.pos, minimapTile.rotation);
-        }
+        batch->draw();
     }
 }
 
-void Minimap::renderMarkers(const Minimap::CarVector & cars, const Race & race)
+void Minimap::renderMarkers(const Minimap::CarVector & cars, const Car * leader, const Car * loser)
 {
-    m_markerSurface->setSize(m_tileH * 0.75f, m_tileW * 0.75f);
-
-    auto && leader = race.getLeader();
+    static const auto yellow = MCGLColor(0.9f, 0.9f, 0.1f, 0.9f);
+    static const auto green  = MCGLColor(0.1f, 0.9f, 0.1f, 0.9f);
+    static const auto red    = MCGLColor(0.9f, 0.1f, 0.1f, 0.9f);
+    static const auto gray   = MCGLColor(0.2f, 0.2f, 0.2f, 0.9f);
 
-    auto && loser = race.getLoser();
+    m_markerBatch->clear();
 
     for (auto && car : cars)
     {
+        const MCGLColor * color = &gray;
         if (car.get() == m_carToFollow)
         {
-            const auto yellow = MCGLColor(0.9f, 0.9f, 0.1f, 0.9f);
-            m_markerSurface->setColor(yellow);
+            color = &yellow;
         }
-        else if (car.get() == &leader)
+        else if (car.get() == leader)
         {
-            const auto green = MCGLColor(0.1f, 0.9f, 0.1f, 0.9f);
-            m_markerSurface->setColor(green);
+            color = &green;
         }
-        else if (car.get() == &loser)
+        else if (car.get() == loser)
         {
-            const auto red = MCGLColor(0.9f, 0.1f, 0.1f, 0.9f);
-            m_markerSurface->setColor(red);
-        }
-        else
-        {
-            const auto gray = MCGLColor(0.2f, 0.2f, 0.2f, 0.9f);
-            m_markerSurface->setColor(gray);
+            color = &red;
         }
 
-        m_markerSurface->render(nullptr, m_center + car->location() * m_size.i() / m_sceneW - m_size * 0.5f, 0);
+        m_markerBatch->add(
+            m_center + car->location() * m_size.i() / m_sceneW - m_size * 0.5f,
+            m_tileH * 0.75f, m_tileW * 0.75f, 0, *color);
     }
+
+    m_markerBatch->update();
+    m_markerBatch->draw();
 }
 
-void Minimap::render(const Minimap::CarVector & cars, const Race & race)
+void Minimap::render(const Minimap::CarVector & cars, const Car * leader, const Car * loser)
 {
     renderMap();
 
-    renderMarkers(cars, race);
+    renderMarkers(cars, leader, loser);
 }
@@ -16,49 +16,58 @@
 #ifndef MINIMAP_HPP
 #define MINIMAP_HPP
 
-#include <map>
+#include <functional>
+#include <memory>
 #include <vector>
 
-#include "car.hpp"
+#include "quadbatch.hpp"
 
 #include <MCVector3d>
 
+class Car;
 class MapBase;
 class MCSurface;
-class Race;
-class TrackTile;
 
+/*! Renders the track preview tiles and car markers.
+ *  The tiles are baked into one static batch per tile surface when
+ *  initialized, and the markers are drawn as a single dynamic batch. */
 class Minimap
 {
 public:
 
-    Minimap();
+    /*! Creates a batch of at most maxQuads quads of the given surface. Dynamic
+     *  batches are rebuilt every frame. The game creates SurfaceBatch's with the
+     *  menu shader, the unit tests count the draws instead. */
+    using BatchFactory = std::function<std::shared_ptr<QuadBatch> (MCSurface & surface, int maxQuads, bool dynamic)>;
 
-    Minimap(Car & carToFollow, const MapBase & trackMap, int x, int y, int size);
+    /*! Constructor.
+     *  \param createBatch Creates the tile batches and the marker batch.
+     *  \param markerSurface Surface of the car markers.
+     *  \param maxMarkers Max number of car markers. */
+    Minimap(BatchFactory createBatch, MCSurface & markerSurface, int maxMarkers);
 
-    void initialize(Car & carToFollow, const MapBase & trackMap, int x, int y, int size);
+    /*! Bake the tiles of the given map.
+     *  \param carToFollow Car whose marker is highlighted. */
+    void initialize(const Car * carToFollow, const MapBase & trackMap, int x, int y, int size);
 
-    using CarVector = std::vector<CarPtr>;
-    void render(const CarVector & cars, const Race & race);
+    using CarVector = std::vector<std::shared_ptr<Car>>;
+
+    //! Render the tiles and the car markers. The leader and the loser get their own colors.
+    void render(const CarVector & cars, const Car * leader, const Car * loser);
 
 private:
 
     void renderMap();
 
-    void renderMarkers(const CarVector & cars, const Race & race);
-
-    struct MinimapTile
-    {
-        MCVector3dF pos;
+    void renderMarkers(const CarVector & cars, const Car * leader, const Car * loser);
 
-        int rotation;
-    };
+    BatchFactory m_createBatch;
 
-    std::map<MCSurface *, std::vector<MinimapTile> > m_map;
+    std::vector<std::shared_ptr<QuadBatch>> m_tileBatches;
 
-    Car * m_carToFollow = nullptr;
+    std::shared_ptr<QuadBatch> m_markerBatch;
 
-    MCSurface * m_markerSurface = nullptr;
+    const Car * m_carToFollow = nullptr;
 
     MCVector3dF m_center;
 
@@ -41,7 +41,7 @@ void OffTrackDetector::update()
 
     {
         const MCVector3dF leftFrontTirePos(m_car.leftFrontTireLocation());
-        TrackTile & tile = *m_track->trackTileAtLocation(
+        TrackTile & tile = m_track->trackTileAtLocation(
             leftFrontTirePos.i(), leftFrontTirePos.j());
 
         m_car.setLeftSideOffTrack(false);
@@ -54,7 +54,7 @@ void OffTrackDetector::update()
 
     {
         const MCVector3dF rightFrontTirePos(m_car.rightFrontTireLocation());
-        TrackTile & tile = *m_track->trackTileAtLocation(
+        TrackTile & tile = m_track->trackTileAtLocation(
             rightFrontTirePos.i(), rightFrontTirePos.j());
 
         m_car.setRightSideOffTrack(false);
@@ -28,6 +28,35 @@ void OverlayBase::reset()
 {
 }
 
+void OverlayBase::setDimensions(int width, int height)
+{
+    Renderable::setDimensions(width, height);
+
+    invalidateCache();
+}
+
+void OverlayBase::invalidateCache()
+{
+    m_renderCache.invalidate();
+}
+
+void OverlayBase::renderCached(float x, float y, float width, float height, const std::function<void ()> & renderContent,
+    const MCGLColor & color)
+{
+    if (!RenderCache::isAvailable())
+    {
+        renderContent();
+        return;
+    }
+
+    if (!m_renderCache.isValid(x, y, width, height))
+    {
+        m_renderCache.update(x, y, width, height, renderContent);
+    }
+
+    m_renderCache.render(x, y, color);
+}
+
 OverlayBase::~OverlayBase()
 {
 }
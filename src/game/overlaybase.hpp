@@ -17,11 +17,14 @@
 #define OVERLAYBASE_HPP
 
 #include <MCBBox>
+#include <MCGLColor>
 
-
+#include "rendercache.hpp"
 #include "renderable.hpp"
 #include "updateableif.hpp"
 
+#include <functional>
+
 //! Base class for overlays that are rendered on top of the game scene.
 class OverlayBase : public UpdateableIf, public Renderable
 {
@@ -38,6 +41,28 @@ public:
 
     //! \reimp
     virtual void reset() override;
+
+    //! \reimp
+    virtual void setDimensions(int width, int height) override;
+
+    /*! Invalidate the cached static content so that it's re-rendered on
+     *  the next renderCached(), e.g. when the state of the overlay changes. */
+    void invalidateCache();
+
+protected:
+
+    /*! Render static content with renderContent into the cache texture only
+     *  if the cache has been invalidated and composite it as a single quad.
+     *  renderContent renders as usual and the area of the given size
+     *  centered at (x, y) is cached. The color is applied to the quad, so
+     *  renderContent should render untinted. The content is rendered
+     *  directly while caching isn't available, see RenderCache::isAvailable(). */
+    void renderCached(float x, float y, float width, float height, const std::function<void ()> & renderContent,
+        const MCGLColor & color = MCGLColor(1.0f, 1.0f, 1.0f, 1.0f));
+
+private:
+
+    RenderCache m_renderCache;
 };
 
 #endif // OVERLAYBASE_HPP
@@ -16,11 +16,11 @@
 #include "pit.hpp"
 #include "car.hpp"
 
-#include <MCCollisionEvent>
 #include <MCPhysicsComponent>
 #include <MCShape>
 #include <MCShapeView>
 #include <MCSurface>
+#include <MCTriggerEvent>
 
 Pit::Pit(MCSurface & surface)
 : MCObject(surface, "pit")
@@ -30,17 +30,23 @@ Pit::Pit(MCSurface & surface)
     setIsPhysicsObject(false);
     setIsTriggerObject(true);
     shape()->view()->setHasShadow(false);
+
+    MCObject::subscribeTriggerEvent(*this);
 }
 
-void Pit::collisionEvent(MCCollisionEvent & event)
+void Pit::triggerEvent(MCTriggerEvent & event)
 {
     // Cache type id integers.
     static unsigned int carType = MCObject::typeId("car");
 
-    if (event.collidingObject().typeId() == carType)
+    if (event.object().typeId() == carType)
     {
-        Car & car = static_cast<Car &>(event.collidingObject());
-        if (car.isHuman() && car.speedInKmh() < 25)
+        Car & car = static_cast<Car &>(event.object());
+        if (event.type() == MCTriggerEvent::Type::Exit)
+        {
+            m_pittingCars.erase(&car);
+        }
+        else if (car.isHuman() && car.speedInKmh() < 25)
         {
             if (m_pittingCars.find(&car) == m_pittingCars.end())
             {
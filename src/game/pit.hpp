@@ -21,7 +21,7 @@
 
 #include <map>
 
-class MCCollisionEvent;
+class MCTriggerEvent;
 class MCSurface;
 class Car;
 
@@ -36,7 +36,7 @@ public:
     Pit(MCSurface & surface);
 
     //! \reimp
-    virtual void collisionEvent(MCCollisionEvent & event) override;
+    virtual void triggerEvent(MCTriggerEvent & event) override;
 
     //! \reimp
     virtual void onStepTime(int step) override;
@@ -0,0 +1,46 @@
+// This file is part of Dust Racing 2D.
+// Copyright (C) 2018 Jussi Lind <jussi.lind@iki.fi>
+//
+// Dust Racing 2D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// Dust Racing 2D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Dust Racing 2D. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef QUADBATCH_HPP
+#define QUADBATCH_HPP
+
+#include <MCGLColor>
+#include <MCVector3d>
+
+/*! Quads that are drawn with a single call. Lets the users of batches,
+ *  like the minimap, be tested without OpenGL. */
+class QuadBatch
+{
+public:
+
+    //! Destructor.
+    virtual ~QuadBatch() {}
+
+    //! Remove all quads. update() must be called to take effect.
+    virtual void clear() = 0;
+
+    /*! Add a quad centered at the given location.
+     *  update() must be called to take effect.
+     *  \return false if the batch is full. */
+    virtual bool add(const MCVector3dF & location, float width, float height, float angle, const MCGLColor & color) = 0;
+
+    //! Upload the quads for drawing.
+    virtual void update() = 0;
+
+    //! Draw all quads with one call.
+    virtual void draw() = 0;
+};
+
+#endif // QUADBATCH_HPP
@@ -64,13 +64,13 @@ Race::Race(Game & game, unsigned int numCars)
     m_offTrackMessageTimer.setInterval(30000);
 
     connect(&m_timing, &Timing::lapRecordAchieved, [this] (int msecs) {
-        Settings::instance().saveLapRecord(*m_track, msecs);
+        Settings::instance().saveLapRecord(m_track->trackData(), msecs);
         emit messageRequested(QObject::tr("New lap record!"));
     });
 
     connect(&m_timing, &Timing::raceRecordAchieved, [this] (int msecs) {
         if (m_game.hasComputerPlayers()) {
-            Settings::instance().saveRaceRecord(*m_track, msecs, m_lapCount, m_game.difficultyProfile().difficulty());
+            Settings::instance().saveRaceRecord(m_track->trackData(), msecs, m_lapCount, m_game.difficultyProfile().difficulty());
             emit messageRequested(QObject::tr("New race record!"));
         }
     });
@@ -110,8 +110,8 @@ void Race::init(Track & track, int lapCount)
 
 void Race::initTiming()
 {
-    m_timing.setLapRecord(Settings::instance().loadLapRecord(*m_track));
-    m_timing.setRaceRecord(Settings::instance().loadRaceRecord(*m_track, m_lapCount, m_game.difficultyProfile().difficulty()));
+    m_timing.setLapRecord(Settings::instance().loadLapRecord(m_track->trackData()));
+    m_timing.setRaceRecord(Settings::instance().loadRaceRecord(m_track->trackData(), m_lapCount, m_game.difficultyProfile().difficulty()));
     m_timing.reset();
 }
 
@@ -189,7 +189,7 @@ void Race::translateCarsToStartPositions()
         // of the current race track.
         if (m_game.hasComputerPlayers() && !m_game.hasTwoHumanPlayers())
         {
-            const int bestPos = Settings::instance().loadBestPos(*m_track, m_lapCount, m_game.difficultyProfile().difficulty());
+            const int bestPos = Settings::instance().loadBestPos(m_track->trackData(), m_lapCount, m_game.difficultyProfile().difficulty());
             if (bestPos > 0)
             {
                 order.insert(order.begin() + bestPos - 1, *m_cars.begin());
@@ -278,7 +278,7 @@ bool Race::started()
     return m_started;
 }
 
-void Race::update()
+void Race::update(int step)
 {
     for (auto && car : m_cars)
     {
@@ -290,7 +290,7 @@ void Race::update()
     {
         auto && leader = getLeader();
         auto && route = m_track->trackData().route();
-        auto tnode = route.get(leader.currentTargetNodeIndex());
+        auto && tnode = route.get(leader.currentTargetNodeIndex());
 
         if (tnode->index() >= static_cast<int>(9 * route.numNodes() / 10))
         {
@@ -336,7 +336,7 @@ void Race::update()
         m_isfinishedSignalSent = true;
     }
 
-    m_timing.tick();
+    m_timing.tick(step * 1000);
 }
 
 void Race::pitStop(Car & car)
@@ -384,7 +384,7 @@ void Race::updateRouteProgress(Car & car)
     auto && route = m_track->trackData().route();
     unsigned int currentTargetNodeIndex = car.currentTargetNodeIndex();
     unsigned int nextTargetNodeIndex = car.nextTargetNodeIndex();
-    auto tnode = route.get(currentTargetNodeIndex);
+    auto && tnode = route.get(currentTargetNodeIndex);
     // Give a bit more tolerance for other than the finishing check point.
     const int tolerance = (currentTargetNodeIndex == 0 ? 0 : TrackTile::TILE_H / 20);
 
@@ -536,7 +536,7 @@ void Race::checkForNewBestPosition(const Car & car)
             const int pos = car.position();
             if (pos < m_bestPos || m_bestPos == -1)
             {
-                Settings::instance().saveBestPos(*m_track, pos, m_lapCount, m_game.difficultyProfile().difficulty());
+                Settings::instance().saveBestPos(m_track->trackData(), pos, m_lapCount, m_game.difficultyProfile().difficulty());
                 emit messageRequested(QObject::tr("A new best pos!"));
             }
 
@@ -546,7 +546,7 @@ void Race::checkForNewBestPosition(const Car & car)
                 if (pos <= UNLOCK_LIMIT)
                 {
                     next->trackData().setIsLocked(false);
-                    Settings::instance().saveTrackUnlockStatus(*next, m_lapCount, m_game.difficultyProfile().difficulty());
+                    Settings::instance().saveTrackUnlockStatus(next->trackData(), m_lapCount, m_game.difficultyProfile().difficulty());
                     emit messageRequested(QObject::tr("A new track unlocked!"));
                 }
                 else
@@ -564,7 +564,7 @@ void Race::checkIfCarIsStuck(Car & car)
     {
         static const int STUCK_LIMIT = 60 * 5; // 5 secs.
 
-        auto currentTile = m_track->trackTileAtLocation(car.location().i(), car.location().j());
+        auto currentTile = &m_track->trackTileAtLocation(car.location().i(), car.location().j());
         auto && counter = m_stuckHash[car.index()];
         if (counter.first == nullptr || counter.first != currentTile)
         {
@@ -615,7 +615,7 @@ void Race::moveCarOntoPreviousCheckPoint(Car & car)
     // stuck cars could be sent to the exactly same location and that would
     // result in really bad things.
     auto && route = m_track->trackData().route();
-    auto tnode = route.get(car.prevTargetNodeIndex());
+    auto && tnode = route.get(car.prevTargetNodeIndex());
     const int randRadius = 64;
     car.translate(MCVector3dF(
         tnode->location().x() + rand() % randRadius - randRadius / 2,
@@ -663,7 +663,7 @@ void Race::setTrack(Track & track, int lapCount)
 {
     m_lapCount = lapCount;
     m_track    = &track;
-    m_bestPos  = Settings::instance().loadBestPos(*m_track, m_lapCount, m_game.difficultyProfile().difficulty());
+    m_bestPos  = Settings::instance().loadBestPos(m_track->trackData(), m_lapCount, m_game.difficultyProfile().difficulty());
 
     for (OffTrackDetectorPtr otd : m_offTrackDetectors)
     {
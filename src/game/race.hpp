@@ -87,7 +87,8 @@ public slots:
 
     void stopEngineSounds();
 
-    void update();
+    //! Update the race situation. \param step Length of the simulation step in msecs.
+    void update(int step);
 
     void pitStop(Car & car);
 
@@ -142,7 +143,7 @@ private:
 
     // Data structure to determine if a car is stuck.
     // In that case we move the car onto the previous check point.
-    typedef std::pair<TrackTilePtr, int> StuckTileCounter; // Tile pointer and counter.
+    typedef std::pair<TrackTile *, int> StuckTileCounter; // Tile pointer and counter.
     typedef std::unordered_map<int, StuckTileCounter> StuckHash; // Car index to StuckTileCounter.
     StuckHash m_stuckHash;
 
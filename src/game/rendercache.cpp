@@ -0,0 +1,179 @@
+// This file is part of Dust Racing 2D.
+// Copyright (C) 2018 Jussi Lind <jussi.lind@iki.fi>
+//
+// Dust Racing 2D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// Dust Racing 2D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Dust Racing 2D. If not, see <http://www.gnu.org/licenses/>.
+
+#include "rendercache.hpp"
+#include "renderer.hpp"
+
+#include <MCGLM>
+#include <MCGLMaterial>
+#include <MCGLScene>
+#include <MCSurface>
+#include <MCWorld>
+#include <MCWorldRenderer>
+
+#include <QOpenGLContext>
+#include <QOpenGLFramebufferObject>
+#include <QOpenGLFunctions>
+
+#include <cmath>
+
+RenderCache::RenderCache()
+: m_width(0)
+, m_height(0)
+, m_isValid(false)
+{
+}
+
+bool RenderCache::isAvailable()
+{
+    return Renderer::instance().fadeValue() >= 1.0f;
+}
+
+void RenderCache::invalidate()
+{
+    // Keep the framebuffer so that it can be reused if the size doesn't change
+    m_isValid = false;
+}
+
+void RenderCache::release()
+{
+    m_surface.reset();
+    m_fbo.reset();
+    m_isValid = false;
+}
+
+bool RenderCache::mapToWindow(float x, float y, float width, float height, int & left, int & bottom, int & pixelWidth, int & pixelHeight)
+{
+    GLint viewport[4];
+    QOpenGLContext::currentContext()->functions()->glGetIntegerv(GL_VIEWPORT, viewport);
+
+    // The overlays are rendered on the z = 0 plane, where the projection is affine
+    const glm::mat4 & viewProjection = MCWorld::instance().renderer().glScene().viewProjectionMatrix();
+    const glm::vec4 p0 = viewProjection * glm::vec4(x - width / 2, y - height / 2, 0, 1);
+    const glm::vec4 p1 = viewProjection * glm::vec4(x + width / 2, y + height / 2, 0, 1);
+
+    const float x0 = viewport[0] + (p0.x / p0.w + 1) * viewport[2] / 2;
+    const float y0 = viewport[1] + (p0.y / p0.w + 1) * viewport[3] / 2;
+    const float x1 = viewport[0] + (p1.x / p1.w + 1) * viewport[2] / 2;
+    const float y1 = viewport[1] + (p1.y / p1.w + 1) * viewport[3] / 2;
+
+    left = static_cast<int>(std::round(x0));
+    bottom = static_cast<int>(std::round(y0));
+    pixelWidth = static_cast<int>(std::round(x1 - x0));
+    pixelHeight = static_cast<int>(std::round(y1 - y0));
+
+    return pixelWidth > 0 && pixelHeight > 0;
+}
+
+bool RenderCache::isValid(float x, float y, float width, float height) const
+{
+    if (!m_isValid || m_width != width || m_height != height)
+    {
+        return false;
+    }
+
+    int left, bottom, pixelWidth, pixelHeight;
+    if (!mapToWindow(x, y, width, height, left, bottom, pixelWidth, pixelHeight))
+    {
+        return false;
+    }
+
+    return m_fbo->width() == pixelWidth && m_fbo->height() == pixelHeight;
+}
+
+void RenderCache::update(float x, float y, float width, float height, const std::function<void ()> & renderContent)
+{
+    int left, bottom, pixelWidth, pixelHeight;
+    if (!mapToWindow(x, y, width, height, left, bottom, pixelWidth, pixelHeight))
+    {
+        invalidate();
+        return;
+    }
+
+    QOpenGLFunctions & gl = *QOpenGLContext::currentContext()->functions();
+
+    GLint prevFbo = 0;
+    gl.glGetIntegerv(GL_FRAMEBUFFER_BINDING, &prevFbo);
+
+    GLint prevViewport[4];
+    gl.glGetIntegerv(GL_VIEWPORT, prevViewport);
+
+    GLfloat prevClearColor[4];
+    gl.glGetFloatv(GL_COLOR_CLEAR_VALUE, prevClearColor);
+
+    const bool scissorTest = gl.glIsEnabled(GL_SCISSOR_TEST);
+
+    if (!m_fbo || m_fbo->width() != pixelWidth || m_fbo->height() != pixelHeight)
+    {
+        m_fbo.reset(new QOpenGLFramebufferObject(pixelWidth, pixelHeight));
+
+        // The cached content is composited scaled when animated
+        gl.glBindTexture(GL_TEXTURE_2D, m_fbo->texture());
+        gl.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        gl.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        gl.glBindTexture(GL_TEXTURE_2D, 0);
+    }
+
+    m_fbo->bind();
+
+    // Shift the viewport so that the cached area lands on the texture
+    gl.glViewport(prevViewport[0] - left, prevViewport[1] - bottom, prevViewport[2], prevViewport[3]);
+    gl.glDisable(GL_SCISSOR_TEST);
+    gl.glClearColor(0, 0, 0, 0);
+    gl.glClear(GL_COLOR_BUFFER_BIT);
+
+    MCGLMaterial::setPremultipliedTarget(true);
+    renderContent();
+    MCGLMaterial::setPremultipliedTarget(false);
+
+    gl.glBindFramebuffer(GL_FRAMEBUFFER, prevFbo);
+    gl.glViewport(prevViewport[0], prevViewport[1], prevViewport[2], prevViewport[3]);
+    gl.glClearColor(prevClearColor[0], prevClearColor[1], prevClearColor[2], prevClearColor[3]);
+    if (scissorTest)
+    {
+        gl.glEnable(GL_SCISSOR_TEST);
+    }
+
+    m_width = width;
+    m_height = height;
+    m_isValid = true;
+
+    // The content was blended on a transparent background with alpha accumulated
+    // separately, so the color of the texture is already multiplied by alpha
+    MCGLMaterialPtr material(new MCGLMaterial);
+    material->setTexture(m_fbo->texture(), 0);
+    material->setAlphaBlend(true, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+
+    m_surface.reset(new MCSurface("renderCache", material, width, height));
+    m_surface->setShaderProgram(Renderer::instance().program("menu"));
+}
+
+void RenderCache::render(float x, float y, const MCGLColor & color, float scale)
+{
+    if (!m_isValid)
+    {
+        return;
+    }
+
+    glDisable(GL_DEPTH_TEST);
+
+    m_surface->setColor(MCGLColor(color.r() * color.a(), color.g() * color.a(), color.b() * color.a(), color.a()));
+    m_surface->setSize(m_width * scale, m_height * scale);
+    m_surface->render(nullptr, MCVector3dF(x, y), 0);
+}
+
+RenderCache::~RenderCache()
+{
+}
@@ -0,0 +1,85 @@
+// This file is part of Dust Racing 2D.
+// Copyright (C) 2018 Jussi Lind <jussi.lind@iki.fi>
+//
+// Dust Racing 2D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// Dust Racing 2D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Dust Racing 2D. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef RENDERCACHE_HPP
+#define RENDERCACHE_HPP
+
+#include <MCGLColor>
+
+#include <functional>
+#include <memory>
+
+class MCSurface;
+class QOpenGLFramebufferObject;
+
+/*! Caches static content of overlays and menus into an FBO-backed texture.
+ *  The content is rendered into the texture only when the cache has been
+ *  invalidated or the resolution of the cached area has changed, and then
+ *  composited as a single quad. The content renders as usual in scene
+ *  coordinates; the cache captures the given area around it by shifting the
+ *  viewport, so the same render code works with and without the cache. */
+class RenderCache
+{
+public:
+
+    //! Constructor.
+    RenderCache();
+
+    //! Destructor.
+    ~RenderCache();
+
+    /*! \return true if the content can be cached at the moment. Content isn't
+     *  cached while the scene is fading, as the fade would get baked into the
+     *  texture. The content should be rendered directly instead. */
+    static bool isAvailable();
+
+    //! Invalidate the cached content so that it's re-rendered on the next update().
+    void invalidate();
+
+    //! Free the framebuffer. The content is re-rendered on the next update().
+    void release();
+
+    /*! \return true if the content of the area of the given size centered
+     *  at (x, y) is cached at the resolution of the current viewport. */
+    bool isValid(float x, float y, float width, float height) const;
+
+    /*! Render the content into the cache texture. The area of the given size
+     *  centered at (x, y) is captured. The framebuffer, the viewport and the
+     *  clear color are restored afterwards. */
+    void update(float x, float y, float width, float height, const std::function<void ()> & renderContent);
+
+    /*! Composite the cached content as a single quad centered at (x, y).
+     *  \param color Color multiplied with the cached content, e.g. to fade it out.
+     *  \param scale Scale of the quad relative to the cached area. */
+    void render(float x, float y, const MCGLColor & color = MCGLColor(1.0f, 1.0f, 1.0f, 1.0f), float scale = 1.0f);
+
+private:
+
+    /*! Map the given area to window coordinates of the current viewport.
+     *  \return false if the area is empty in pixels. */
+    static bool mapToWindow(float x, float y, float width, float height, int & left, int & bottom, int & pixelWidth, int & pixelHeight);
+
+    std::unique_ptr<QOpenGLFramebufferObject> m_fbo;
+
+    std::unique_ptr<MCSurface> m_surface;
+
+    float m_width;
+
+    float m_height;
+
+    bool m_isValid;
+};
+
+#endif // RENDERCACHE_HPP
@@ -17,6 +17,7 @@
 
 #include "eventhandler.hpp"
 #include "fontfactory.hpp"
+#include "framestatistics.hpp"
 #include "game.hpp"
 #include "scene.hpp"
 
@@ -41,6 +42,7 @@
 #include <QApplication>
 #include <QDesktopWidget>
 #include <QDir>
+#include <QElapsedTimer>
 #include <QFontDatabase>
 #include <QIcon>
 #include <QKeyEvent>
@@ -224,11 +226,14 @@ void Renderer::render()
         m_shadowFbo->setAttachment(QOpenGLFramebufferObject::Depth);
     }
 
+    // The world batches are built on a worker thread while the track is rendered
+    m_scene->prepareWorldRendering();
+
     m_fbo->bind();
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
     m_scene->renderTrack();
     m_scene->renderMenu();
-    m_scene->renderWorld(MCRenderGroup::Objects, true);
+    m_scene->renderWorld(MCRenderGroup::Objects);
     m_fbo->release();
 
     m_shadowFbo->bind();
@@ -337,9 +342,21 @@ void Renderer::renderNow()
     if (Game::instance().fps() == Game::Fps::Fps60 ||
         (Game::instance().fps() == Game::Fps::Fps30 && m_frameCounter & 0x01))
     {
+        QElapsedTimer timer;
+        timer.start();
+
+        MCGLObjectBase::resetDrawCallCount();
+
         render();
 
+        const qint64 renderTime = timer.nsecsElapsed();
+
         m_context->swapBuffers(this);
+
+        FrameStatistics & frameStatistics = Game::instance().frameStatistics();
+        frameStatistics.addSample(FrameStatistics::Stage::Render, renderTime);
+        frameStatistics.addSample(FrameStatistics::Stage::Swap, timer.nsecsElapsed() - renderTime);
+        frameStatistics.addCount(FrameStatistics::Counter::DrawCalls, MCGLObjectBase::drawCallCount());
     }
 }
 
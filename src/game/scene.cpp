@@ -23,7 +23,9 @@
 #include "carsoundeffectmanager.hpp"
 #include "checkeredflag.hpp"
 #include "fadeanimation.hpp"
+#include "framestatisticsoverlay.hpp"
 #include "game.hpp"
+#include "graphicsfactory.hpp"
 #include "inputhandler.hpp"
 #include "intro.hpp"
 #include "layers.hpp"
@@ -37,6 +39,7 @@
 #include "startlights.hpp"
 #include "startlightsoverlay.hpp"
 #include "statemachine.hpp"
+#include "surfacebatch.hpp"
 #include "timingoverlay.hpp"
 #include "track.hpp"
 #include "trackdata.hpp"
@@ -60,6 +63,7 @@
 #include <MCObject>
 #include <MCPhysicsComponent>
 #include <MCShape>
+#include <MCStaticScenery>
 #include <MCSurface>
 #include <MCSurfaceView>
 #include <MCTextureFont>
@@ -69,6 +73,7 @@
 
 #include <QObject>
 #include <QApplication>
+#include <QElapsedTimer>
 
 #include <algorithm>
 #include <cassert>
@@ -82,11 +87,32 @@ int Scene::m_height = 768;
 
 static const float METERS_PER_UNIT = 0.05f;
 
+namespace {
+
+//! Minimap batches are drawn with the menu shader.
+std::shared_ptr<QuadBatch> createMinimapBatch(MCSurface & surface, int maxQuads, bool dynamic)
+{
+    std::shared_ptr<SurfaceBatch> batch(new SurfaceBatch(surface, maxQuads, dynamic ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW));
+    batch->setShaderProgram(Renderer::instance().program("menu"));
+    return batch;
+}
+
+MCSurface & createMinimapMarker()
+{
+    MCSurface & marker = GraphicsFactory::generateMinimapMarker();
+    marker.setShaderProgram(Renderer::instance().program("menu"));
+    marker.material()->setAlphaBlend(true);
+    return marker;
+}
+
+} // namespace
+
 Scene::Scene(Game & game, StateMachine & stateMachine, Renderer & renderer, MCWorld & world)
 : m_game(game)
 , m_stateMachine(stateMachine)
 , m_renderer(renderer)
 , m_messageOverlay(new MessageOverlay)
+, m_frameStatisticsOverlay(new FrameStatisticsOverlay(game.frameStatistics()))
 , m_race(game, NUM_CARS)
 , m_activeTrack(nullptr)
 , m_world(world)
@@ -98,6 +124,7 @@ Scene::Scene(Game & game, StateMachine & stateMachine, Renderer & renderer, MCWo
 , m_intro(new Intro)
 , m_particleFactory(new ParticleFactory)
 , m_fadeAnimation(new FadeAnimation)
+, m_minimap{{createMinimapBatch, createMinimapMarker(), NUM_CARS}, {createMinimapBatch, createMinimapMarker(), NUM_CARS}}
 {
     connect(m_startlights, SIGNAL(raceStarted()), &m_race, SLOT(start()));
     connect(m_startlights, SIGNAL(animationEnded()), &m_stateMachine, SLOT(endStartlightAnimation()));
@@ -130,6 +157,7 @@ Scene::Scene(Game & game, StateMachine & stateMachine, Renderer & renderer, MCWo
     m_intro->setDimensions(width(), height());
     m_startlightsOverlay->setDimensions(width(), height());
     m_messageOverlay->setDimensions(width(), height());
+    m_frameStatisticsOverlay->setDimensions(width(), height());
 
     m_world.setMetersPerUnit(METERS_PER_UNIT);
 
@@ -218,7 +246,7 @@ void Scene::setupMinimaps()
 
     for (int i = 0; i < 2; i++)
     {
-        m_minimap[i].initialize(*m_cars[i], m_activeTrack->trackData().map(), minimapSize / 2 + 10, minimapY, minimapSize);
+        m_minimap[i].initialize(m_cars[i].get(), m_activeTrack->trackData().map(), minimapSize / 2 + 10, minimapY, minimapSize);
     }
 }
 
@@ -266,7 +294,7 @@ void Scene::updateFrame(InputHandler & handler, int step)
             }
 
             updateWorld(step);
-            updateRace();
+            updateRace(step);
 
             if (m_game.hasTwoHumanPlayers())
             {
@@ -306,18 +334,26 @@ void Scene::updateOverlays()
     m_crashOverlay[0].update();
 
     m_messageOverlay->update();
+
+    if (m_game.frameStatisticsEnabled())
+    {
+        m_frameStatisticsOverlay->update();
+    }
 }
 
 void Scene::updateWorld(float timeStep)
 {
     // Step time
     m_world.stepTime(timeStep);
+
+    m_game.frameStatistics().addCount(FrameStatistics::Counter::DynamicPairs, m_world.dynamicPairCount());
+    m_game.frameStatistics().addCount(FrameStatistics::Counter::StaticPairs, m_world.staticPairCount());
 }
 
-void Scene::updateRace()
+void Scene::updateRace(int step)
 {
     // Update race situation
-    m_race.update();
+    m_race.update(step);
 
     emit listenerLocationChanged(m_cars[0]->location().i(), m_cars[0]->location().j());
 }
@@ -478,19 +514,35 @@ void Scene::addTrackObjectsToWorld()
     createNormalObjects();
 
     createBridgeObjects();
+
+    // The track objects won't move anymore, so their collision shapes can be
+    // binned once instead of being tracked by the object grid
+    m_world.buildStaticBroadphase();
 }
 
 void Scene::createNormalObjects()
 {
     assert(m_activeTrack);
 
+    MCStaticScenery & staticScenery = m_world.renderer().staticScenery();
+
     for (unsigned int i = 0; i < m_activeTrack->trackData().objects().count(); i++)
     {
         auto trackObject = dynamic_pointer_cast<TrackObject>(m_activeTrack->trackData().objects().object(i));
         assert(trackObject);
 
         MCObject & object = trackObject->object();
-        object.addToWorld();
+
+        // Stationary objects are baked into the static scenery and only the
+        // object itself (i.e. its collision shape) is added to the world.
+        if (object.physicsComponent().isStationary() && staticScenery.add(object))
+        {
+            m_world.addObject(object);
+        }
+        else
+        {
+            object.addToWorld();
+        }
 
         // Set the base Z of mesh objects at ground level instead of at the object center
         float baseZ = 0;
@@ -510,6 +562,9 @@ void Scene::createNormalObjects()
             connect(pit, SIGNAL(pitStop(Car &)), &m_race, SLOT(pitStop(Car &)));
         }
     }
+
+    // Bake with the final locations
+    staticScenery.build();
 }
 
 void Scene::createBridgeObjects()
@@ -651,12 +706,18 @@ void Scene::renderMenu()
     case StateMachine::State::Menu:
     case StateMachine::State::MenuTransitionOut:
     case StateMachine::State::MenuTransitionIn:
-
+    {
         glScene.setSplitType(MCGLScene::ShowFullScreen);
 
+        QElapsedTimer timer;
+        timer.start();
+
         m_menuManager->render();
 
+        m_game.frameStatistics().addSample(FrameStatistics::Stage::Menu, timer.nsecsElapsed());
+
         break;
+    }
 
     default:
         break;
@@ -688,6 +749,12 @@ void Scene::renderCommonHUD()
     default:
         break;
     };
+
+    if (m_game.frameStatisticsEnabled())
+    {
+        MCWorld::instance().renderer().glScene().setSplitType(MCGLScene::ShowFullScreen);
+        m_frameStatisticsOverlay->render();
+    }
 }
 
 void Scene::renderHUD()
@@ -708,12 +775,12 @@ void Scene::renderHUD()
 
             glScene.setSplitType(p1);
             m_timingOverlay[1].render();
-            m_minimap[1].render(m_cars, m_race);
+            m_minimap[1].render(m_cars, &m_race.getLeader(), &m_race.getLoser());
             m_crashOverlay[1].render();
 
             glScene.setSplitType(p0);
             m_timingOverlay[0].render();
-            m_minimap[0].render(m_cars, m_race);
+            m_minimap[0].render(m_cars, &m_race.getLeader(), &m_race.getLoser());
             m_crashOverlay[0].render();
 
             glScene.setSplitType(MCGLScene::ShowFullScreen);
@@ -721,10 +788,14 @@ void Scene::renderHUD()
         else
         {
             m_timingOverlay[0].render();
-            m_minimap[0].render(m_cars, m_race);
+            m_minimap[0].render(m_cars, &m_race.getLeader(), &m_race.getLoser());
             m_crashOverlay[0].render();
         }
 
+        const int hudAllocations = m_timingOverlay[0].allocationCount() +
+            (m_game.hasTwoHumanPlayers() ? m_timingOverlay[1].allocationCount() : 0);
+        m_game.frameStatistics().addCount(FrameStatistics::Counter::HudAllocations, hudAllocations);
+
         break;
     }
     default:
@@ -732,7 +803,29 @@ void Scene::renderHUD()
     };
 }
 
-void Scene::renderWorld(MCRenderGroup renderGroup, bool prepareRendering)
+void Scene::prepareWorldRendering()
+{
+    switch (m_stateMachine.state())
+    {
+    case StateMachine::State::GameTransitionIn:
+    case StateMachine::State::GameTransitionOut:
+    case StateMachine::State::DoStartlights:
+    case StateMachine::State::Play:
+        if (m_game.hasTwoHumanPlayers())
+        {
+            m_world.prepareRenderingAsync({&m_camera[1], &m_camera[0]});
+        }
+        else
+        {
+            m_world.prepareRenderingAsync({&m_camera[0]});
+        }
+        break;
+    default:
+        break;
+    };
+}
+
+void Scene::renderWorld(MCRenderGroup renderGroup)
 {
     switch (m_stateMachine.state())
     {
@@ -748,12 +841,6 @@ void Scene::renderWorld(MCRenderGroup renderGroup, bool prepareRendering)
             MCGLScene::SplitType p1, p0;
             getSplitPositions(p1, p0);
 
-            if (prepareRendering)
-            {
-                m_world.prepareRendering(&m_camera[1]);
-                m_world.prepareRendering(&m_camera[0]);
-            }
-
             glScene.setSplitType(p1);
             m_world.render(&m_camera[1], renderGroup);
 
@@ -764,14 +851,17 @@ void Scene::renderWorld(MCRenderGroup renderGroup, bool prepareRendering)
         }
         else
         {
-            if (prepareRendering)
-            {
-                m_world.prepareRendering(&m_camera[0]);
-            }
-
             m_world.render(&m_camera[0], renderGroup);
         }
 
+        // The first group rendered waited for the batches built by prepareWorldRendering()
+        if (renderGroup == MCRenderGroup::Objects)
+        {
+            const MCWorldRenderer & worldRenderer = m_world.renderer();
+            m_game.frameStatistics().addSample(FrameStatistics::Stage::BatchBuild, worldRenderer.batchBuildNsecs());
+            m_game.frameStatistics().addSample(FrameStatistics::Stage::BatchWait, worldRenderer.batchWaitNsecs());
+        }
+
         break;
     }
     default:
@@ -785,6 +875,7 @@ Scene::~Scene()
     delete m_intro;
     delete m_menuManager;
     delete m_messageOverlay;
+    delete m_frameStatisticsOverlay;
     delete m_particleFactory;
     delete m_startlights;
     delete m_startlightsOverlay;
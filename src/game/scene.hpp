@@ -32,6 +32,7 @@
 
 class CheckeredFlag;
 class FadeAnimation;
+class FrameStatisticsOverlay;
 class Game;
 class InputHandler;
 class Intro;
@@ -101,7 +102,12 @@ public:
 
     void renderTrack();
 
-    void renderWorld(MCRenderGroup renderGroup, bool prepareRendering = false);
+    /*! Start building the render batches of the world on a worker thread.
+     *  The track and the menu can be rendered meanwhile, but the world must
+     *  not be updated before renderWorld() has been called. */
+    void prepareWorldRendering();
+
+    void renderWorld(MCRenderGroup renderGroup);
 
 signals:
 
@@ -147,7 +153,7 @@ private:
 
     void updateCameraLocation(MCCamera & camera, float & offset, MCObject & object);
 
-    void updateRace();
+    void updateRace(int step);
 
     void updateWorld(float timeStep);
 
@@ -163,6 +169,8 @@ private:
 
     MessageOverlay * m_messageOverlay;
 
+    FrameStatisticsOverlay * m_frameStatisticsOverlay;
+
     Race m_race;
 
     Track * m_activeTrack;
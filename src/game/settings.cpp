@@ -14,10 +14,11 @@
 // along with Dust Racing 2D. If not, see <http://www.gnu.org/licenses/>.
 
 #include "settings.hpp"
-#include "track.hpp"
 #include "trackdata.hpp"
+#include <QRunnable>
 #include <QSettings>
 #include <cassert>
+#include <utility>
 
 Settings * Settings::m_instance = nullptr;
 
@@ -27,14 +28,51 @@ static const char * SETTINGS_GROUP_RACE   = "RaceRecords";
 static const char * SETTINGS_GROUP_POS    = "BestPositions";
 static const char * SETTINGS_GROUP_UNLOCK = "UnlockedTracks";
 
-static QString combine(const Track & track, int lapCount, DifficultyProfile::Difficulty difficulty)
+// Delay after the latest change before the changes are written.
+static const int FLUSH_DELAY_MS = 1000;
+
+namespace {
+
+class FlushTask : public QRunnable
+{
+public:
+
+    explicit FlushTask(std::vector<std::pair<QString, QVariant>> && writes)
+        : m_writes(std::move(writes))
+    {}
+
+    void run() override
+    {
+        QSettings settings;
+        for (auto && write : m_writes)
+        {
+            if (write.second.isValid())
+            {
+                settings.setValue(write.first, write.second);
+            }
+            else
+            {
+                settings.remove(write.first);
+            }
+        }
+        settings.sync();
+    }
+
+private:
+
+    std::vector<std::pair<QString, QVariant>> m_writes;
+};
+
+} // namespace
+
+static QString combine(const TrackData & trackData, int lapCount, DifficultyProfile::Difficulty difficulty)
 {
-    return (QString("%1_%2_%3").arg(track.trackData().name()).arg(lapCount)).arg(static_cast<int>(difficulty));
+    return (QString("%1_%2_%3").arg(trackData.name()).arg(lapCount)).arg(static_cast<int>(difficulty));
 }
 
-static QString combineBase64(const Track & track, int lapCount, DifficultyProfile::Difficulty difficulty)
+static QString combineBase64(const TrackData & trackData, int lapCount, DifficultyProfile::Difficulty difficulty)
 {
-    return combine(track, lapCount, difficulty).toLatin1().toBase64();
+    return combine(trackData, lapCount, difficulty).toLatin1().toBase64();
 }
 
 QString Settings::difficultyKey()
@@ -71,6 +109,30 @@ Settings::Settings()
     m_actionToStringMap[InputHandler::Action::Down]  = "IA_DOWN";
     m_actionToStringMap[InputHandler::Action::Left]  = "IA_LEFT";
     m_actionToStringMap[InputHandler::Action::Right] = "IA_RIGHT";
+
+    QSettings settings;
+    for (auto && key : settings.allKeys())
+    {
+        m_values[key] = settings.value(key);
+    }
+
+    // Writes are done in the order they were made.
+    m_threadPool.setMaxThreadCount(1);
+
+    m_flushTimer.setSingleShot(true);
+    m_flushTimer.setInterval(FLUSH_DELAY_MS);
+    QObject::connect(&m_flushTimer, &QTimer::timeout, [this] () {
+        flush();
+    });
+}
+
+Settings::~Settings()
+{
+    flush();
+
+    m_threadPool.waitForDone();
+
+    Settings::m_instance = nullptr;
 }
 
 Settings & Settings::instance()
@@ -79,148 +141,123 @@ Settings & Settings::instance()
     return *Settings::m_instance;
 }
 
-void Settings::saveLapRecord(const Track & track, int msecs)
+QVariant Settings::value(QString group, QString key, QVariant defaultValue) const
 {
-    QSettings settings;
-
-    settings.beginGroup(SETTINGS_GROUP_LAP);
-    settings.setValue(track.trackData().name(), msecs);
-    settings.endGroup();
+    auto iter = m_values.find(group + "/" + key);
+    return iter != m_values.end() ? iter->second : defaultValue;
 }
 
-int Settings::loadLapRecord(const Track & track) const
+void Settings::setValue(QString group, QString key, QVariant value)
 {
-    QSettings settings;
+    const QString fullKey = group + "/" + key;
+    m_values[fullKey] = value;
+    m_pendingWrites.push_back(std::make_pair(fullKey, value));
 
-    settings.beginGroup(SETTINGS_GROUP_LAP);
-    const int time = settings.value(track.trackData().name(), -1).toInt();
-    settings.endGroup();
-
-    return time;
+    scheduleFlush();
 }
 
-void Settings::resetLapRecords()
+void Settings::removeGroup(QString group)
 {
-    QSettings settings;
+    const QString prefix = group + "/";
+    auto iter = m_values.lower_bound(prefix);
+    while (iter != m_values.end() && iter->first.startsWith(prefix))
+    {
+        iter = m_values.erase(iter);
+    }
+
+    m_pendingWrites.push_back(std::make_pair(group, QVariant()));
 
-    settings.beginGroup(SETTINGS_GROUP_LAP);
-    settings.remove("");
-    settings.endGroup();
+    scheduleFlush();
 }
 
-void Settings::saveRaceRecord(const Track & track, int msecs, int lapCount, DifficultyProfile::Difficulty difficulty)
+void Settings::scheduleFlush()
 {
-    QSettings settings;
-    const QString trackNameAndLapCount = combine(track, lapCount, difficulty);
-
-    settings.beginGroup(SETTINGS_GROUP_RACE);
-    settings.setValue(trackNameAndLapCount, msecs);
-    settings.endGroup();
+    m_flushTimer.start();
 }
 
-int Settings::loadRaceRecord(const Track & track, int lapCount, DifficultyProfile::Difficulty difficulty) const
+void Settings::flush()
 {
-    QSettings settings;
-    const QString trackNameAndLapCount = combine(track, lapCount, difficulty);
+    m_flushTimer.stop();
 
-    settings.beginGroup(SETTINGS_GROUP_RACE);
-    const int time = settings.value(trackNameAndLapCount, -1).toInt();
-    settings.endGroup();
+    if (!m_pendingWrites.empty())
+    {
+        m_threadPool.start(new FlushTask(std::move(m_pendingWrites)));
+        m_pendingWrites.clear();
+    }
+}
 
-    return time;
+void Settings::saveLapRecord(const TrackData & trackData, int msecs)
+{
+    setValue(SETTINGS_GROUP_LAP, trackData.name(), msecs);
 }
 
-void Settings::resetRaceRecords()
+int Settings::loadLapRecord(const TrackData & trackData) const
 {
-    QSettings settings;
+    return value(SETTINGS_GROUP_LAP, trackData.name(), -1).toInt();
+}
 
-    settings.beginGroup(SETTINGS_GROUP_RACE);
-    settings.remove("");
-    settings.endGroup();
+void Settings::resetLapRecords()
+{
+    removeGroup(SETTINGS_GROUP_LAP);
 }
 
-void Settings::saveBestPos(const Track & track, int pos, int lapCount, DifficultyProfile::Difficulty difficulty)
+void Settings::saveRaceRecord(const TrackData & trackData, int msecs, int lapCount, DifficultyProfile::Difficulty difficulty)
 {
-    QSettings settings;
-    const QString trackNameAndLapCount = combine(track, lapCount, difficulty);
+    setValue(SETTINGS_GROUP_RACE, combine(trackData, lapCount, difficulty), msecs);
+}
 
-    settings.beginGroup(SETTINGS_GROUP_POS);
-    settings.setValue(trackNameAndLapCount, pos);
-    settings.endGroup();
+int Settings::loadRaceRecord(const TrackData & trackData, int lapCount, DifficultyProfile::Difficulty difficulty) const
+{
+    return value(SETTINGS_GROUP_RACE, combine(trackData, lapCount, difficulty), -1).toInt();
 }
 
-int Settings::loadBestPos(const Track & track, int lapCount, DifficultyProfile::Difficulty difficulty) const
+void Settings::resetRaceRecords()
 {
-    QSettings settings;
-    const QString trackNameAndLapCount = combine(track, lapCount, difficulty);
+    removeGroup(SETTINGS_GROUP_RACE);
+}
 
-    settings.beginGroup(SETTINGS_GROUP_POS);
-    const int pos = settings.value(trackNameAndLapCount, -1).toInt();
-    settings.endGroup();
+void Settings::saveBestPos(const TrackData & trackData, int pos, int lapCount, DifficultyProfile::Difficulty difficulty)
+{
+    setValue(SETTINGS_GROUP_POS, combine(trackData, lapCount, difficulty), pos);
+}
 
-    return pos;
+int Settings::loadBestPos(const TrackData & trackData, int lapCount, DifficultyProfile::Difficulty difficulty) const
+{
+    return value(SETTINGS_GROUP_POS, combine(trackData, lapCount, difficulty), -1).toInt();
 }
 
 void Settings::resetBestPos()
 {
-    QSettings settings;
-
-    settings.beginGroup(SETTINGS_GROUP_POS);
-    settings.remove("");
-    settings.endGroup();
+    removeGroup(SETTINGS_GROUP_POS);
 }
 
-void Settings::saveTrackUnlockStatus(const Track & track, int lapCount, DifficultyProfile::Difficulty difficulty)
+void Settings::saveTrackUnlockStatus(const TrackData & trackData, int lapCount, DifficultyProfile::Difficulty difficulty)
 {
-    QSettings settings;
-    const QString trackNameAndLapCount = combineBase64(track, lapCount, difficulty);
-
-    settings.beginGroup(SETTINGS_GROUP_UNLOCK);
-    settings.setValue(trackNameAndLapCount, !track.trackData().isLocked());
-    settings.endGroup();
+    setValue(SETTINGS_GROUP_UNLOCK, combineBase64(trackData, lapCount, difficulty), !trackData.isLocked());
 }
 
-bool Settings::loadTrackUnlockStatus(const Track & track, int lapCount, DifficultyProfile::Difficulty difficulty) const
+bool Settings::loadTrackUnlockStatus(const TrackData & trackData, int lapCount, DifficultyProfile::Difficulty difficulty) const
 {
-    QSettings settings;
-    const QString trackNameAndLapCount = combineBase64(track, lapCount, difficulty);
-
-    settings.beginGroup(SETTINGS_GROUP_UNLOCK);
-    const bool status = settings.value(trackNameAndLapCount, 0).toBool();
-    settings.endGroup();
-
-    return status;
+    return value(SETTINGS_GROUP_UNLOCK, combineBase64(trackData, lapCount, difficulty), 0).toBool();
 }
 
 void Settings::resetTrackUnlockStatuses()
 {
-    QSettings settings;
-
-    settings.beginGroup(SETTINGS_GROUP_UNLOCK);
-    settings.remove("");
-    settings.endGroup();
+    removeGroup(SETTINGS_GROUP_UNLOCK);
 }
 
 void Settings::saveResolution(int hRes, int vRes, bool fullScreen)
 {
-    QSettings settings;
-
-    settings.beginGroup(SETTINGS_GROUP_CONFIG);
-    settings.setValue("hRes", hRes);
-    settings.setValue("vRes", vRes);
-    settings.setValue("fullScreen", fullScreen);
-    settings.endGroup();
+    setValue(SETTINGS_GROUP_CONFIG, "hRes", hRes);
+    setValue(SETTINGS_GROUP_CONFIG, "vRes", vRes);
+    setValue(SETTINGS_GROUP_CONFIG, "fullScreen", fullScreen);
 }
 
 void Settings::loadResolution(int & hRes, int & vRes, bool & fullScreen)
 {
-    QSettings settings;
-
-    settings.beginGroup(SETTINGS_GROUP_CONFIG);
-    fullScreen = settings.value("fullScreen", true).toBool();
-    hRes       = settings.value("hRes", 0).toInt();
-    vRes       = settings.value("vRes", 0).toInt();
-    settings.endGroup();
+    fullScreen = value(SETTINGS_GROUP_CONFIG, "fullScreen", true).toBool();
+    hRes       = value(SETTINGS_GROUP_CONFIG, "hRes", 0).toInt();
+    vRes       = value(SETTINGS_GROUP_CONFIG, "vRes", 0).toInt();
 }
 
 void Settings::saveVSync(int value)
@@ -235,23 +272,12 @@ int Settings::loadVSync()
 
 void Settings::saveValue(QString key, int value)
 {
-    QSettings settings;
-
-    settings.beginGroup(SETTINGS_GROUP_CONFIG);
-    settings.setValue(key, value);
-    settings.endGroup();
+    setValue(SETTINGS_GROUP_CONFIG, key, value);
 }
 
 int Settings::loadValue(QString key, int defaultValue)
 {
-    QSettings settings;
-
-    int value = 0;
-    settings.beginGroup(SETTINGS_GROUP_CONFIG);
-    value = settings.value(key, defaultValue).toInt();
-    settings.endGroup();
-
-    return value;
+    return value(SETTINGS_GROUP_CONFIG, key, defaultValue).toInt();
 }
 
 QString Settings::combineActionAndPlayer(int player, InputHandler::Action action)
@@ -261,42 +287,20 @@ QString Settings::combineActionAndPlayer(int player, InputHandler::Action action
 
 void Settings::saveKeyMapping(int player, InputHandler::Action action, int key)
 {
-    QSettings settings;
-
-    settings.beginGroup(SETTINGS_GROUP_CONFIG);
-    settings.setValue(combineActionAndPlayer(player, action), key);
-    settings.endGroup();
+    setValue(SETTINGS_GROUP_CONFIG, combineActionAndPlayer(player, action), key);
 }
 
 int Settings::loadKeyMapping(int player, InputHandler::Action action)
 {
-    QSettings settings;
-
-    int key = 0;
-    settings.beginGroup(SETTINGS_GROUP_CONFIG);
-    key = settings.value(combineActionAndPlayer(player, action), 0).toInt();
-    settings.endGroup();
-
-    return key;
+    return value(SETTINGS_GROUP_CONFIG, combineActionAndPlayer(player, action), 0).toInt();
 }
 
 void Settings::saveDifficulty(DifficultyProfile::Difficulty difficulty)
 {
-    QSettings settings;
-
-    settings.beginGroup(SETTINGS_GROUP_CONFIG);
-    settings.setValue(difficultyKey(), static_cast<int>(difficulty));
-    settings.endGroup();
+    setValue(SETTINGS_GROUP_CONFIG, difficultyKey(), static_cast<int>(difficulty));
 }
 
 DifficultyProfile::Difficulty Settings::loadDifficulty() const
 {
-    QSettings settings;
-
-    DifficultyProfile::Difficulty difficulty = DifficultyProfile::Difficulty::Medium;
-    settings.beginGroup(SETTINGS_GROUP_CONFIG);
-    difficulty = static_cast<DifficultyProfile::Difficulty>(settings.value(difficultyKey(), 0).toInt());
-    settings.endGroup();
-
-    return difficulty;
+    return static_cast<DifficultyProfile::Difficulty>(value(SETTINGS_GROUP_CONFIG, difficultyKey(), 0).toInt());
 }
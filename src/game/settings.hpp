@@ -20,11 +20,20 @@
 #include "inputhandler.hpp"
 
 #include <map>
+#include <utility>
+#include <vector>
+
 #include <QString>
+#include <QThreadPool>
+#include <QTimer>
+#include <QVariant>
 
-class Track;
+class TrackData;
 
-//! Singleton settings class that wraps the use of QSettings.
+/*! Singleton settings class that wraps the use of QSettings.
+ *  All values are read into memory once on construction and served from there.
+ *  Changes are collected and written to the persistent store in batches on a
+ *  worker thread shortly after the latest change and on destruction. */
 class Settings
 {
 public:
@@ -32,22 +41,25 @@ public:
     //! Constructor.
     Settings();
 
+    //! Destructor. Writes pending changes.
+    ~Settings();
+
     static Settings & instance();
 
-    void saveLapRecord(const Track & track, int msecs);
-    int loadLapRecord(const Track & track) const;
+    void saveLapRecord(const TrackData & trackData, int msecs);
+    int loadLapRecord(const TrackData & trackData) const;
     void resetLapRecords();
 
-    void saveRaceRecord(const Track & track, int msecs, int lapCount, DifficultyProfile::Difficulty difficulty);
-    int loadRaceRecord(const Track & track, int lapCount, DifficultyProfile::Difficulty difficulty) const;
+    void saveRaceRecord(const TrackData & trackData, int msecs, int lapCount, DifficultyProfile::Difficulty difficulty);
+    int loadRaceRecord(const TrackData & trackData, int lapCount, DifficultyProfile::Difficulty difficulty) const;
     void resetRaceRecords();
 
-    void saveBestPos(const Track & track, int pos, int lapCount, DifficultyProfile::Difficulty difficulty);
-    int loadBestPos(const Track & track, int lapCount, DifficultyProfile::Difficulty difficulty) const;
+    void saveBestPos(const TrackData & trackData, int pos, int lapCount, DifficultyProfile::Difficulty difficulty);
+    int loadBestPos(const TrackData & trackData, int lapCount, DifficultyProfile::Difficulty difficulty) const;
     void resetBestPos();
 
-    void saveTrackUnlockStatus(const Track & track, int lapCount, DifficultyProfile::Difficulty difficulty);
-    bool loadTrackUnlockStatus(const Track & track, int lapCount, DifficultyProfile::Difficulty difficulty) const;
+    void saveTrackUnlockStatus(const TrackData & trackData, int lapCount, DifficultyProfile::Difficulty difficulty);
+    bool loadTrackUnlockStatus(const TrackData & trackData, int lapCount, DifficultyProfile::Difficulty difficulty) const;
     void resetTrackUnlockStatuses();
 
     void saveResolution(int hRes, int vRes, bool fullScreen);
@@ -71,12 +83,28 @@ public:
     static QString soundsKey();
     static QString vsyncKey();
 
+    //! Start writing pending changes to the persistent store.
+    void flush();
+
 private:
 
     QString combineActionAndPlayer(int player, InputHandler::Action action);
 
+    QVariant value(QString group, QString key, QVariant defaultValue) const;
+
+    void setValue(QString group, QString key, QVariant value);
+
+    void removeGroup(QString group);
+
+    void scheduleFlush();
+
     static Settings * m_instance;
     std::map<InputHandler::Action, QString> m_actionToStringMap;
+    std::map<QString, QVariant> m_values;
+    //! Pending changes in order. An invalid value removes the key.
+    std::vector<std::pair<QString, QVariant>> m_pendingWrites;
+    QTimer m_flushTimer;
+    QThreadPool m_threadPool;
 };
 
 #endif // SETTINGS_HPP
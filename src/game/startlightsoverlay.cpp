@@ -28,21 +28,19 @@ StartlightsOverlay::StartlightsOverlay(Startlights & model)
 , m_startLightGlow(MCAssetManager::surfaceManager().surface("startLightGlow"))
 , m_model(model)
 , m_alpha(1.0)
+, m_cachedLitRows(-1)
 {
     m_startLightOff.material()->setAlphaBlend(true);
     m_startLightOffCorner.material()->setAlphaBlend(true);
     m_startLightGlow.setColor(MCGLColor(1.5f, 0.25f, 0.25f, 0.4f));
 }
 
-void StartlightsOverlay::renderLights(int rows, int litRows, float glowScale, bool glowAlways) const
+void StartlightsOverlay::renderBody(int rows, int litRows, float x, float y) const
 {
     const int cols = 8;
 
-    const float x = m_model.pos().i() - (cols - 1) * m_startLightOn.width()  / 2;
-    const float y = m_model.pos().j() - (rows - 1) * m_startLightOn.height() / 2;
     const float h = rows * m_startLightOn.height();
 
-    // Body
     for (int row = 0; row < rows; row++)
     {
         for (int col = 0; col < cols; col++)
@@ -99,6 +97,27 @@ void StartlightsOverlay::renderLights(int rows, int litRows, float glowScale, bo
             }
         }
     }
+}
+
+void StartlightsOverlay::renderLights(int rows, int litRows, float glowScale, bool glowAlways)
+{
+    const int cols = 8;
+
+    const float x = m_model.pos().i() - (cols - 1) * m_startLightOn.width()  / 2;
+    const float y = m_model.pos().j() - (rows - 1) * m_startLightOn.height() / 2;
+    const float h = rows * m_startLightOn.height();
+
+    // Body. It changes only when a row lights up, so it's cached and faded out as a whole.
+    if (litRows != m_cachedLitRows)
+    {
+        invalidateCache();
+        m_cachedLitRows = litRows;
+    }
+
+    const float bodyY = y + h - (rows - 1) * m_startLightOn.height() / 2;
+    renderCached(m_model.pos().i(), bodyY, cols * m_startLightOn.width(), h, [=] () {
+        renderBody(rows, litRows, x, y);
+    }, MCGLColor(1.0, 1.0, 1.0, m_alpha));
 
     // Glow
     for (int row = 0; row < rows; row++)
@@ -146,15 +165,12 @@ void StartlightsOverlay::render()
 
     case Startlights::Go:
         m_alpha *= 0.98;
-        m_startLightOff.setColor(MCGLColor(1.0, 1.0, 1.0, m_alpha));
-        m_startLightOffCorner.setColor(MCGLColor(1.0, 1.0, 1.0, m_alpha));
         renderLights(3, 0, m_model.glowScale(), true);
         break;
 
     case Startlights::Disappear:
     case Startlights::Appear:
-        m_startLightOff.setColor(MCGLColor(1.0, 1.0, 1.0, 1.0));
-        m_startLightOffCorner.setColor(MCGLColor(1.0, 1.0, 1.0, 1.0));
+        m_alpha = 1.0;
         renderLights(3, 0, m_model.glowScale());
         break;
 
@@ -40,7 +40,9 @@ public:
 
 private:
 
-    void renderLights(int rows, int litRows, float glowScale, bool glowAlways = false) const;
+    void renderLights(int rows, int litRows, float glowScale, bool glowAlways = false);
+
+    void renderBody(int rows, int litRows, float x, float y) const;
 
     MCSurface   & m_startLightOn;
     MCSurface   & m_startLightOnCorner;
@@ -49,6 +51,7 @@ private:
     MCSurface   & m_startLightGlow;
     Startlights & m_model;
     float         m_alpha;
+    int           m_cachedLitRows;
 };
 
 #endif // STARTLIGHTSOVERLAY_HPP
@@ -0,0 +1,122 @@
+// This file is part of Dust Racing 2D.
+// Copyright (C) 2018 Jussi Lind <jussi.lind@iki.fi>
+//
+// Dust Racing 2D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// Dust Racing 2D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Dust Racing 2D. If not, see <http://www.gnu.org/licenses/>.
+
+#include "surfacebatch.hpp"
+
+#include <MCMathUtil>
+#include <MCSurface>
+
+static const int NUM_VERTICES_PER_QUAD = 6;
+
+SurfaceBatch::SurfaceBatch(MCSurface & surface, int maxQuads, GLuint drawType)
+    : MCGLObjectBase("SurfaceBatch")
+    , m_surface(surface)
+    , m_maxQuads(maxQuads)
+    , m_batchVertices(maxQuads * NUM_VERTICES_PER_QUAD)
+    , m_batchNormals(maxQuads * NUM_VERTICES_PER_QUAD, MCGLVertex(0, 0, 1))
+    , m_batchTexCoords(maxQuads * NUM_VERTICES_PER_QUAD)
+    , m_batchColors(maxQuads * NUM_VERTICES_PER_QUAD)
+{
+    setMaterial(surface.material());
+
+    const int numVertices = maxQuads * NUM_VERTICES_PER_QUAD;
+
+    initBufferData(
+        (sizeof(MCGLVertex) * 2 + sizeof(MCGLTexCoord) + sizeof(MCGLColor)) * numVertices, drawType);
+
+    addBufferSubData(MCGLShaderProgram::VAL_Vertex, sizeof(MCGLVertex) * numVertices,
+        reinterpret_cast<const GLfloat *>(m_batchVertices.data()));
+    addBufferSubData(MCGLShaderProgram::VAL_Normal, sizeof(MCGLVertex) * numVertices,
+        reinterpret_cast<const GLfloat *>(m_batchNormals.data()));
+    addBufferSubData(MCGLShaderProgram::VAL_TexCoords, sizeof(MCGLTexCoord) * numVertices,
+        reinterpret_cast<const GLfloat *>(m_batchTexCoords.data()));
+    addBufferSubData(MCGLShaderProgram::VAL_Color, sizeof(MCGLColor) * numVertices,
+        reinterpret_cast<const GLfloat *>(m_batchColors.data()));
+
+    finishBufferData();
+}
+
+void SurfaceBatch::clear()
+{
+    m_quadCount = 0;
+}
+
+bool SurfaceBatch::add(const MCVector3dF & location, float width, float height, float angle, const MCGLColor & color)
+{
+    if (m_quadCount >= m_maxQuads)
+    {
+        return false;
+    }
+
+    const float scaleX = width / m_surface.width();
+    const float scaleY = height / m_surface.height();
+
+    int vertexIndex = m_quadCount * NUM_VERTICES_PER_QUAD;
+    for (int i = 0; i < NUM_VERTICES_PER_QUAD; i++)
+    {
+        const MCGLVertex & vertex = m_surface.vertex(i);
+        const float x = vertex.x() * scaleX;
+        const float y = vertex.y() * scaleY;
+
+        m_batchVertices[vertexIndex] = MCGLVertex(
+            location.i() + MCMathUtil::rotatedX(x, y, angle),
+            location.j() + MCMathUtil::rotatedY(x, y, angle),
+            location.k() + vertex.z());
+
+        m_batchTexCoords[vertexIndex] = m_surface.texCoord(i);
+
+        m_batchColors[vertexIndex] = color;
+
+        vertexIndex++;
+    }
+
+    m_quadCount++;
+
+    return true;
+}
+
+void SurfaceBatch::update()
+{
+    const int numVertices = m_maxQuads * NUM_VERTICES_PER_QUAD;
+
+    initUpdateBufferData();
+
+    addBufferSubData(MCGLShaderProgram::VAL_Vertex, sizeof(MCGLVertex) * numVertices,
+        reinterpret_cast<const GLfloat *>(m_batchVertices.data()));
+    addBufferSubData(MCGLShaderProgram::VAL_Normal, sizeof(MCGLVertex) * numVertices,
+        reinterpret_cast<const GLfloat *>(m_batchNormals.data()));
+    addBufferSubData(MCGLShaderProgram::VAL_TexCoords, sizeof(MCGLTexCoord) * numVertices,
+        reinterpret_cast<const GLfloat *>(m_batchTexCoords.data()));
+    addBufferSubData(MCGLShaderProgram::VAL_Color, sizeof(MCGLColor) * numVertices,
+        reinterpret_cast<const GLfloat *>(m_batchColors.data()));
+
+    releaseVBO();
+    releaseVAO();
+}
+
+void SurfaceBatch::draw()
+{
+    MCGLObjectBase::render(nullptr, MCVector3dF(), 0);
+}
+
+int SurfaceBatch::quadCount() const
+{
+    return m_quadCount;
+}
+
+void SurfaceBatch::render()
+{
+    drawArrays(GL_TRIANGLES, m_quadCount * NUM_VERTICES_PER_QUAD);
+}
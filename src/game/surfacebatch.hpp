@@ -0,0 +1,80 @@
+// This file is part of Dust Racing 2D.
+// Copyright (C) 2018 Jussi Lind <jussi.lind@iki.fi>
+//
+// Dust Racing 2D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// Dust Racing 2D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Dust Racing 2D. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef SURFACEBATCH_HPP
+#define SURFACEBATCH_HPP
+
+#include <MCGLColor>
+#include <MCGLObjectBase>
+#include <MCGLVertex>
+#include <MCVector3d>
+
+#include "quadbatch.hpp"
+
+#include <vector>
+
+class MCSurface;
+
+/*! A vertex buffer of quads that share the texture of a single surface.
+ *  Quads are baked into the buffer with their final positions, sizes,
+ *  rotations and colors so that the whole batch is drawn with one call. */
+class SurfaceBatch : public MCGLObjectBase, public QuadBatch
+{
+public:
+
+    /*! Constructor.
+     *  \param surface Surface the texture and texture coordinates are taken from.
+     *  \param maxQuads Maximum number of quads in the batch.
+     *  \param drawType GL_STATIC_DRAW for batches that are built once,
+     *                  GL_DYNAMIC_DRAW for batches that are rebuilt every frame. */
+    SurfaceBatch(MCSurface & surface, int maxQuads, GLuint drawType = GL_STATIC_DRAW);
+
+    //! \reimp
+    virtual void clear() override;
+
+    //! \reimp
+    virtual bool add(const MCVector3dF & location, float width, float height, float angle, const MCGLColor & color) override;
+
+    //! Upload the quads to the vertex buffer.
+    virtual void update() override;
+
+    //! Draw the quads with the shader program of the batch.
+    virtual void draw() override;
+
+    int quadCount() const;
+
+    //! \reimp
+    virtual void render() override;
+
+    using MCGLObjectBase::render;
+
+private:
+
+    MCSurface & m_surface;
+
+    int m_maxQuads;
+
+    int m_quadCount = 0;
+
+    std::vector<MCGLVertex> m_batchVertices;
+
+    std::vector<MCGLVertex> m_batchNormals;
+
+    std::vector<MCGLTexCoord> m_batchTexCoords;
+
+    std::vector<MCGLColor> m_batchColors;
+};
+
+#endif // SURFACEBATCH_HPP
@@ -16,10 +16,19 @@
 #include "timing.hpp"
 #include "car.hpp"
 
-#include <QString>
-
 #include <cassert>
 
+namespace {
+
+//! Append the given number (0..99) as two digits.
+void appendTwoDigits(std::wstring & text, int number)
+{
+    text += static_cast<wchar_t>(L'0' + number / 10);
+    text += static_cast<wchar_t>(L'0' + number % 10);
+}
+
+} // namespace
+
 Timing::Timing(unsigned int cars, QObject *parent)
 : QObject(parent)
 , m_times(cars, Timing::Times())
@@ -35,8 +44,8 @@ void Timing::setLapCompleted(unsigned int index, bool isHuman)
     Timing::Times & times = m_times.at(index);
     times.lap++;
 
-    const int elapsed = m_time;
-    times.lastLapTime = elapsed - times.raceTime;
+    const qint64 elapsed = m_time;
+    times.lastLapTime = usecsToMsecs(elapsed - times.raceTime);
     times.raceTime    = elapsed;
 
     // Check if a new personal record achieved.
@@ -69,9 +78,10 @@ void Timing::setRaceCompleted(unsigned int index, bool state, bool isHuman)
 
     if (isHuman)
     {
-        if (times.raceTime < m_raceRecord || m_raceRecord == -1)
+        const int raceTime = usecsToMsecs(times.raceTime);
+        if (raceTime < m_raceRecord || m_raceRecord == -1)
         {
-            m_raceRecord = times.raceTime;
+            m_raceRecord = raceTime;
 
             emit raceRecordAchieved(m_raceRecord);
         }
@@ -125,7 +135,7 @@ int Timing::currentLapTime(unsigned int index) const
     }
 
     const Timing::Times & times = m_times.at(index);
-    return m_time - times.raceTime;
+    return usecsToMsecs(m_time - times.raceTime);
 }
 
 int Timing::recordLapTime(unsigned int index) const
@@ -145,7 +155,7 @@ int Timing::raceTime() const
         return 0;
     }
 
-    return m_time;
+    return usecsToMsecs(m_time);
 }
 
 int Timing::raceTime(unsigned int index) const
@@ -156,7 +166,7 @@ int Timing::raceTime(unsigned int index) const
     }
     else
     {
-        return m_times.at(index).raceTime;
+        return usecsToMsecs(m_times.at(index).raceTime);
     }
 }
 
@@ -222,19 +232,32 @@ void Timing::reset()
     }
 }
 
-void Timing::tick()
+void Timing::tick(int stepUsecs)
 {
     if (m_started)
     {
-        m_time += 1000 / 60;
+        m_time += stepUsecs;
     }
 }
 
+int Timing::usecsToMsecs(qint64 usecs)
+{
+    return static_cast<int>((usecs + 500) / 1000);
+}
+
 std::wstring Timing::msecsToString(int msec)
+{
+    std::wstring text;
+    appendMsecs(text, msec);
+    return text;
+}
+
+void Timing::appendMsecs(std::wstring & text, int msec)
 {
     if (msec < 0)
     {
-        return L"--:--.--";
+        text += L"--:--.--";
+        return;
     }
 
     const int hr = msec % 3600000;
@@ -243,6 +266,10 @@ std::wstring Timing::msecsToString(int msec)
     const int ss = mr   / 1000;
     const int ms = mr   % 1000;
 
-    return QString().sprintf("%02d:%02d.%02d", mm, ss, ms / 10).toStdWString();
+    appendTwoDigits(text, mm);
+    text += L':';
+    appendTwoDigits(text, ss);
+    text += L'.';
+    appendTwoDigits(text, ms / 10);
 }
 
@@ -17,6 +17,7 @@
 #define TIMING_HPP
 
 #include <QObject>
+#include <QtGlobal>
 #include <string>
 #include <vector>
 
@@ -96,12 +97,19 @@ public:
     //! Resets the timing.
     void reset();
 
-    //! Increase timer assuming 60 Hz update rate
-    void tick();
+    /*! Advance the race time by one simulation step. The time is accumulated
+     *  in microseconds so that steps that aren't whole milliseconds don't
+     *  drift and lap times don't depend on the render rate.
+     *  \param stepUsecs Length of the simulation step in usecs. */
+    void tick(int stepUsecs);
 
     //! Converts msecs to string "mm:ss.zz".
     static std::wstring msecsToString(int msec);
 
+    //! Appends msecs to text in the format of msecsToString(). Doesn't allocate
+    //! if text has the capacity, so it can be used when rendering.
+    static void appendMsecs(std::wstring & text, int msec);
+
 signals:
 
     void lapCompleted(unsigned int index, int msec);
@@ -112,6 +120,9 @@ signals:
 
 private:
 
+    //! Round usecs to msecs.
+    static int usecsToMsecs(qint64 usecs);
+
     //! Timing structure.
     class Times
     {
@@ -130,7 +141,7 @@ private:
 
         int recordLapTime; // Personal best
 
-        int raceTime;
+        qint64 raceTime; // Usecs
 
         int recordRaceTime; // Personal best
 
@@ -143,7 +154,7 @@ private:
 
     std::vector<Timing::Times> m_times;
 
-    int m_time;
+    qint64 m_time; // Usecs
 
     bool m_started;
 
@@ -25,7 +25,6 @@
 #include <MCAssetManager>
 
 #include <cassert>
-#include <sstream>
 
 #include <QObject> // For QObject::tr()
 #include <QTimer>
@@ -44,10 +43,34 @@ static const MCGLColor GREEN  (0.0, 1.0, 0.0);
 static const MCGLColor YELLOW (1.0, 1.0, 0.0);
 static const MCGLColor WHITE  (1.0, 1.0, 1.0);
 
+static const int TIME_RESOLUTION = 10; // Times are shown in centisecs
+
+//! Append the given non-negative number without creating temporary strings.
+static void appendNumber(std::wstring & text, int number, int minDigits = 1)
+{
+    wchar_t digits[16];
+    int count = 0;
+    do
+    {
+        digits[count++] = static_cast<wchar_t>(L'0' + number % 10);
+        number /= 10;
+    } while ((number > 0 || count < minDigits) && count < 16);
+
+    while (count > 0)
+    {
+        text += digits[--count];
+    }
+}
+
+//! \return key that changes when the shown time changes.
+static int timeKey(int msec)
+{
+    return msec < 0 ? -1 : msec / TIME_RESOLUTION;
+}
+
 TimingOverlay::TimingOverlay()
 : m_fontManager(MCAssetManager::textureFontManager())
 , m_font(m_fontManager.font(Game::instance().fontName()))
-, m_text(L"")
 , m_car(nullptr)
 , m_timing(nullptr)
 , m_race(nullptr)
@@ -65,18 +88,75 @@ TimingOverlay::TimingOverlay()
     QObject::tr("10th").toStdWString(),
     QObject::tr("11th").toStdWString(),
     QObject::tr("12th").toStdWString()})
+, m_currentLapLabel(QObject::tr(" LAP:").toStdWString())
+, m_posLabel(QObject::tr(" POS:").toStdWString())
+, m_lapLabel(QObject::tr("LAP").toStdWString())
+, m_lapsLabel(QObject::tr("LAPS").toStdWString())
+, m_lapTimeLabel(QObject::tr("LAP:").toStdWString())
+, m_lastLapTimeLabel(QObject::tr("L:").toStdWString())
+, m_recordLapTimeLabel(QObject::tr("R:").toStdWString())
+, m_raceTimeLabel(QObject::tr("TOT:").toStdWString())
+, m_speedUnitText(QObject::tr(" KM/H").toStdWString())
 , m_showLapRecordTime(true)
 , m_showRaceTime(true)
 , m_showCarStatus(true)
+, m_bufferCapacity(0)
+, m_allocationCount(0)
 {
     assert(Scene::NUM_CARS <= static_cast<int>(m_posTexts.size()) - 1);
-    m_text.setShadowOffset(2, -2);
+
+    // Reserve enough for the longest texts so that formatting doesn't allocate.
+    m_buffer.reserve(64);
+    m_bufferCapacity = m_buffer.capacity();
+
+    for (auto text : {
+        &m_currentLapText, &m_positionText, &m_speedText, &m_currentLapTimeText,
+        &m_lastLapTimeText, &m_recordLapTimeText, &m_raceTimeText})
+    {
+        text->text.setShadowOffset(2, -2);
+    }
+
+    m_currentLapText.text.setGlyphSize(GLYPH_W_POS, GLYPH_H_POS);
+    m_currentLapText.text.setColor(WHITE);
+
+    m_positionText.text.setGlyphSize(GLYPH_W_POS, GLYPH_H_POS);
+    m_positionText.text.setColor(YELLOW);
+
+    m_speedText.text.setGlyphSize(40, 40);
+
+    m_speedUnitText.setShadowOffset(2, -2);
+    m_speedUnitText.setGlyphSize(20, 20);
+    m_speedUnitText.setColor(WHITE);
+
+    m_currentLapTimeText.text.setGlyphSize(GLYPH_W_TIMES, GLYPH_H_TIMES);
+
+    m_lastLapTimeText.text.setGlyphSize(GLYPH_W_TIMES, GLYPH_H_TIMES);
+    m_lastLapTimeText.text.setColor(WHITE);
+
+    m_recordLapTimeText.text.setGlyphSize(GLYPH_W_TIMES, GLYPH_H_TIMES);
+    m_recordLapTimeText.text.setColor(WHITE);
+
+    m_raceTimeText.text.setGlyphSize(GLYPH_W_TIMES, GLYPH_H_TIMES);
+    m_raceTimeText.text.setColor(WHITE);
+}
+
+void TimingOverlay::invalidateTexts()
+{
+    m_currentLapText.valid     = false;
+    m_positionText.valid       = false;
+    m_speedText.valid          = false;
+    m_currentLapTimeText.valid = false;
+    m_lastLapTimeText.valid    = false;
+    m_recordLapTimeText.valid  = false;
+    m_raceTimeText.valid       = false;
 }
 
 void TimingOverlay::setCarToFollow(const Car & car)
 {
     m_car = &car;
     m_carStatusView.setCarToFollow(car);
+
+    invalidateTexts();
 }
 
 void TimingOverlay::setRace(Race & race)
@@ -84,6 +164,8 @@ void TimingOverlay::setRace(Race & race)
     m_race   = &race;
     m_timing = &m_race->timing();
 
+    invalidateTexts();
+
     connect(m_timing, SIGNAL(lapRecordAchieved(int)), this, SLOT(setLapRecord(int)));
     connect(m_timing, SIGNAL(raceRecordAchieved(int)), this, SLOT(setRaceRecord(int)));
     connect(m_race, SIGNAL(tiresChanged(const Car &)), this, SLOT(blinkCarStatus(const Car &)));
@@ -157,6 +239,8 @@ void TimingOverlay::blinkCarStatus(const Car & car)
 
 void TimingOverlay::render()
 {
+    m_allocationCount = 0;
+
     if (m_car && m_timing && m_race)
     {
         renderCurrentLap();
@@ -177,20 +261,48 @@ void TimingOverlay::render()
     }
 }
 
+void TimingOverlay::setText(MCTextureText & text)
+{
+    // Formatting appends to m_buffer and setText() copies it, so both allocate only if they have to grow.
+    const size_t textCapacity = text.text().capacity();
+    text.setText(m_buffer);
+
+    if (m_buffer.capacity() != m_bufferCapacity)
+    {
+        m_bufferCapacity = m_buffer.capacity();
+        m_allocationCount++;
+    }
+
+    if (text.text().capacity() != textCapacity)
+    {
+        m_allocationCount++;
+    }
+}
+
+int TimingOverlay::allocationCount() const
+{
+    return m_allocationCount;
+}
+
 void TimingOverlay::renderCurrentLap()
 {
     const int leadersLap = m_timing->leadersLap() + 1;
     const int laps = m_race->lapCount();
-
-    m_text.setGlyphSize(GLYPH_W_POS, GLYPH_H_POS);
+    const int currentLap = leadersLap <= laps ? leadersLap : laps;
 
     // Render the current lap number
-    std::wstringstream ss;
-    ss << QObject::tr(" LAP:").toStdWString() << (leadersLap <= laps ? leadersLap : laps) << "/" << laps;
+    auto && text = m_currentLapText.text;
+    if (m_currentLapText.changed(currentLap * 1000 + laps))
+    {
+        m_buffer.clear();
+        m_buffer += m_currentLapLabel;
+        appendNumber(m_buffer, currentLap);
+        m_buffer += L'/';
+        appendNumber(m_buffer, laps);
+        setText(text);
+    }
 
-    m_text.setText(ss.str());
-    m_text.setColor(WHITE);
-    m_text.render(0, height() - m_text.height(m_font), nullptr, m_font);
+    text.render(0, height() - text.height(m_font), nullptr, m_font);
 }
 
 void TimingOverlay::renderPosition()
@@ -198,24 +310,26 @@ void TimingOverlay::renderPosition()
     const int pos = m_car->position();
     const int lap = m_timing->lap(m_car->index()) + 1;
     const int leadersLap = m_timing->leadersLap() + 1;
+    const int lapDiff = leadersLap - lap;
 
-    m_text.setGlyphSize(GLYPH_W_POS, GLYPH_H_POS);
+    auto && text = m_positionText.text;
+    if (m_positionText.changed(pos * 1000 + (lapDiff > 0 ? lapDiff : 0)))
+    {
+        m_buffer.clear();
+        m_buffer += m_posLabel;
+        m_buffer += m_posTexts.at(pos);
 
-    std::wstringstream ss;
-    ss << QObject::tr(" POS:").toStdWString();
-    ss << m_posTexts.at(pos);
+        if (lapDiff > 0)
+        {
+            m_buffer += L'+';
+            appendNumber(m_buffer, lapDiff);
+            m_buffer += lapDiff == 1 ? m_lapLabel : m_lapsLabel;
+        }
 
-    const int lapDiff = leadersLap - lap;
-    if (lapDiff > 0)
-    {
-        ss << "+"
-           << lapDiff
-           << (lapDiff == 1 ? QObject::tr("LAP").toStdWString() : QObject::tr("LAPS").toStdWString());
+        setText(text);
     }
 
-    m_text.setText(ss.str());
-    m_text.setColor(YELLOW);
-    m_text.render(0, height() - m_text.height(m_font) * 2, nullptr, m_font);
+    text.render(0, height() - text.height(m_font) * 2, nullptr, m_font);
 }
 
 void TimingOverlay::renderSpeed()
@@ -226,31 +340,32 @@ void TimingOverlay::renderSpeed()
         int speed = m_car->speedInKmh();
         speed = speed < 0 ? 0 : speed;
 
-        std::wstringstream ss;
-        ss << " " << speed;
-        if (speed < 100)
-        {
-            m_text.setColor(WHITE);
-        }
-        else if (speed < 200)
-        {
-            m_text.setColor(YELLOW);
-        }
-        else
+        auto && text = m_speedText.text;
+        if (m_speedText.changed(speed))
         {
-            m_text.setColor(RED);
+            m_buffer.clear();
+            m_buffer += L' ';
+            appendNumber(m_buffer, speed);
+            setText(text);
+
+            if (speed < 100)
+            {
+                text.setColor(WHITE);
+            }
+            else if (speed < 200)
+            {
+                text.setColor(YELLOW);
+            }
+            else
+            {
+                text.setColor(RED);
+            }
         }
 
-        m_text.setText(ss.str());
-        m_text.setGlyphSize(40, 40);
+        const int h = text.height(m_font);
+        text.render(0, h, nullptr, m_font);
 
-        const int h = m_text.height(m_font);
-        m_text.render(0, h, nullptr, m_font);
-
-        m_text.setText(QObject::tr(" KM/H").toStdWString());
-        m_text.setGlyphSize(20, 20);
-        m_text.setColor(WHITE);
-        m_text.render(0, 2 * m_text.height(m_font) + h, nullptr, m_font);
+        m_speedUnitText.render(0, 2 * m_speedUnitText.height(m_font) + h, nullptr, m_font);
     }
 }
 
@@ -258,41 +373,37 @@ void TimingOverlay::renderCurrentLapTime()
 {
     const int lastLapTime = m_timing->lastLapTime(m_car->index());
     const int currentLapTime = m_timing->currentLapTime(m_car->index());
+    const bool raceCompleted = m_timing->raceCompleted(m_car->index());
+    const int shownTime = raceCompleted ? lastLapTime : currentLapTime;
 
-    std::wstringstream ss;
-    ss << QObject::tr("LAP:").toStdWString();
-    if (m_timing->raceCompleted(m_car->index()))
+    auto && text = m_currentLapTimeText.text;
+    if (m_currentLapTimeText.changed(timeKey(shownTime)))
     {
-        ss << m_timing->msecsToString(lastLapTime);
+        m_buffer.clear();
+        m_buffer += m_lapTimeLabel;
+        Timing::appendMsecs(m_buffer, shownTime);
+        setText(text);
+    }
 
-        m_text.setColor(WHITE);
+    // Set color to WHITE, if lastLapTime is not set.
+    if (raceCompleted || lastLapTime == -1 || currentLapTime == lastLapTime)
+    {
+        text.setColor(WHITE);
+    }
+    // Set color to GREEN, if current time is ahead of the last lap time.
+    else if (currentLapTime < lastLapTime)
+    {
+        text.setColor(GREEN);
     }
+    // Set color to RED (current time is slower than the last lap time).
     else
     {
-        ss << m_timing->msecsToString(currentLapTime);
-
-        // Set color to WHITE, if lastLapTime is not set.
-        if (lastLapTime == -1 || currentLapTime == lastLapTime)
-        {
-            m_text.setColor(WHITE);
-        }
-        // Set color to GREEN, if current time is ahead of the last lap time.
-        else if (currentLapTime < lastLapTime)
-        {
-            m_text.setColor(GREEN);
-        }
-        // Set color to RED (current time is slower than the last lap time).
-        else
-        {
-            m_text.setColor(RED);
-        }
+        text.setColor(RED);
     }
 
-    m_text.setText(ss.str());
-    m_text.setGlyphSize(GLYPH_W_TIMES, GLYPH_H_TIMES);
-    m_text.render(
-        width() - m_text.width(m_font),
-        height() - m_text.height(m_font) * CURRENT_LAP_TIME_POS,
+    text.render(
+        width() - text.width(m_font),
+        height() - text.height(m_font) * CURRENT_LAP_TIME_POS,
         nullptr,
         m_font);
 }
@@ -301,15 +412,18 @@ void TimingOverlay::renderLastLapTime()
 {
     const int lastLapTime = m_timing->lastLapTime(m_car->index());
 
-    m_text.setGlyphSize(GLYPH_W_TIMES, GLYPH_H_TIMES);
-    m_text.setColor(WHITE);
+    auto && text = m_lastLapTimeText.text;
+    if (m_lastLapTimeText.changed(timeKey(lastLapTime)))
+    {
+        m_buffer.clear();
+        m_buffer += m_lastLapTimeLabel;
+        Timing::appendMsecs(m_buffer, lastLapTime);
+        setText(text);
+    }
 
-    std::wstringstream ss;
-    ss << QObject::tr("L:").toStdWString() << m_timing->msecsToString(lastLapTime);
-    m_text.setText(ss.str());
-    m_text.render(
-        width() - m_text.width(m_font),
-        height() - m_text.height(m_font) * LAST_LAP_TIME_POS,
+    text.render(
+        width() - text.width(m_font),
+        height() - text.height(m_font) * LAST_LAP_TIME_POS,
         nullptr,
         m_font);
 }
@@ -320,15 +434,18 @@ void TimingOverlay::renderRecordLapTime()
     {
         const int recordLapTime = m_timing->lapRecord();
 
-        m_text.setGlyphSize(GLYPH_W_TIMES, GLYPH_H_TIMES);
-        m_text.setColor(WHITE);
+        auto && text = m_recordLapTimeText.text;
+        if (m_recordLapTimeText.changed(timeKey(recordLapTime)))
+        {
+            m_buffer.clear();
+            m_buffer += m_recordLapTimeLabel;
+            Timing::appendMsecs(m_buffer, recordLapTime);
+            setText(text);
+        }
 
-        std::wstringstream ss;
-        ss << QObject::tr("R:").toStdWString() << m_timing->msecsToString(recordLapTime);
-        m_text.setText(ss.str());
-        m_text.render(
-            width() - m_text.width(m_font),
-            height() - m_text.height(m_font) * RECORD_LAP_TIME_POS,
+        text.render(
+            width() - text.width(m_font),
+            height() - text.height(m_font) * RECORD_LAP_TIME_POS,
             nullptr,
             m_font);
     }
@@ -340,15 +457,18 @@ void TimingOverlay::renderRaceTime()
     {
         const int raceTime = m_timing->raceTime(m_car->index());
 
-        m_text.setGlyphSize(GLYPH_W_TIMES, GLYPH_H_TIMES);
-        m_text.setColor(WHITE);
+        auto && text = m_raceTimeText.text;
+        if (m_raceTimeText.changed(timeKey(raceTime)))
+        {
+            m_buffer.clear();
+            m_buffer += m_raceTimeLabel;
+            Timing::appendMsecs(m_buffer, raceTime);
+            setText(text);
+        }
 
-        std::wstringstream ss;
-        ss << QObject::tr("TOT:").toStdWString() << m_timing->msecsToString(raceTime);
-        m_text.setText(ss.str());
-        m_text.render(
-            width() - m_text.width(m_font),
-            height() - m_text.height(m_font) * RACE_TIME_POS,
+        text.render(
+            width() - text.width(m_font),
+            height() - text.height(m_font) * RACE_TIME_POS,
             nullptr,
             m_font);
     }
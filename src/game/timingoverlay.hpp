@@ -54,6 +54,10 @@ public:
     //! Set current race.
     void setRace(Race & race);
 
+    //! \return number of heap allocations of the texts during the last render().
+    //! This is zero in steady state as the texts are re-formatted only when their values change.
+    int allocationCount() const;
+
 public slots:
 
     //! Blink car status view if followed car matches the argument.
@@ -73,6 +77,34 @@ private slots:
 
 private:
 
+    //! Text that is formatted only when the value it shows changes.
+    struct CachedText
+    {
+        CachedText()
+        : text(L"")
+        , value(-1)
+        , valid(false)
+        {}
+
+        //! \return true if the text needs to be re-formatted for the given value.
+        bool changed(int newValue)
+        {
+            const bool result = !valid || value != newValue;
+            value = newValue;
+            valid = true;
+            return result;
+        }
+
+        MCTextureText text;
+        int           value;
+        bool          valid;
+    };
+
+    void invalidateTexts();
+
+    //! Set the formatted m_buffer to the text and count the allocations.
+    void setText(MCTextureText & text);
+
     void renderCarStatusView();
 
     void renderCurrentLap();
@@ -91,14 +123,32 @@ private:
 
     MCTextureFontManager    & m_fontManager;
     MCTextureFont           & m_font;
-    MCTextureText             m_text;
     const Car               * m_car;
     Timing                  * m_timing;
     Race                    * m_race;
     std::vector<std::wstring> m_posTexts;
+    const std::wstring        m_currentLapLabel;
+    const std::wstring        m_posLabel;
+    const std::wstring        m_lapLabel;
+    const std::wstring        m_lapsLabel;
+    const std::wstring        m_lapTimeLabel;
+    const std::wstring        m_lastLapTimeLabel;
+    const std::wstring        m_recordLapTimeLabel;
+    const std::wstring        m_raceTimeLabel;
+    std::wstring              m_buffer;
+    CachedText                m_currentLapText;
+    CachedText                m_positionText;
+    CachedText                m_speedText;
+    MCTextureText             m_speedUnitText;
+    CachedText                m_currentLapTimeText;
+    CachedText                m_lastLapTimeText;
+    CachedText                m_recordLapTimeText;
+    CachedText                m_raceTimeText;
     bool                      m_showLapRecordTime;
     bool                      m_showRaceTime;
     bool                      m_showCarStatus;
+    size_t                    m_bufferCapacity;
+    int                       m_allocationCount;
     CarStatusView             m_carStatusView;
 };
 
@@ -59,7 +59,7 @@ TrackData & Track::trackData() const
     return *m_trackData;
 }
 
-TrackTilePtr Track::trackTileAtLocation(unsigned int x, unsigned int y) const
+TrackTile & Track::trackTileAtLocation(unsigned int x, unsigned int y) const
 {
     // X index
     unsigned int i = x * m_cols / m_width;
@@ -69,7 +69,7 @@ TrackTilePtr Track::trackTileAtLocation(unsigned int x, unsigned int y) const
     unsigned int j = y * m_rows / m_height;
     j = j >= m_rows ? m_rows - 1 : j;
 
-    return static_pointer_cast<TrackTile>(m_trackData->map().getTile(i, j));
+    return static_cast<TrackTile &>(*m_trackData->map().getTile(i, j));
 }
 
 TrackTilePtr Track::finishLine() const
@@ -52,8 +52,8 @@ public:
     //! Return the track data.
     TrackData & trackData() const;
 
-    //! Return pointer to the tile at the given location.
-    TrackTilePtr trackTileAtLocation(unsigned int x, unsigned int y) const;
+    //! Return the tile at the given location. Locations outside the track are clamped.
+    TrackTile & trackTileAtLocation(unsigned int x, unsigned int y) const;
 
     //! Return pointer to the finish line tile.
     TrackTilePtr finishLine() const;
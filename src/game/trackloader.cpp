@@ -124,7 +124,7 @@ void TrackLoader::updateLockedTracks(int lapCount, DifficultyProfile::Difficulty
     for (Track * track : m_tracks)
     {
         if (!track->trackData().isUserTrack() &&
-            !Settings::instance().loadTrackUnlockStatus(*track, lapCount, difficulty))
+            !Settings::instance().loadTrackUnlockStatus(track->trackData(), lapCount, difficulty))
         {
             track->trackData().setIsLocked(true);
         }
@@ -133,13 +133,13 @@ void TrackLoader::updateLockedTracks(int lapCount, DifficultyProfile::Difficulty
             track->trackData().setIsLocked(false);
 
             // This is needed in the case new tracks are added to the game afterwards.
-            const int bestPos = Settings::instance().loadBestPos(*track, lapCount, difficulty);
+            const int bestPos = Settings::instance().loadBestPos(track->trackData(), lapCount, difficulty);
             if (bestPos >= 1 && bestPos <= UNLOCK_LIMIT)
             {
                 if (track->next())
                 {
                     track->next()->trackData().setIsLocked(false);
-                    Settings::instance().saveTrackUnlockStatus(*track->next(), lapCount, difficulty);
+                    Settings::instance().saveTrackUnlockStatus(track->next()->trackData(), lapCount, difficulty);
                 }
             }
         }
@@ -293,29 +293,13 @@ void TrackLoader::readTile(
 
 TrackTile::TileType TrackLoader::tileTypeEnumFromString(std::string str)
 {
-    static std::map<string, TrackTile::TileType> mappings = {
-        {"bridge", TrackTile::TT_BRIDGE},
-        {"corner90", TrackTile::TT_CORNER_90},
-        {"corner45Left", TrackTile::TT_CORNER_45_LEFT},
-        {"corner45Right", TrackTile::TT_CORNER_45_RIGHT},
-        {"straight", TrackTile::TT_STRAIGHT},
-        {"straight45Male", TrackTile::TT_STRAIGHT_45_MALE},
-        {"straight45Female", TrackTile::TT_STRAIGHT_45_FEMALE},
-        {"grass", TrackTile::TT_GRASS},
-        {"sand", TrackTile::TT_SAND},
-        {"sandGrassStraight", TrackTile::TT_SAND_GRASS_STRAIGHT},
-        {"sandGrassCorner", TrackTile::TT_SAND_GRASS_CORNER},
-        {"sandGrassCorner2", TrackTile::TT_SAND_GRASS_CORNER_2},
-        {"finish", TrackTile::TT_FINISH},
-        {"clear", TrackTile::TT_NONE}
-    };
-
-    if (!mappings.count(str)) {
+    bool ok = false;
+    const auto type = TrackTile::tileTypeEnumFromString(str.c_str(), &ok);
+    if (!ok) {
         MCLogger().error() << "No mapping for tile '" << str << "'..";
-        return TrackTile::TT_NONE;
     }
 
-    return mappings[str];
+    return type;
 }
 
 void TrackLoader::readObject(QDomElement & element, TrackData & newData)
@@ -198,6 +198,10 @@ TrackObject * TrackObjectFactory::build(
         data.setRestitution(0.9);
         data.setInitialLocation(MCVector3dF(location.i(), location.j(), 8));
 
+        // Rounded ends keep cars from snagging on the joints between walls.
+        auto && surface = MCAssetManager::surfaceManager().surface(role.toStdString());
+        data.setShapeCapsule(surface.width(), surface.height() / 2);
+
         object = m_objectFactory.build(data);
         object->shape()->view()->setShaderProgram(Renderer::instance().program("defaultSpecular"));
     }
@@ -68,22 +68,7 @@ void TrackTile::setTileTypeEnum(TrackTile::TileType type)
 {
     m_typeEnum = type;
 
-    switch (type)
-    {
-    case TT_BRIDGE:
-    case TT_CORNER_90:
-    case TT_CORNER_45_LEFT:
-    case TT_CORNER_45_RIGHT:
-    case TT_STRAIGHT:
-    case TT_STRAIGHT_45_MALE:
-    case TT_STRAIGHT_45_FEMALE:
-    case TT_FINISH:
-        m_hasAsphalt = true;
-        break;
-    default:
-        m_hasAsphalt = false;
-        break;
-    }
+    m_hasAsphalt = isAsphalt(type);
 }
 
 bool TrackTile::hasAsphalt() const
@@ -24,25 +24,6 @@ class TrackTile : public TrackTileBase
 {
 public:
 
-    //! All possible types.
-    enum TileType
-    {
-        TT_NONE = 0,
-        TT_BRIDGE,
-        TT_CORNER_90,
-        TT_CORNER_45_LEFT,
-        TT_CORNER_45_RIGHT,
-        TT_STRAIGHT,
-        TT_STRAIGHT_45_MALE,
-        TT_STRAIGHT_45_FEMALE,
-        TT_GRASS,
-        TT_SAND,
-        TT_SAND_GRASS_STRAIGHT,
-        TT_SAND_GRASS_CORNER,
-        TT_SAND_GRASS_CORNER_2,
-        TT_FINISH
-    };
-
     /*! Constructor.
      *  \see TrackTileBase. */
     TrackTile(QPointF location, QPoint matrixLocation,